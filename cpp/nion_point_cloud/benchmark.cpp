@@ -0,0 +1,185 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Replays a recording of main.cpp (see recordingEnabled) through the direct processing backend as fast as
+// possible and reports the frame rate and the duration of every processing step. No camera is required.
+//
+// Usage: nion_point_cloud_benchmark <recording file> [repetitions]
+
+// Standard headers
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// IDS peak headers
+#include <peak/peak.hpp>
+#include <peak_icv/peak_icv.hpp>
+
+// Project headers
+#include "depth_conversion.hpp"
+#include "direct_processing.hpp"
+#include "latency_statistics.hpp"
+#include "point_cloud_encoding.hpp"
+#include "processing.hpp"
+#include "recording.hpp"
+
+namespace
+{
+// ---------------------------------------------------------------------------------------------------------------------
+// CONFIGURATION
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Number of times all frames of the recording are processed, if not given on the command line
+constexpr size_t defaultRepetitionCount = 10;
+
+// Processing settings, as in main.cpp. The valid depth interval and the scale factor are taken from the recording.
+constexpr bool filterDistanceEnabled = true;
+constexpr peak::common::IntervalF filterDistanceIntervalMm{ 100.0F, 1000.0F };
+constexpr bool organizedPointCloudEnabled = false;
+constexpr float voxelGridLeafSizeMm = 0.0F;
+constexpr size_t temporalFilterFrameCount = 0;
+constexpr size_t temporalFilterMinValidCount = 2;
+constexpr float temporalFilterMaxDeviationMm = 20.0F;
+
+// Encode every point cloud in memory, as it would be written to file. Files are not written, so the results do
+// not depend on the disk.
+constexpr bool pointCloudEncodingEnabled = true;
+constexpr nion::PointCloudFormat pointCloudFormat = nion::PointCloudFormat::BinaryPly;
+
+size_t ParseRepetitionCount(const std::string& text)
+{
+    const auto count = std::stoul(text);
+    if (count == 0)
+    {
+        throw std::invalid_argument("The number of repetitions must be positive.");
+    }
+
+    return count;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------
+// MAIN
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <recording file> [repetitions]" << std::endl;
+        return 1;
+    }
+
+    int result = 0;
+
+    try
+    {
+        peak::icv::library::Init();
+
+        nion::RecordingReader reader(argv[1]);
+        const auto& info = reader.Info();
+
+        // Read all frames first, so the benchmark does not wait for the disk
+        const auto frames = reader.ReadAllFrames();
+        if (frames.empty())
+        {
+            throw std::runtime_error("The recording contains no frames.");
+        }
+
+        const auto repetitionCount = argc == 3 ? ParseRepetitionCount(argv[2]) : defaultRepetitionCount;
+
+        const peak::icv::CalibrationParameters calibration(info.calibrationData);
+
+        nion::ProcessingParameters parameters;
+        parameters.backend = nion::ProcessingBackend::Direct;
+        parameters.scaleFactor = info.scaleFactor;
+        parameters.validDepthInterval = { info.validDepthMin, info.validDepthMax };
+        parameters.filterDistanceEnabled = filterDistanceEnabled;
+        parameters.filterDistanceIntervalMm = filterDistanceIntervalMm;
+        parameters.geometry = info.geometry;
+        parameters.metadata = nion::CreateImageMetadata(info.geometry);
+        parameters.organizedPointCloud = organizedPointCloudEnabled;
+        parameters.voxelLeafSizeMm = voxelGridLeafSizeMm;
+        parameters.temporalFilter.frameCount = temporalFilterFrameCount;
+        parameters.temporalFilter.minValidCount = temporalFilterMinValidCount;
+        parameters.temporalFilter.maxDeviationMm = temporalFilterMaxDeviationMm;
+
+        nion::PointCloudFormatSettings pointCloudFormatSettings;
+        pointCloudFormatSettings.format = pointCloudFormat;
+
+        const nion::DirectProcessor processor(calibration, parameters);
+        nion::FrameWorkspace workspace(info.geometry.width, info.geometry.height);
+        std::vector<uint8_t> encodedPointCloud;
+
+        auto& latencyStatistics = nion::LatencyStatistics::Instance();
+
+        auto processFrame = [&](const nion::RecordedFrame& frame) {
+            const auto start = std::chrono::steady_clock::now();
+
+            processor.ProcessDepthMap(frame.depthMap.View(), workspace);
+            processor.UndistortIntensity(frame.intensity.View(), workspace);
+            processor.CreatePointCloud(workspace);
+            latencyStatistics.RecordSince(nion::LatencyStage::ReceiveToPointCloud, start);
+
+            if (pointCloudEncodingEnabled)
+            {
+                const nion::ScopedLatency latency(nion::LatencyStage::PointCloudEncoding);
+                nion::EncodePointCloud(workspace.pointCloud, pointCloudFormatSettings, encodedPointCloud);
+            }
+        };
+
+        std::cout << "Replaying " << frames.size() << " frames of " << info.geometry.width << " x "
+                  << info.geometry.height << " pixels " << repetitionCount << " times." << std::endl;
+        std::cout << "Depth conversion uses " << nion::DepthConversionInstructionSet() << " instructions."
+                  << std::endl;
+
+        // Warm up caches and let the memory of the workspace and the encoded point cloud be allocated
+        for (const auto& frame : frames)
+        {
+            processFrame(frame);
+        }
+
+        latencyStatistics.SetEnabled(true);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t repetition = 0; repetition < repetitionCount; ++repetition)
+        {
+            for (const auto& frame : frames)
+            {
+                processFrame(frame);
+            }
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const auto frameCount = frames.size() * repetitionCount;
+        std::cout << frameCount << " frames processed in " << elapsed << " s: "
+                  << static_cast<double>(frameCount) / elapsed << " frames/s" << std::endl;
+
+        latencyStatistics.Print(std::cout);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        result = 1;
+    }
+
+    peak::icv::library::Exit();
+
+    return result;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace nion
+{
+
+// Thread-safe FIFO with a fixed capacity, used to connect the pipeline stages.
+// A closed queue rejects new elements, but the remaining elements can still be popped.
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t capacity)
+        : m_capacity(capacity)
+    {}
+
+    // Add an element, waiting while the queue is full. Returns false if the queue was closed.
+    bool Push(T value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] {
+            return m_closed || m_elements.size() < m_capacity;
+        });
+
+        if (m_closed)
+        {
+            return false;
+        }
+
+        m_elements.push_back(std::move(value));
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Add an element only if there is space left. Never waits.
+    bool TryPush(T value)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_closed || m_elements.size() >= m_capacity)
+        {
+            return false;
+        }
+
+        m_elements.push_back(std::move(value));
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Add an element, moving the oldest element to removed first if the queue is full. Never waits.
+    // Returns false if the queue was closed.
+    bool PushDropOldest(T value, std::vector<T>& removed)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_closed)
+        {
+            return false;
+        }
+
+        while (!m_elements.empty() && m_elements.size() >= m_capacity)
+        {
+            removed.push_back(std::move(m_elements.front()));
+            m_elements.pop_front();
+        }
+
+        m_elements.push_back(std::move(value));
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Remove the oldest element, waiting while the queue is empty.
+    // Returns false once the queue is closed and no elements are left.
+    bool Pop(T& value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] {
+            return m_closed || !m_elements.empty();
+        });
+
+        if (m_elements.empty())
+        {
+            return false;
+        }
+
+        value = std::move(m_elements.front());
+        m_elements.pop_front();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    // Remove the oldest element only if there is one. Never waits.
+    bool TryPop(T& value)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_elements.empty())
+        {
+            return false;
+        }
+
+        value = std::move(m_elements.front());
+        m_elements.pop_front();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    void Close()
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+    size_t Size() const
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        return m_elements.size();
+    }
+
+    size_t Capacity() const
+    {
+        return m_capacity;
+    }
+
+private:
+    const size_t m_capacity;
+    std::deque<T> m_elements;
+    bool m_closed{ false };
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+};
+
+} // namespace nion
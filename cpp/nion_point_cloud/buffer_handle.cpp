@@ -0,0 +1,143 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "buffer_handle.hpp"
+
+// Standard headers
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace nion
+{
+
+BufferHandle::BufferHandle(Slot* slot)
+    : m_slot(slot)
+{}
+
+BufferHandle::~BufferHandle()
+{
+    Reset();
+}
+
+BufferHandle::BufferHandle(const BufferHandle& other)
+    : m_slot(other.m_slot)
+{
+    if (m_slot)
+    {
+        m_slot->numHandles.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+BufferHandle& BufferHandle::operator=(const BufferHandle& other)
+{
+    if (this != &other)
+    {
+        BufferHandle copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+BufferHandle::BufferHandle(BufferHandle&& other) noexcept
+    : m_slot(other.m_slot)
+{
+    other.m_slot = nullptr;
+}
+
+BufferHandle& BufferHandle::operator=(BufferHandle&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        m_slot = other.m_slot;
+        other.m_slot = nullptr;
+    }
+    return *this;
+}
+
+void BufferHandle::Reset()
+{
+    if (!m_slot)
+    {
+        return;
+    }
+
+    // The last handle has to see all accesses to the buffer data by the other handles
+    if (m_slot->numHandles.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        m_slot->pool->Release(m_slot);
+    }
+    m_slot = nullptr;
+}
+
+const std::shared_ptr<peak::core::Buffer>& BufferHandle::Buffer() const
+{
+    if (!m_slot)
+    {
+        throw std::logic_error("The buffer handle is empty.");
+    }
+
+    return m_slot->buffer;
+}
+
+BufferHandle::operator bool() const
+{
+    return m_slot != nullptr;
+}
+
+BufferHandlePool::BufferHandlePool(std::shared_ptr<peak::core::DataStream> stream, size_t numBuffers)
+    : m_stream(std::move(stream))
+    , m_freeSlots(numBuffers)
+{
+    for (size_t i = 0; i < numBuffers; ++i)
+    {
+        m_slots.push_back(std::make_unique<BufferHandle::Slot>());
+        m_slots.back()->pool = this;
+        m_freeSlots.TryPush(m_slots.back().get());
+    }
+}
+
+BufferHandle BufferHandlePool::Acquire(std::shared_ptr<peak::core::Buffer> buffer)
+{
+    BufferHandle::Slot* slot = nullptr;
+    if (!m_freeSlots.TryPop(slot))
+    {
+        // The buffer would not be queued again otherwise
+        m_stream->QueueBuffer(buffer);
+        throw std::logic_error("More buffers are held than announced.");
+    }
+
+    slot->buffer = std::move(buffer);
+    slot->numHandles.store(1, std::memory_order_relaxed);
+    return BufferHandle(slot);
+}
+
+void BufferHandlePool::Release(BufferHandle::Slot* slot)
+{
+    try
+    {
+        m_stream->QueueBuffer(slot->buffer);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: Failed to queue buffer: " << e.what() << std::endl;
+    }
+
+    slot->buffer.reset();
+    m_freeSlots.TryPush(slot);
+}
+
+} // namespace nion
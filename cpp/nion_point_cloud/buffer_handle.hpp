@@ -0,0 +1,98 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// IDS peak headers
+#include <peak/peak.hpp>
+
+// Project headers
+#include "lock_free_queue.hpp"
+
+namespace nion
+{
+
+class BufferHandlePool;
+
+// Shared ownership of a finished buffer. Copies of a handle share the buffer, and the last copy that is reset or
+// destroyed queues the buffer back to its data stream. Every stage that reads the raw buffer data holds a copy, so
+// the buffer is returned as soon as the last of them is done, no matter in which order they finish. Copies can be
+// used, reset and destroyed on any thread.
+class BufferHandle
+{
+public:
+    BufferHandle() = default;
+    ~BufferHandle();
+
+    BufferHandle(const BufferHandle& other);
+    BufferHandle& operator=(const BufferHandle& other);
+    BufferHandle(BufferHandle&& other) noexcept;
+    BufferHandle& operator=(BufferHandle&& other) noexcept;
+
+    // Give up this copy. Queues the buffer if it was the last one.
+    void Reset();
+
+    const std::shared_ptr<peak::core::Buffer>& Buffer() const;
+
+    explicit operator bool() const;
+
+private:
+    friend class BufferHandlePool;
+
+    struct Slot
+    {
+        BufferHandlePool* pool{};
+        std::shared_ptr<peak::core::Buffer> buffer{};
+        std::atomic<size_t> numHandles{ 0 };
+    };
+
+    explicit BufferHandle(Slot* slot);
+
+    Slot* m_slot{};
+};
+
+// Preallocated shared state of the buffer handles of one data stream, so creating and copying a handle does not
+// allocate. There is one slot per announced buffer, and the free slots are kept in a LockFreeQueue.
+class BufferHandlePool
+{
+public:
+    BufferHandlePool(std::shared_ptr<peak::core::DataStream> stream, size_t numBuffers);
+
+    BufferHandlePool(const BufferHandlePool&) = delete;
+    BufferHandlePool& operator=(const BufferHandlePool&) = delete;
+    BufferHandlePool(BufferHandlePool&&) = delete;
+    BufferHandlePool& operator=(BufferHandlePool&&) = delete;
+
+    // Take ownership of a finished buffer. Throws if more buffers are held than the pool was created for.
+    BufferHandle Acquire(std::shared_ptr<peak::core::Buffer> buffer);
+
+private:
+    friend class BufferHandle;
+
+    // Queue the buffer of a slot whose last handle was released and free the slot
+    void Release(BufferHandle::Slot* slot);
+
+    std::shared_ptr<peak::core::DataStream> m_stream;
+    std::vector<std::unique_ptr<BufferHandle::Slot>> m_slots;
+    LockFreeQueue<BufferHandle::Slot*> m_freeSlots;
+};
+
+} // namespace nion
@@ -0,0 +1,90 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "buffer_statistics.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace nion
+{
+
+BufferMonitor::BufferMonitor(std::shared_ptr<peak::core::DataStream> stream, size_t payloadSize)
+    : m_stream(std::move(stream))
+{
+    m_statistics.numBuffersAnnounced = m_stream->NumBuffersAnnounced();
+    m_statistics.bufferMemoryBytes = m_statistics.numBuffersAnnounced * payloadSize;
+}
+
+void BufferMonitor::OnBufferReceived(const peak::core::Buffer& buffer)
+{
+    const auto frameId = buffer.FrameID();
+
+    if (m_statistics.numFramesReceived > 0 && frameId > m_lastFrameId + 1)
+    {
+        m_statistics.numLostFrames += frameId - m_lastFrameId - 1;
+    }
+
+    m_lastFrameId = frameId;
+    ++m_statistics.numFramesReceived;
+
+    if (buffer.IsIncomplete())
+    {
+        ++m_statistics.numIncompleteFrames;
+    }
+
+    // Buffers that are neither waiting to be filled nor waiting to be delivered are held by the
+    // application. This includes the buffer that was just received.
+    const auto numBuffersAvailable = m_stream->NumBuffersQueued() + m_stream->NumBuffersAwaitDelivery();
+    m_statistics.numBuffersInUse = m_statistics.numBuffersAnnounced > numBuffersAvailable
+        ? m_statistics.numBuffersAnnounced - numBuffersAvailable
+        : 0;
+    m_statistics.maxBuffersInUse = std::max(m_statistics.maxBuffersInUse, m_statistics.numBuffersInUse);
+
+    m_statistics.numUnderruns = m_stream->NumUnderruns();
+}
+
+void BufferMonitor::OnStaleBuffer()
+{
+    ++m_statistics.numStaleFrames;
+}
+
+void BufferMonitor::OnWaitTimeout()
+{
+    ++m_statistics.numWaitTimeouts;
+}
+
+BufferStatistics BufferMonitor::Statistics() const
+{
+    return m_statistics;
+}
+
+void PrintBufferStatistics(const BufferStatistics& statistics)
+{
+    std::cout << "Buffer statistics:" << std::endl;
+    std::cout << "  Buffers announced:      " << statistics.numBuffersAnnounced << " ("
+              << statistics.bufferMemoryBytes / (1024 * 1024) << " MiB)" << std::endl;
+    std::cout << "  Frames received:        " << statistics.numFramesReceived << std::endl;
+    std::cout << "  Incomplete frames:      " << statistics.numIncompleteFrames << std::endl;
+    std::cout << "  Lost frames:            " << statistics.numLostFrames << std::endl;
+    std::cout << "  Queue underruns:        " << statistics.numUnderruns << std::endl;
+    std::cout << "  Stale frames skipped:   " << statistics.numStaleFrames << std::endl;
+    std::cout << "  Wait timeouts:          " << statistics.numWaitTimeouts << std::endl;
+    std::cout << "  Max. buffers in use:    " << statistics.maxBuffersInUse << std::endl;
+}
+
+} // namespace nion
@@ -0,0 +1,82 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// IDS peak headers
+#include <peak/peak.hpp>
+
+namespace nion
+{
+
+struct BufferStatistics
+{
+    // Number of buffers announced to the data stream and the memory they occupy
+    size_t numBuffersAnnounced{};
+    size_t bufferMemoryBytes{};
+
+    // Number of frames received from the data stream
+    uint64_t numFramesReceived{};
+    uint64_t numIncompleteFrames{};
+
+    // Number of times the data stream had no empty buffer to fill (queue underrun)
+    uint64_t numUnderruns{};
+
+    // Number of frames never received, detected by gaps in the frame IDs
+    uint64_t numLostFrames{};
+
+    // Number of frames queued again without processing, as a newer frame was already waiting (latest frame wins)
+    uint64_t numStaleFrames{};
+
+    // Number of times no frame was received within the wait timeout
+    uint64_t numWaitTimeouts{};
+
+    // Number of buffers still held by the application (e.g. by the processing pipeline)
+    // when a new buffer was received
+    size_t numBuffersInUse{};
+    size_t maxBuffersInUse{};
+};
+
+// Collects statistics about the buffer usage of a data stream. Call OnBufferReceived()
+// for every buffer returned by WaitForFinishedBuffer(). This allows to size the
+// buffer pool against the drop rate of a deployment.
+class BufferMonitor
+{
+public:
+    BufferMonitor(std::shared_ptr<peak::core::DataStream> stream, size_t payloadSize);
+
+    void OnBufferReceived(const peak::core::Buffer& buffer);
+
+    // The last received buffer is queued again without processing, as a newer one is already waiting
+    void OnStaleBuffer();
+
+    void OnWaitTimeout();
+
+    BufferStatistics Statistics() const;
+
+private:
+    std::shared_ptr<peak::core::DataStream> m_stream;
+    BufferStatistics m_statistics{};
+    uint64_t m_lastFrameId{};
+};
+
+void PrintBufferStatistics(const BufferStatistics& statistics);
+
+} // namespace nion
@@ -0,0 +1,157 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "calibration_cache.hpp"
+
+// Standard headers
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace nion
+{
+namespace
+{
+
+constexpr char cacheMagic[8] = { 'N', 'I', 'O', 'N', 'C', 'A', 'L', '\0' };
+constexpr uint32_t cacheVersion = 1;
+
+static_assert(sizeof(CalibrationCacheHeader) == 32, "CalibrationCacheHeader must not contain padding.");
+
+// Serial numbers are used in file names, so only keep characters that are valid on all platforms
+std::string SanitizeFileName(const std::string& name)
+{
+    std::string result = name;
+    for (auto& c : result)
+    {
+        const auto isAlphanumeric = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+        if (!isAlphanumeric && c != '-' && c != '_')
+        {
+            c = '_';
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+uint64_t HashCalibrationData(const std::vector<uint8_t>& data)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto byte : data)
+    {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+std::string CalibrationCacheFilePath(const std::string& cacheDirectory, const std::string& serialNumber)
+{
+    return cacheDirectory + "nion_calibration_" + SanitizeFileName(serialNumber) + ".bin";
+}
+
+bool LoadCachedCalibrationData(const std::string& filePath, uint64_t expectedSize, std::vector<uint8_t>& data)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    CalibrationCacheHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, cacheMagic, sizeof(header.magic)) != 0 || header.version != cacheVersion
+        || header.size != expectedSize)
+    {
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(header.size));
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+    {
+        return false;
+    }
+
+    return HashCalibrationData(data) == header.hash;
+}
+
+void StoreCachedCalibrationData(const std::string& filePath, const std::vector<uint8_t>& data)
+{
+    CalibrationCacheHeader header{};
+    std::memcpy(header.magic, cacheMagic, sizeof(header.magic));
+    header.version = cacheVersion;
+    header.size = data.size();
+    header.hash = HashCalibrationData(data);
+
+    const auto temporaryFilePath = filePath + ".tmp";
+    {
+        std::ofstream file(temporaryFilePath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write file: " + temporaryFilePath);
+        }
+    }
+
+    // std::rename does not replace existing files on all platforms
+    std::remove(filePath.c_str());
+    if (std::rename(temporaryFilePath.c_str(), filePath.c_str()) != 0)
+    {
+        throw std::runtime_error("Failed to write file: " + filePath);
+    }
+}
+
+CachedCalibrationData ReadCalibrationDataCached(const std::shared_ptr<peak::core::NodeMap>& nodeMap,
+    const std::string& serialNumber, const std::string& cacheDirectory)
+{
+    const peak::core::file::FileAdapter adapter(nodeMap, "LensCalibrationData");
+
+    const auto size = adapter.Size();
+    if (size <= 0)
+    {
+        throw std::runtime_error("No factory calibration data available.");
+    }
+
+    const auto cacheFilePath = CalibrationCacheFilePath(cacheDirectory, serialNumber);
+
+    CachedCalibrationData calibration;
+    calibration.isFromCache = LoadCachedCalibrationData(cacheFilePath, static_cast<uint64_t>(size), calibration.data);
+    if (calibration.isFromCache)
+    {
+        return calibration;
+    }
+
+    calibration.data = adapter.Read(size);
+
+    try
+    {
+        StoreCachedCalibrationData(cacheFilePath, calibration.data);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Warning: calibration data not cached. " << e.what() << std::endl;
+    }
+
+    return calibration;
+}
+
+} // namespace nion
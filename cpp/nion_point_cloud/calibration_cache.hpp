@@ -0,0 +1,70 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// IDS peak headers
+#include <peak/peak.hpp>
+
+namespace nion
+{
+
+// Layout of a calibration cache file, all values little-endian:
+//
+//   CalibrationCacheHeader
+//   calibration data (size bytes)
+struct CalibrationCacheHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t size;
+    // FNV-1a hash of the calibration data
+    uint64_t hash;
+};
+
+// 64 bit FNV-1a hash, used to detect damaged cache files
+uint64_t HashCalibrationData(const std::vector<uint8_t>& data);
+
+// Path of the cache file of the device with the given serial number
+std::string CalibrationCacheFilePath(const std::string& cacheDirectory, const std::string& serialNumber);
+
+// Load the cached calibration data. Returns false if there is no valid cache file or if its data
+// does not have the expected size, e.g. because the device was recalibrated.
+bool LoadCachedCalibrationData(const std::string& filePath, uint64_t expectedSize, std::vector<uint8_t>& data);
+
+// Write the calibration data into the cache file. The file is replaced at once, so a cache file
+// is never read while partially written.
+void StoreCachedCalibrationData(const std::string& filePath, const std::vector<uint8_t>& data);
+
+struct CachedCalibrationData
+{
+    std::vector<uint8_t> data{};
+    bool isFromCache{};
+};
+
+// Read the LensCalibrationData file of the device, or the local copy of an earlier start if it has the same size.
+// Transferring the file takes much longer than reading its size, so a warm start only reads the size. A recalibration
+// that keeps the size is not detected, because the device provides no checksum or version of the calibration.
+// The cache is optional: if it cannot be written, a warning is printed.
+CachedCalibrationData ReadCalibrationDataCached(const std::shared_ptr<peak::core::NodeMap>& nodeMap,
+    const std::string& serialNumber, const std::string& cacheDirectory);
+
+} // namespace nion
@@ -0,0 +1,239 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "depth_conversion.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    define NION_DEPTH_CONVERSION_X86
+#    include <immintrin.h>
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#    endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    define NION_DEPTH_CONVERSION_NEON
+#    include <arm_neon.h>
+#endif
+
+// GCC and Clang only generate AVX code for functions that enable it explicitly,
+// so the rest of the example still runs on any x86 CPU.
+#if defined(NION_DEPTH_CONVERSION_X86) && defined(__GNUC__)
+#    define NION_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#else
+#    define NION_TARGET(instructionSet)
+#endif
+
+namespace nion
+{
+namespace
+{
+
+using Implementation = DepthConversionImplementation;
+
+void ConvertDepthScalar(const uint16_t* rawDepth, size_t numPixels, float scaleFactor, float minimum, float maximum,
+    float* depth, uint8_t* valid)
+{
+    for (size_t i = 0; i < numPixels; ++i)
+    {
+        const auto value = static_cast<float>(rawDepth[i]) * scaleFactor;
+        const auto isValid = value >= minimum && value <= maximum;
+
+        depth[i] = isValid ? value : 0.0F;
+        valid[i] = isValid ? 1 : 0;
+    }
+}
+
+#if defined(NION_DEPTH_CONVERSION_X86)
+
+#    ifdef _MSC_VER
+bool CpuSupports(int extendedFeatureBit, unsigned long long requiredStateMask)
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+
+    // The operating system has to save the extended registers on context switches
+    __cpuid(info, 1);
+    const auto hasOsxsave = (info[2] & (1 << 27)) != 0;
+    if (!hasOsxsave || (_xgetbv(0) & requiredStateMask) != requiredStateMask)
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << extendedFeatureBit)) != 0;
+}
+
+bool CpuSupportsAvx2()
+{
+    return CpuSupports(5, 0x6);
+}
+
+bool CpuSupportsAvx512()
+{
+    return CpuSupports(16, 0xE6);
+}
+#    else
+bool CpuSupportsAvx2()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+bool CpuSupportsAvx512()
+{
+    return __builtin_cpu_supports("avx512f");
+}
+#    endif
+
+NION_TARGET("avx2")
+void ConvertDepthAvx2(const uint16_t* rawDepth, size_t numPixels, float scaleFactor, float minimum, float maximum,
+    float* depth, uint8_t* valid)
+{
+    const auto scale = _mm256_set1_ps(scaleFactor);
+    const auto min = _mm256_set1_ps(minimum);
+    const auto max = _mm256_set1_ps(maximum);
+    const auto one = _mm_set1_epi8(1);
+
+    size_t i = 0;
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rawDepth + i));
+        const auto value = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(raw)), scale);
+        const auto mask = _mm256_and_ps(_mm256_cmp_ps(value, min, _CMP_GE_OQ), _mm256_cmp_ps(value, max, _CMP_LE_OQ));
+
+        _mm256_storeu_ps(depth + i, _mm256_and_ps(value, mask));
+
+        // Narrow the 32 bit lane masks to one byte per pixel
+        const auto mask32 = _mm256_castps_si256(mask);
+        const auto mask16 = _mm_packs_epi32(_mm256_castsi256_si128(mask32), _mm256_extracti128_si256(mask32, 1));
+        const auto mask8 = _mm_packs_epi16(mask16, mask16);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(valid + i), _mm_and_si128(mask8, one));
+    }
+
+    ConvertDepthScalar(rawDepth + i, numPixels - i, scaleFactor, minimum, maximum, depth + i, valid + i);
+}
+
+NION_TARGET("avx512f")
+void ConvertDepthAvx512(const uint16_t* rawDepth, size_t numPixels, float scaleFactor, float minimum, float maximum,
+    float* depth, uint8_t* valid)
+{
+    const auto scale = _mm512_set1_ps(scaleFactor);
+    const auto min = _mm512_set1_ps(minimum);
+    const auto max = _mm512_set1_ps(maximum);
+
+    size_t i = 0;
+    for (; i + 16 <= numPixels; i += 16)
+    {
+        const auto raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rawDepth + i));
+        const auto value = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(raw)), scale);
+        const auto mask = _mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(value, min, _CMP_GE_OQ), value, max, _CMP_LE_OQ);
+
+        _mm512_storeu_ps(depth + i, _mm512_maskz_mov_ps(mask, value));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(valid + i), _mm512_cvtepi32_epi8(_mm512_maskz_set1_epi32(mask, 1)));
+    }
+
+    ConvertDepthScalar(rawDepth + i, numPixels - i, scaleFactor, minimum, maximum, depth + i, valid + i);
+}
+
+std::vector<Implementation> SupportedImplementations()
+{
+    std::vector<Implementation> implementations{ { ConvertDepthScalar, "Scalar" } };
+    if (CpuSupportsAvx2())
+    {
+        implementations.push_back({ ConvertDepthAvx2, "AVX2" });
+    }
+
+    if (CpuSupportsAvx512())
+    {
+        implementations.push_back({ ConvertDepthAvx512, "AVX-512" });
+    }
+
+    return implementations;
+}
+
+#elif defined(NION_DEPTH_CONVERSION_NEON)
+
+void ConvertDepthNeon(const uint16_t* rawDepth, size_t numPixels, float scaleFactor, float minimum, float maximum,
+    float* depth, uint8_t* valid)
+{
+    const auto scale = vdupq_n_f32(scaleFactor);
+    const auto min = vdupq_n_f32(minimum);
+    const auto max = vdupq_n_f32(maximum);
+    const auto one = vdup_n_u8(1);
+
+    size_t i = 0;
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto raw = vld1q_u16(rawDepth + i);
+        const auto valueLow = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(raw))), scale);
+        const auto valueHigh = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(raw))), scale);
+        const auto maskLow = vandq_u32(vcgeq_f32(valueLow, min), vcleq_f32(valueLow, max));
+        const auto maskHigh = vandq_u32(vcgeq_f32(valueHigh, min), vcleq_f32(valueHigh, max));
+
+        vst1q_f32(depth + i, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(valueLow), maskLow)));
+        vst1q_f32(depth + i + 4, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(valueHigh), maskHigh)));
+
+        // Narrow the 32 bit lane masks to one byte per pixel
+        const auto mask8 = vmovn_u16(vcombine_u16(vmovn_u32(maskLow), vmovn_u32(maskHigh)));
+        vst1_u8(valid + i, vand_u8(mask8, one));
+    }
+
+    ConvertDepthScalar(rawDepth + i, numPixels - i, scaleFactor, minimum, maximum, depth + i, valid + i);
+}
+
+std::vector<Implementation> SupportedImplementations()
+{
+    // NEON is mandatory on 64 bit ARM and enabled explicitly by the compiler flags on 32 bit ARM
+    return { { ConvertDepthScalar, "Scalar" }, { ConvertDepthNeon, "NEON" } };
+}
+
+#else
+
+std::vector<Implementation> SupportedImplementations()
+{
+    return { { ConvertDepthScalar, "Scalar" } };
+}
+
+#endif
+
+// The fastest supported implementation, which is the last one
+const Implementation& GetImplementation()
+{
+    static const Implementation implementation = SupportedImplementations().back();
+    return implementation;
+}
+
+} // namespace
+
+void ConvertDepth(const uint16_t* rawDepth, size_t numPixels, float scaleFactor, float validMinimum,
+    float validMaximum, float* depth, uint8_t* valid)
+{
+    GetImplementation().convert(rawDepth, numPixels, scaleFactor, validMinimum, validMaximum, depth, valid);
+}
+
+const char* DepthConversionInstructionSet()
+{
+    return GetImplementation().name;
+}
+
+std::vector<DepthConversionImplementation> DepthConversionImplementations()
+{
+    return SupportedImplementations();
+}
+
+} // namespace nion
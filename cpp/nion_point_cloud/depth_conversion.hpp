@@ -0,0 +1,48 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nion
+{
+
+// Convert raw depth values to metric values by multiplying with the scale factor. Values outside
+// the valid interval [validMinimum, validMaximum] are set to 0 and marked with 0 in the validity
+// mask, all others with 1. The implementation is selected once at runtime: AVX-512 or AVX2 on x86
+// if the CPU supports it, NEON on ARM, and plain C++ otherwise. All implementations give identical
+// results, see tests/depth_conversion_test.cpp.
+void ConvertDepth(const uint16_t* rawDepth, size_t numPixels, float scaleFactor, float validMinimum,
+    float validMaximum, float* depth, uint8_t* valid);
+
+// Name of the implementation used by ConvertDepth(), e.g. "AVX2"
+const char* DepthConversionInstructionSet();
+
+// An implementation of ConvertDepth() for one instruction set
+struct DepthConversionImplementation
+{
+    void (*convert)(const uint16_t* rawDepth, size_t numPixels, float scaleFactor, float validMinimum,
+        float validMaximum, float* depth, uint8_t* valid);
+    const char* name;
+};
+
+// All implementations that the CPU supports, starting with the plain C++ one, e.g. to compare them
+std::vector<DepthConversionImplementation> DepthConversionImplementations();
+
+} // namespace nion
@@ -0,0 +1,177 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "device_configuration.hpp"
+
+// Standard headers
+#include <cmath>
+#include <stdexcept>
+
+namespace nion
+{
+namespace
+{
+
+void ExecuteUserSetCommand(NodeCache& nodes, const std::string& userSet, const std::string& command)
+{
+    nodes.Find<peak::core::nodes::EnumerationNode>("UserSetSelector")->SetCurrentEntry(userSet);
+
+    const auto cmd = nodes.Find<peak::core::nodes::CommandNode>(command);
+    cmd->Execute();
+    cmd->WaitUntilDone();
+}
+
+} // namespace
+
+DeviceConfiguration& DeviceConfiguration::SetInteger(const std::string& name, int64_t value)
+{
+    Value setting;
+    setting.name = name;
+    setting.type = ValueType::Integer;
+    setting.integer = value;
+    m_values.push_back(std::move(setting));
+
+    return *this;
+}
+
+DeviceConfiguration& DeviceConfiguration::SetFloat(const std::string& name, double value, double tolerance)
+{
+    Value setting;
+    setting.name = name;
+    setting.type = ValueType::Float;
+    setting.floatValue = value;
+    setting.tolerance = tolerance;
+    m_values.push_back(std::move(setting));
+
+    return *this;
+}
+
+DeviceConfiguration& DeviceConfiguration::SetEnumeration(const std::string& name, const std::string& entry)
+{
+    Value setting;
+    setting.name = name;
+    setting.type = ValueType::Enumeration;
+    setting.entry = entry;
+    m_values.push_back(std::move(setting));
+
+    return *this;
+}
+
+std::vector<std::string> DeviceConfiguration::FindDifferences(NodeCache& nodes) const
+{
+    std::vector<std::string> differences;
+    for (const auto& value : m_values)
+    {
+        if (!Matches(value, nodes))
+        {
+            differences.push_back(value.name);
+        }
+    }
+
+    return differences;
+}
+
+size_t DeviceConfiguration::Apply(NodeCache& nodes) const
+{
+    // The values are written in the order they were added, as a node may depend on an earlier one
+    size_t numWritten = 0;
+    for (const auto& value : m_values)
+    {
+        if (!Matches(value, nodes))
+        {
+            Write(value, nodes);
+            ++numWritten;
+        }
+    }
+
+    return numWritten;
+}
+
+size_t DeviceConfiguration::NumValues() const
+{
+    return m_values.size();
+}
+
+bool DeviceConfiguration::Matches(const Value& value, NodeCache& nodes)
+{
+    switch (value.type)
+    {
+    case ValueType::Integer:
+        return nodes.Find<peak::core::nodes::IntegerNode>(value.name)->Value() == value.integer;
+    case ValueType::Float:
+        return std::abs(nodes.Find<peak::core::nodes::FloatNode>(value.name)->Value() - value.floatValue)
+            <= value.tolerance;
+    case ValueType::Enumeration:
+        return nodes.Find<peak::core::nodes::EnumerationNode>(value.name)->CurrentEntry()->SymbolicValue()
+            == value.entry;
+    }
+
+    return false;
+}
+
+void DeviceConfiguration::Write(const Value& value, NodeCache& nodes)
+{
+    switch (value.type)
+    {
+    case ValueType::Integer:
+        nodes.Find<peak::core::nodes::IntegerNode>(value.name)->SetValue(value.integer);
+        return;
+    case ValueType::Float:
+        nodes.Find<peak::core::nodes::FloatNode>(value.name)->SetValue(value.floatValue);
+        return;
+    case ValueType::Enumeration:
+        nodes.Find<peak::core::nodes::EnumerationNode>(value.name)->SetCurrentEntry(value.entry);
+        return;
+    }
+}
+
+void LoadUserSet(NodeCache& nodes, const std::string& userSet)
+{
+    ExecuteUserSetCommand(nodes, userSet, "UserSetLoad");
+}
+
+void SaveUserSet(NodeCache& nodes, const std::string& userSet)
+{
+    ExecuteUserSetCommand(nodes, userSet, "UserSetSave");
+}
+
+size_t ConfigureDevice(NodeCache& nodes, const DeviceConfiguration& configuration, DeviceStartupMode mode,
+    const std::string& customUserSet)
+{
+    switch (mode)
+    {
+    case DeviceStartupMode::ResetToDefault:
+        LoadUserSet(nodes, "Default");
+        return configuration.Apply(nodes);
+    case DeviceStartupMode::ApplyDifferences:
+        return configuration.Apply(nodes);
+    case DeviceStartupMode::CustomUserSet:
+        LoadUserSet(nodes, customUserSet);
+        if (configuration.FindDifferences(nodes).empty())
+        {
+            return 0;
+        }
+
+        // Start from Default, so the custom user set does not keep other values of earlier sessions
+        LoadUserSet(nodes, "Default");
+        const auto numWritten = configuration.Apply(nodes);
+        SaveUserSet(nodes, customUserSet);
+        return numWritten;
+    }
+
+    throw std::invalid_argument("Unknown device startup mode.");
+}
+
+} // namespace nion
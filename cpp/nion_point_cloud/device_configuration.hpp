@@ -0,0 +1,98 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Project headers
+#include "node_cache.hpp"
+
+namespace nion
+{
+
+// How the device is brought into the desired configuration at startup
+enum class DeviceStartupMode
+{
+    // Load the Default user set and write the configuration
+    ResetToDefault,
+    // Keep the current state and only write the values that differ. Nodes that are not part of
+    // the configuration keep the values of earlier sessions.
+    ApplyDifferences,
+    // Load a custom user set that already holds the configuration. If it does not, e.g. on the first start,
+    // the Default user set is loaded, the configuration written and saved into the custom user set.
+    CustomUserSet
+};
+
+// Desired values of device nodes. Instead of writing every value, only the values that differ
+// from the current state of the device are written, which saves a round trip per node.
+class DeviceConfiguration
+{
+public:
+    DeviceConfiguration& SetInteger(const std::string& name, int64_t value);
+
+    // Float values are considered equal if they differ by at most the tolerance, as the device
+    // may round written values, e.g. to a multiple of the increment of the node
+    DeviceConfiguration& SetFloat(const std::string& name, double value, double tolerance);
+
+    DeviceConfiguration& SetEnumeration(const std::string& name, const std::string& entry);
+
+    // Names of the nodes whose current value differs from the configuration
+    std::vector<std::string> FindDifferences(NodeCache& nodes) const;
+
+    // Write the values that differ from the current state. Returns the number of written values.
+    size_t Apply(NodeCache& nodes) const;
+
+    size_t NumValues() const;
+
+private:
+    enum class ValueType
+    {
+        Integer,
+        Float,
+        Enumeration
+    };
+
+    struct Value
+    {
+        std::string name{};
+        ValueType type{};
+        int64_t integer{};
+        double floatValue{};
+        double tolerance{};
+        std::string entry{};
+    };
+
+    static bool Matches(const Value& value, NodeCache& nodes);
+    static void Write(const Value& value, NodeCache& nodes);
+
+    std::vector<Value> m_values;
+};
+
+// Load the user set with the given name, e.g. "Default" or "UserSet0"
+void LoadUserSet(NodeCache& nodes, const std::string& userSet);
+
+// Save the current device configuration into the user set with the given name
+void SaveUserSet(NodeCache& nodes, const std::string& userSet);
+
+// Bring the device into the given configuration. The custom user set is only used with
+// DeviceStartupMode::CustomUserSet. Returns the number of written values.
+size_t ConfigureDevice(NodeCache& nodes, const DeviceConfiguration& configuration, DeviceStartupMode mode,
+    const std::string& customUserSet);
+
+} // namespace nion
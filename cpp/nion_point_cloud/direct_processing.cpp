@@ -0,0 +1,348 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "direct_processing.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+template <typename T>
+void CheckImageSize(const PlaneView<const T>& image, const FrameWorkspace& workspace)
+{
+    if (image.width != workspace.rawDepth.Width() || image.height != workspace.rawDepth.Height())
+    {
+        throw std::runtime_error("Image size does not match the size of the workspace.");
+    }
+}
+
+// The indices of the undistortion map assume that rows are not padded
+template <typename T>
+void CheckContiguous(const PlaneView<const T>& image)
+{
+    if (image.stride != image.width)
+    {
+        throw std::runtime_error("Only contiguous images can be undistorted.");
+    }
+}
+
+PixelRegion GetWorkArea(const PixelRegion& workArea, size_t width, size_t height)
+{
+    if (workArea.IsEmpty())
+    {
+        return { 0, 0, width, height };
+    }
+    if (workArea.x + workArea.width > width || workArea.y + workArea.height > height)
+    {
+        throw std::invalid_argument("The work area exceeds the image.");
+    }
+
+    return workArea;
+}
+
+} // namespace
+
+FrameWorkspace::FrameWorkspace(size_t width, size_t height)
+    : rawDepth(width, height)
+    , depthValid(width, height)
+    , intensity(width, height)
+    , conversionValidRow(width)
+{
+    pointCloud.points.reserve(width * height);
+}
+
+WorkspacePool::WorkspacePool(size_t numWorkspaces, size_t width, size_t height)
+    : m_freeWorkspaces(numWorkspaces)
+{
+    for (size_t i = 0; i < numWorkspaces; ++i)
+    {
+        m_workspaces.push_back(std::make_unique<FrameWorkspace>(width, height));
+        m_freeWorkspaces.Push(m_workspaces.back().get());
+    }
+}
+
+FrameWorkspace* WorkspacePool::Acquire()
+{
+    FrameWorkspace* workspace = nullptr;
+    m_freeWorkspaces.Pop(workspace);
+    return workspace;
+}
+
+FrameWorkspace* WorkspacePool::TryAcquire()
+{
+    FrameWorkspace* workspace = nullptr;
+    m_freeWorkspaces.TryPop(workspace);
+    return workspace;
+}
+
+void WorkspacePool::Release(FrameWorkspace* workspace)
+{
+    m_freeWorkspaces.Push(workspace);
+}
+
+DirectProcessor::DirectProcessor(
+    const peak::icv::CalibrationParameters& calibration, const ProcessingParameters& parameters)
+    : m_parameters(parameters)
+    , m_lensModel(CreateLensModel(calibration, parameters.geometry))
+    , m_undistortionMap(GetUndistortionMap(m_lensModel, parameters.geometry.width, parameters.geometry.height))
+    , m_workArea(GetWorkArea(parameters.workArea, parameters.geometry.width, parameters.geometry.height))
+    , m_depthInterval(parameters.validDepthInterval)
+{
+    // Both intervals are applied to the metric depth value, so they can be combined into one
+    if (parameters.filterDistanceEnabled)
+    {
+        m_depthInterval.minimum = std::max(m_depthInterval.minimum, parameters.filterDistanceIntervalMm.minimum);
+        m_depthInterval.maximum = std::min(m_depthInterval.maximum, parameters.filterDistanceIntervalMm.maximum);
+    }
+
+    // Every possible raw value is converted once, so the validity of a pixel is a lookup and bit-identical to
+    // converting the pixel
+    std::vector<uint16_t> rawValues(std::numeric_limits<uint16_t>::max() + 1);
+    for (size_t i = 0; i < rawValues.size(); ++i)
+    {
+        rawValues[i] = static_cast<uint16_t>(i);
+    }
+
+    std::vector<float> metricValues(rawValues.size());
+    m_isRawDepthValid.resize(rawValues.size());
+    ConvertDepth(rawValues.data(), rawValues.size(), parameters.scaleFactor, m_depthInterval.minimum,
+        m_depthInterval.maximum, metricValues.data(), m_isRawDepthValid.data());
+
+    if (parameters.temporalFilter.frameCount > 1)
+    {
+        m_temporalFilter = std::make_unique<TemporalDepthFilter>(
+            parameters.geometry.width, parameters.geometry.height, parameters.temporalFilter);
+    }
+}
+
+void DirectProcessor::ProcessDepthMap(PlaneView<const uint16_t> rawDepth, FrameWorkspace& workspace) const
+{
+    ScopedLatency latency(LatencyStage::DepthProcessing);
+
+    CheckImageSize(rawDepth, workspace);
+    CheckContiguous(rawDepth);
+
+    // Pixels outside of the work area keep the 0 of the allocation
+    const auto& area = m_workArea;
+    const auto undistortedDepth = Crop(workspace.rawDepth.View(), area);
+    const auto valid = Crop(workspace.depthValid.View(), area);
+    const auto* isRawDepthValid = m_isRawDepthValid.data();
+    const auto* sourceIndex = m_undistortionMap->NearestSourceIndices().data() + area.y * rawDepth.width + area.x;
+
+    auto minX = undistortedDepth.width;
+    size_t maxX = 0;
+    auto minY = undistortedDepth.height;
+    size_t maxY = 0;
+
+    for (size_t y = 0; y < undistortedDepth.height; ++y, sourceIndex += rawDepth.width)
+    {
+        auto* depthRow = undistortedDepth.Row(y);
+        auto* validRow = valid.Row(y);
+
+        // Depth values are not interpolated, as interpolating across depth edges
+        // would create points that lie between foreground and background.
+        // Therefore, converting after the lookup gives the same result as
+        // converting the whole image first, and the conversion can be deferred.
+        // Pixels without a source pixel are invalid, even if 0 is a valid depth value.
+        size_t numValid = 0;
+        for (size_t x = 0; x < undistortedDepth.width; ++x)
+        {
+            const auto isInside = sourceIndex[x] != UndistortionMap::invalidIndex;
+            const auto value = isInside ? rawDepth.data[sourceIndex[x]] : uint16_t{ 0 };
+            const auto isValid = isInside && isRawDepthValid[value] != 0;
+
+            depthRow[x] = isValid ? value : uint16_t{ 0 };
+            validRow[x] = isValid ? 1 : 0;
+            numValid += isValid ? 1 : 0;
+        }
+
+        if (numValid > 0)
+        {
+            const auto* first = std::find(validRow, validRow + undistortedDepth.width, uint8_t{ 1 });
+            auto last = undistortedDepth.width;
+            while (validRow[last - 1] == 0)
+            {
+                --last;
+            }
+
+            minX = std::min(minX, static_cast<size_t>(first - validRow));
+            maxX = std::max(maxX, last);
+            minY = std::min(minY, y);
+            maxY = y + 1;
+        }
+    }
+
+    latency.Stop();
+
+    workspace.workArea = area;
+    workspace.validBounds = minX < maxX ? PixelRegion{ area.x + minX, area.y + minY, maxX - minX, maxY - minY }
+                                        : PixelRegion{ area.x, area.y, 0, 0 };
+
+    workspace.isDepthConverted = false;
+    if (m_temporalFilter)
+    {
+        // The average can make pixels valid that are invalid in this frame
+        ConvertDepthMap(workspace);
+        m_temporalFilter->Apply(workspace.depth.View(), workspace.depthValid.View());
+        workspace.validBounds = area;
+    }
+}
+
+void DirectProcessor::ConvertDepthMap(FrameWorkspace& workspace) const
+{
+    if (workspace.isDepthConverted)
+    {
+        return;
+    }
+
+    const ScopedLatency latency(LatencyStage::DepthConversion);
+
+    const auto rawDepth = AsConst(workspace.rawDepth.View());
+    if (workspace.depth.Width() != rawDepth.width || workspace.depth.Height() != rawDepth.height)
+    {
+        workspace.depth = Plane<float>(rawDepth.width, rawDepth.height);
+    }
+
+    // Invalid pixels are already 0, which is converted to 0, so no value is excluded
+    constexpr auto allValuesMinimum = std::numeric_limits<float>::lowest();
+    constexpr auto allValuesMaximum = std::numeric_limits<float>::max();
+
+    // Pixels outside of the work area are 0 in both images
+    const auto area = Crop(rawDepth, m_workArea);
+    const auto depth = Crop(workspace.depth.View(), m_workArea);
+    for (size_t y = 0; y < depth.height; ++y)
+    {
+        ConvertDepth(area.Row(y), depth.width, m_parameters.scaleFactor, allValuesMinimum, allValuesMaximum,
+            depth.Row(y), workspace.conversionValidRow.data());
+    }
+
+    workspace.isDepthConverted = true;
+}
+
+void DirectProcessor::UndistortIntensity(PlaneView<const uint16_t> rawIntensity, FrameWorkspace& workspace) const
+{
+    const ScopedLatency latency(LatencyStage::IntensityUndistortion);
+
+    CheckImageSize(rawIntensity, workspace);
+    CheckContiguous(rawIntensity);
+
+    const auto intensity = Crop(workspace.intensity.View(), m_workArea);
+    const auto sourceStride = rawIntensity.stride;
+    const auto* rowSamples = m_undistortionMap->BilinearSamples().data() + m_workArea.y * rawIntensity.width
+        + m_workArea.x;
+
+    for (size_t y = 0; y < intensity.height; ++y, rowSamples += rawIntensity.width)
+    {
+        auto* intensityRow = intensity.Row(y);
+        const auto* sample = rowSamples;
+
+        for (size_t x = 0; x < intensity.width; ++x, ++sample)
+        {
+            if (sample->index == UndistortionMap::invalidIndex)
+            {
+                intensityRow[x] = 0;
+                continue;
+            }
+
+            // Bilinear interpolation of the four neighboring pixels
+            const auto* top = rawIntensity.data + sample->index;
+            const auto* bottom = top + sourceStride;
+            const auto fx = sample->weightX;
+            const auto fy = sample->weightY;
+
+            const auto topValue = static_cast<float>(top[0]) * (1.0F - fx) + static_cast<float>(top[1]) * fx;
+            const auto bottomValue = static_cast<float>(bottom[0]) * (1.0F - fx) + static_cast<float>(bottom[1]) * fx;
+
+            intensityRow[x] = static_cast<uint16_t>(topValue * (1.0F - fy) + bottomValue * fy + 0.5F);
+        }
+    }
+}
+
+DepthMapView DirectProcessor::DepthMap(const FrameWorkspace& workspace) const
+{
+    return workspace.isDepthConverted ? DepthMapView(workspace.depth.View())
+                                      : DepthMapView(workspace.rawDepth.View(), m_parameters.scaleFactor);
+}
+
+void DirectProcessor::CreatePointCloud(FrameWorkspace& workspace) const
+{
+    const auto& images = workspace;
+    const auto depth = DepthMap(images);
+
+    // Unorganized point clouds of frames without valid pixels are empty, an empty region would select all pixels
+    const auto isOrganized = m_parameters.organizedPointCloud && m_parameters.voxelLeafSizeMm <= 0.0F;
+    if (images.validBounds.IsEmpty() && !isOrganized)
+    {
+        workspace.pointCloud.points.clear();
+        workspace.pointCloud.width = 0;
+        workspace.pointCloud.height = 1;
+        return;
+    }
+
+    if (m_parameters.voxelLeafSizeMm > 0.0F)
+    {
+        ScopedLatency latency(LatencyStage::PointCloudCreation);
+        nion::CreatePointCloud(depth, images.depthValid.View(), images.intensity.View(), m_lensModel,
+            workspace.densePointCloud, images.validBounds);
+        latency.Stop();
+
+        const ScopedLatency downsamplingLatency(LatencyStage::VoxelGridDownsampling);
+        workspace.voxelGrid.Downsample(workspace.densePointCloud, m_parameters.voxelLeafSizeMm, workspace.pointCloud);
+        return;
+    }
+
+    const ScopedLatency latency(LatencyStage::PointCloudCreation);
+    if (m_parameters.organizedPointCloud)
+    {
+        CreateOrganizedPointCloud(depth, images.depthValid.View(), images.intensity.View(), m_lensModel,
+            m_parameters.invalidPointValue, workspace.pointCloud, images.workArea);
+    }
+    else
+    {
+        nion::CreatePointCloud(depth, images.depthValid.View(), images.intensity.View(), m_lensModel,
+            workspace.pointCloud, images.validBounds);
+    }
+}
+
+const LensModel& DirectProcessor::Model() const
+{
+    return m_lensModel;
+}
+
+const UndistortionMap& DirectProcessor::Undistortion() const
+{
+    return *m_undistortionMap;
+}
+
+const PixelRegion& DirectProcessor::WorkArea() const
+{
+    return m_workArea;
+}
+
+const std::vector<uint8_t>& DirectProcessor::RawDepthValidity() const
+{
+    return m_isRawDepthValid;
+}
+
+} // namespace nion
@@ -0,0 +1,150 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// IDS peak headers
+#include <peak_icv/peak_icv.hpp>
+
+// Project headers
+#include "bounded_queue.hpp"
+#include "depth_conversion.hpp"
+#include "image_plane.hpp"
+#include "lens_model.hpp"
+#include "point_cloud.hpp"
+#include "processing.hpp"
+#include "temporal_filter.hpp"
+#include "undistortion_map.hpp"
+#include "voxel_grid.hpp"
+
+namespace nion
+{
+
+// Preallocated images of the direct processing backend. A workspace is allocated once
+// and reused for every frame. Invalid depth pixels are 0 with a validity of 0.
+struct FrameWorkspace
+{
+    FrameWorkspace(size_t width, size_t height);
+
+    // Undistorted depth map in raw values, which give the metric values when multiplied with the scale factor
+    Plane<uint16_t> rawDepth;
+    Plane<uint8_t> depthValid;
+
+    // Metric depth map, only converted from the raw depth map if a consumer requires metric values, see
+    // DirectProcessor::ConvertDepthMap(). Allocated by the first conversion.
+    Plane<float> depth;
+    bool isDepthConverted{};
+
+    Plane<uint16_t> intensity;
+    PointCloud pointCloud;
+
+    // Work area of the processor, and the bounding box of the valid depth pixels of the current frame within it.
+    // Organized point clouds have the size of the work area.
+    PixelRegion workArea;
+    PixelRegion validBounds;
+
+    // Full point cloud before voxel grid downsampling, if enabled
+    PointCloud densePointCloud;
+    VoxelGridFilter voxelGrid;
+
+    // Validity of one converted row, which is already known from depthValid
+    std::vector<uint8_t> conversionValidRow;
+};
+
+// Fixed set of workspaces, so that new frames can be processed while the results
+// of earlier frames are still in use, e.g. while they are written to file
+class WorkspacePool
+{
+public:
+    WorkspacePool(size_t numWorkspaces, size_t width, size_t height);
+
+    // Take a free workspace, waiting until one is released
+    FrameWorkspace* Acquire();
+
+    // Take a free workspace if there is one, otherwise return nullptr
+    FrameWorkspace* TryAcquire();
+
+    void Release(FrameWorkspace* workspace);
+
+private:
+    std::vector<std::unique_ptr<FrameWorkspace>> m_workspaces;
+    BoundedQueue<FrameWorkspace*> m_freeWorkspaces;
+};
+
+// Processes the raw images directly from the buffer memory into a FrameWorkspace.
+// Apart from the workspace, no memory is allocated, and the raw images are read
+// only by ProcessDepthMap() and UndistortIntensity(). The buffer can be queued
+// again as soon as both are done. Depth map and intensity image are undistorted
+// with the same precomputed UndistortionMap. Only the pixels of the work area of
+// the processing parameters are processed, and only the bounding box of the valid
+// depth pixels is back-projected, so the cost follows the size of the scene of
+// interest instead of the sensor resolution. The workspaces of a processor must
+// not be used by a processor with a different work area.
+class DirectProcessor
+{
+public:
+    DirectProcessor(const peak::icv::CalibrationParameters& calibration, const ProcessingParameters& parameters);
+
+    // Undistort the raw depth map and mark pixels outside the valid depth interval or the optional distance
+    // filter, in a single pass over the image. The depth values are kept raw, which halves the memory written per
+    // frame. With the temporal filter, the depth map is converted to metric values and averaged with the previous
+    // ones.
+    void ProcessDepthMap(PlaneView<const uint16_t> rawDepth, FrameWorkspace& workspace) const;
+
+    // Convert the undistorted raw depth map into the metric depth map of the workspace, e.g. before it is written to
+    // file. Does nothing if it is already converted.
+    void ConvertDepthMap(FrameWorkspace& workspace) const;
+
+    void UndistortIntensity(PlaneView<const uint16_t> rawIntensity, FrameWorkspace& workspace) const;
+
+    // The metric depth map if it is already converted, e.g. by the temporal filter, and the raw depth map with the
+    // scale factor otherwise, which is half the size. A raw view stays valid when the depth map is converted later.
+    DepthMapView DepthMap(const FrameWorkspace& workspace) const;
+
+    // Create the point cloud from the undistorted depth map and intensity image, downsampled on a voxel grid
+    // if voxelLeafSizeMm is set. Unless the metric depth map was converted, the points are computed from the raw
+    // depth map directly.
+    void CreatePointCloud(FrameWorkspace& workspace) const;
+
+    // Used by OpenClProcessor to process the frames on the device in the same way
+    const LensModel& Model() const;
+    const UndistortionMap& Undistortion() const;
+    const PixelRegion& WorkArea() const;
+    const std::vector<uint8_t>& RawDepthValidity() const;
+
+private:
+    ProcessingParameters m_parameters;
+    LensModel m_lensModel;
+    std::shared_ptr<const UndistortionMap> m_undistortionMap;
+
+    // Processed pixels of the undistorted images
+    PixelRegion m_workArea;
+
+    // Valid depth interval combined with the optional distance filter
+    peak::common::IntervalF m_depthInterval;
+
+    // Validity of every raw depth value, as determined by ConvertDepth() with the depth interval
+    std::vector<uint8_t> m_isRawDepthValid;
+
+    // Keeps the previous depth maps, so it is used by all frames of the processor in turn
+    std::unique_ptr<TemporalDepthFilter> m_temporalFilter;
+};
+
+} // namespace nion
@@ -0,0 +1,209 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "file_output.hpp"
+
+// Standard headers
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+// Create an ICV image from a plane, e.g. to write it with the ImageWriter.
+// The image copies the data of the plane.
+template <typename T>
+peak::icv::Image ToImage(PlaneView<const T> plane, peak::common::PixelFormat pixelFormat)
+{
+    if (plane.stride != plane.width)
+    {
+        throw std::invalid_argument("Only contiguous planes can be converted to an image.");
+    }
+
+    const peak::common::ImageView view(pixelFormat, peak::common::Size{ plane.width, plane.height },
+        reinterpret_cast<uint8_t*>(const_cast<T*>(plane.data)), plane.NumPixels() * sizeof(T));
+
+    return peak::icv::Image(view);
+}
+
+// Print the message with a single write, so that messages of concurrent writes are not interleaved.
+// The output is not flushed, which would slow down writing many files.
+void PrintFileWritten(const std::string& description, const std::string& filePath)
+{
+    std::cout << (description + " written to: " + filePath + "\n");
+}
+
+} // namespace
+
+std::string GetOutputFilePath()
+{
+#ifdef __linux__
+    return "/tmp/";
+#elif _WIN32
+    return "C:/Users/Public/Pictures/";
+#else
+#    error Platform not supported
+#endif
+}
+
+std::string FrameFileSuffix(const std::string& cameraName, size_t i)
+{
+    return (cameraName.empty() ? "" : "_" + cameraName) + "_" + std::to_string(i);
+}
+
+void WriteDepthMapToFile(const peak::icv::Image& depthMap, const std::string& fileSuffix)
+{
+    const ScopedLatency latency(LatencyStage::WriteDepthMap);
+
+    // The writers are created once per thread instead of for every file
+    thread_local const peak::icv::ImageWriter imageWriter;
+
+    // When written to file the set region is ignored and
+    // all pixels are displayed if you want to change this
+    // you have to paint the unused pixels with the Painter class
+    const auto undistortedDepthMapFilePath = GetOutputFilePath() + "undistorted_depth_map" + fileSuffix + ".tiff";
+    imageWriter.Write(undistortedDepthMapFilePath, depthMap);
+    PrintFileWritten("Undistorted depth map", undistortedDepthMapFilePath);
+}
+
+void WriteIntensityToFile(const peak::icv::Image& intensity, const std::string& fileSuffix)
+{
+    const ScopedLatency latency(LatencyStage::WriteIntensity);
+
+    thread_local const peak::icv::ImageWriter imageWriter;
+
+    const auto undistortedIntensityImageFilePath = GetOutputFilePath() + "undistorted_intensity_image" + fileSuffix
+        + ".png";
+    imageWriter.Write(undistortedIntensityImageFilePath, intensity);
+    PrintFileWritten("Undistorted intensity image", undistortedIntensityImageFilePath);
+}
+
+void WritePointCloudToFile(const peak::icv::PointCloudXYZI& pointCloud, const std::string& fileSuffix)
+{
+    const ScopedLatency latency(LatencyStage::WritePointCloud);
+
+    thread_local const peak::icv::PointCloudWriter pointCloudWriter;
+
+    const auto pointCloudFilePath = GetOutputFilePath() + "point_cloud_xyzi" + fileSuffix + ".ply";
+
+    pointCloudWriter.Write(pointCloudFilePath, pointCloud);
+    PrintFileWritten("Point cloud", pointCloudFilePath);
+}
+
+void WriteDepthMapToFile(PlaneView<const float> depthMap, const std::string& fileSuffix)
+{
+    WriteDepthMapToFile(ToImage(depthMap, peak::common::PixelFormat::Coord3D_C32f), fileSuffix);
+}
+
+void WriteIntensityToFile(PlaneView<const uint16_t> intensity, const std::string& fileSuffix)
+{
+    WriteIntensityToFile(ToImage(intensity, peak::common::PixelFormat::Mono16), fileSuffix);
+}
+
+void WritePointCloudToFile(
+    const PointCloud& pointCloud, const std::string& fileSuffix, const PointCloudFormatSettings& formatSettings)
+{
+    const ScopedLatency latency(LatencyStage::WritePointCloud);
+
+    const auto pointCloudFilePath = GetOutputFilePath() + "point_cloud_xyzi" + fileSuffix
+        + PointCloudFileExtension(formatSettings.format);
+
+    // Encoded once per thread into the same memory and written with a single call
+    thread_local std::vector<uint8_t> data;
+    ScopedLatency encodingLatency(LatencyStage::PointCloudEncoding);
+    EncodePointCloud(pointCloud, formatSettings, data);
+    encodingLatency.Stop();
+
+    std::ofstream file(pointCloudFilePath, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open file: " + pointCloudFilePath);
+    }
+
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write file: " + pointCloudFilePath);
+    }
+
+    PrintFileWritten("Point cloud", pointCloudFilePath);
+}
+
+FileWriteJob CreateFrameWriteJob(const std::string& fileSuffix, std::shared_ptr<const peak::icv::Image> depthMap,
+    std::shared_ptr<const peak::icv::Image> intensity, std::shared_ptr<const peak::icv::PointCloudXYZI> pointCloud)
+{
+    FileWriteJob job;
+    if (depthMap)
+    {
+        job.writes.emplace_back([fileSuffix, depthMap] {
+            WriteDepthMapToFile(*depthMap, fileSuffix);
+        });
+    }
+
+    if (intensity)
+    {
+        job.writes.emplace_back([fileSuffix, intensity] {
+            WriteIntensityToFile(*intensity, fileSuffix);
+        });
+    }
+
+    if (pointCloud)
+    {
+        job.writes.emplace_back([fileSuffix, pointCloud] {
+            WritePointCloudToFile(*pointCloud, fileSuffix);
+        });
+    }
+
+    return job;
+}
+
+FileWriteJob CreateFrameWriteJob(const std::string& fileSuffix, const FrameWorkspace& workspace,
+    const OutputStages& stages, const PointCloudFormatSettings& formatSettings)
+{
+    const auto* results = &workspace;
+
+    FileWriteJob job;
+    if (stages.writeDepthMap)
+    {
+        job.writes.emplace_back([fileSuffix, results] {
+            WriteDepthMapToFile(results->depth.View(), fileSuffix);
+        });
+    }
+
+    if (stages.writeIntensity)
+    {
+        job.writes.emplace_back([fileSuffix, results] {
+            WriteIntensityToFile(results->intensity.View(), fileSuffix);
+        });
+    }
+
+    if (stages.writePointCloud)
+    {
+        job.writes.emplace_back([fileSuffix, results, formatSettings] {
+            WritePointCloudToFile(results->pointCloud, fileSuffix, formatSettings);
+        });
+    }
+
+    return job;
+}
+
+} // namespace nion
@@ -0,0 +1,69 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// IDS peak headers
+#include <peak_icv/peak_icv.hpp>
+
+// Project headers
+#include "direct_processing.hpp"
+#include "file_writer.hpp"
+#include "image_plane.hpp"
+#include "point_cloud.hpp"
+#include "point_cloud_encoding.hpp"
+#include "processing.hpp"
+
+namespace nion
+{
+
+// Get platform-dependent output directory
+std::string GetOutputFilePath();
+
+// Suffix of the output files of frame i, e.g. "_3". With several cameras, the files
+// of each camera are told apart by the camera name, e.g. "_1234567890_3".
+std::string FrameFileSuffix(const std::string& cameraName, size_t i);
+
+void WriteDepthMapToFile(const peak::icv::Image& depthMap, const std::string& fileSuffix);
+
+void WriteIntensityToFile(const peak::icv::Image& intensity, const std::string& fileSuffix);
+
+void WritePointCloudToFile(const peak::icv::PointCloudXYZI& pointCloud, const std::string& fileSuffix);
+
+// Overloads for the results of the direct processing backend
+void WriteDepthMapToFile(PlaneView<const float> depthMap, const std::string& fileSuffix);
+
+void WriteIntensityToFile(PlaneView<const uint16_t> intensity, const std::string& fileSuffix);
+
+void WritePointCloudToFile(
+    const PointCloud& pointCloud, const std::string& fileSuffix, const PointCloudFormatSettings& formatSettings);
+
+// Create a FileWriter job that writes the output files of a frame, see FrameFileSuffix().
+// Results that are null are not written.
+FileWriteJob CreateFrameWriteJob(const std::string& fileSuffix, std::shared_ptr<const peak::icv::Image> depthMap,
+    std::shared_ptr<const peak::icv::Image> intensity, std::shared_ptr<const peak::icv::PointCloudXYZI> pointCloud);
+
+// Writes the results selected by the output stages.
+// The workspace must not be reused before onFinished of the job is called.
+FileWriteJob CreateFrameWriteJob(const std::string& fileSuffix, const FrameWorkspace& workspace,
+    const OutputStages& stages, const PointCloudFormatSettings& formatSettings);
+
+} // namespace nion
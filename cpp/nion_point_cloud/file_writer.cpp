@@ -0,0 +1,223 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "file_writer.hpp"
+
+// Standard headers
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace nion
+{
+
+class FileWriter::Completion
+{
+public:
+    explicit Completion(std::function<void()> onFinished)
+        : m_onFinished(std::move(onFinished))
+    {}
+
+    ~Completion()
+    {
+        if (!m_onFinished)
+        {
+            return;
+        }
+
+        try
+        {
+            m_onFinished();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error: Failed to finish file write job: " << e.what() << std::endl;
+        }
+    }
+
+    Completion(const Completion&) = delete;
+    Completion& operator=(const Completion&) = delete;
+    Completion(Completion&&) = delete;
+    Completion& operator=(Completion&&) = delete;
+
+private:
+    std::function<void()> m_onFinished;
+};
+
+FileWriter::FileWriter(const FileWriterSettings& settings)
+    : m_settings(settings)
+    , m_queue(settings.queueCapacity)
+{
+    if (settings.numThreads == 0 || settings.queueCapacity == 0)
+    {
+        throw std::invalid_argument("The file writer requires at least one thread and a queue capacity of one.");
+    }
+
+    for (size_t i = 0; i < settings.numThreads; ++i)
+    {
+        m_threads.emplace_back(&FileWriter::Run, this);
+    }
+
+    try
+    {
+        for (auto& thread : m_threads)
+        {
+            PlaceThread(thread, settings.placement);
+        }
+    }
+    catch (...)
+    {
+        StopThreads();
+        throw;
+    }
+}
+
+FileWriter::~FileWriter()
+{
+    StopThreads();
+}
+
+bool FileWriter::Submit(FileWriteJob job)
+{
+    // Created first, so onFinished is also called if an earlier error is rethrown
+    auto completion = std::make_shared<Completion>(std::move(job.onFinished));
+
+    RethrowWriteError();
+
+    if (m_settings.groupByFrame)
+    {
+        return Enqueue({ std::move(job.writes), std::move(completion) });
+    }
+
+    auto isEverythingQueued = true;
+    for (auto& write : job.writes)
+    {
+        QueuedWrites single;
+        single.writes.push_back(std::move(write));
+        single.completion = completion;
+
+        isEverythingQueued = Enqueue(std::move(single)) && isEverythingQueued;
+    }
+
+    return isEverythingQueued;
+}
+
+void FileWriter::Finish()
+{
+    StopThreads();
+    RethrowWriteError();
+}
+
+size_t FileWriter::NumWrittenFiles() const
+{
+    return m_numWrittenFiles;
+}
+
+size_t FileWriter::NumDroppedFiles() const
+{
+    return m_numDroppedFiles;
+}
+
+bool FileWriter::Enqueue(QueuedWrites writes)
+{
+    const auto numFiles = writes.writes.size();
+
+    switch (m_settings.policy)
+    {
+    case WriteQueuePolicy::Block:
+        if (m_queue.Push(std::move(writes)))
+        {
+            return true;
+        }
+        break;
+    case WriteQueuePolicy::DropNewest:
+        if (m_queue.TryPush(std::move(writes)))
+        {
+            return true;
+        }
+        break;
+    case WriteQueuePolicy::DropOldest:
+    {
+        std::vector<QueuedWrites> removed;
+        const auto isQueued = m_queue.PushDropOldest(std::move(writes), removed);
+        for (const auto& oldest : removed)
+        {
+            m_numDroppedFiles += oldest.writes.size();
+        }
+        if (isQueued)
+        {
+            return true;
+        }
+        break;
+    }
+    }
+
+    // Dropping the writes releases their completion
+    m_numDroppedFiles += numFiles;
+    return false;
+}
+
+void FileWriter::Run()
+{
+    QueuedWrites queued;
+    while (m_queue.Pop(queued))
+    {
+        for (auto& write : queued.writes)
+        {
+            try
+            {
+                write();
+                ++m_numWrittenFiles;
+            }
+            catch (...)
+            {
+                // Keep writing, so every job is finished and its images are released
+                const std::lock_guard<std::mutex> lock(m_errorMutex);
+                if (!m_error)
+                {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+
+        // Release the completion before waiting for the next files
+        queued = QueuedWrites{};
+    }
+}
+
+void FileWriter::StopThreads()
+{
+    // The workers write all remaining files before they stop
+    m_queue.Close();
+
+    for (auto& thread : m_threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+}
+
+void FileWriter::RethrowWriteError()
+{
+    const std::lock_guard<std::mutex> lock(m_errorMutex);
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+} // namespace nion
@@ -0,0 +1,121 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "bounded_queue.hpp"
+#include "thread_placement.hpp"
+
+namespace nion
+{
+
+// What happens to new files when the write queue of the FileWriter is full
+enum class WriteQueuePolicy
+{
+    // Wait until there is space in the queue, which slows down the caller
+    Block,
+    // Discard the new files
+    DropNewest,
+    // Discard the oldest queued files to make space for the new ones
+    DropOldest
+};
+
+struct FileWriterSettings
+{
+    size_t numThreads{ 2 };
+    size_t queueCapacity{ 8 };
+    WriteQueuePolicy policy{ WriteQueuePolicy::Block };
+
+    // Write all files of a frame one after another on the same thread. Otherwise,
+    // every file is queued separately and the files of a frame are written in parallel.
+    bool groupByFrame{ true };
+
+    // CPUs and priority of the writer threads
+    ThreadPlacement placement{};
+};
+
+// All files of one frame
+struct FileWriteJob
+{
+    std::vector<std::function<void()>> writes;
+
+    // Called once all files are written or dropped, e.g. to release the images of the frame
+    std::function<void()> onFinished;
+};
+
+// Writes files on a pool of worker threads, so slow disks do not delay the acquisition
+// or processing. The number of queued files is bounded, see WriteQueuePolicy.
+class FileWriter
+{
+public:
+    explicit FileWriter(const FileWriterSettings& settings);
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+    FileWriter(FileWriter&&) = delete;
+    FileWriter& operator=(FileWriter&&) = delete;
+
+    // Queue the files of a frame. Returns false if some of them were dropped right away.
+    // Rethrows the first error that occurred while writing earlier files, in which case the
+    // files are dropped. onFinished of the job is called in any case. Can be called from any thread.
+    bool Submit(FileWriteJob job);
+
+    // Write all queued files and stop the worker threads.
+    // Rethrows the first error that occurred while writing.
+    void Finish();
+
+    size_t NumWrittenFiles() const;
+    size_t NumDroppedFiles() const;
+
+private:
+    // Calls onFinished of a job once all of its queued parts are done
+    class Completion;
+
+    struct QueuedWrites
+    {
+        std::vector<std::function<void()>> writes{};
+        std::shared_ptr<Completion> completion{};
+    };
+
+    bool Enqueue(QueuedWrites writes);
+    void Run();
+    void StopThreads();
+    void RethrowWriteError();
+
+    FileWriterSettings m_settings;
+    BoundedQueue<QueuedWrites> m_queue;
+
+    std::atomic<size_t> m_numWrittenFiles{ 0 };
+    std::atomic<size_t> m_numDroppedFiles{ 0 };
+
+    std::mutex m_errorMutex;
+    std::exception_ptr m_error{};
+
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace nion
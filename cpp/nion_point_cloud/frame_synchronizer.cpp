@@ -0,0 +1,134 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "frame_synchronizer.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace nion
+{
+namespace
+{
+
+uint64_t TimestampDifference(uint64_t a, uint64_t b)
+{
+    return a > b ? a - b : b - a;
+}
+
+} // namespace
+
+FrameSynchronizer::FrameSynchronizer(size_t numCameras, uint64_t toleranceNs, size_t maxPendingFrames)
+    : m_toleranceNs(toleranceNs)
+    , m_maxPendingFrames(std::max<size_t>(maxPendingFrames, 1))
+    , m_pendingFrames(numCameras)
+{}
+
+FrameSynchronizer::Output FrameSynchronizer::Add(SynchronizedFrame frame)
+{
+    Output output;
+
+    // Frames older than the last slot arrived too late
+    if (m_hasSlot && frame.timestampNs + m_toleranceNs < m_lastSlotTimestampNs)
+    {
+        output.unmatchedFrames.push_back(std::move(frame));
+        ++m_numUnmatchedFrames;
+        return output;
+    }
+
+    // Keep the pending frames of every camera sorted by their timestamps
+    const auto timestampNs = frame.timestampNs;
+    auto& frames = m_pendingFrames.at(frame.camera);
+    const auto position = std::find_if(frames.rbegin(), frames.rend(), [&](const SynchronizedFrame& f) {
+        return f.timestampNs <= timestampNs;
+    });
+    frames.insert(position.base(), std::move(frame));
+
+    // Look for the frame of every camera that is closest to the new frame
+    std::vector<std::deque<SynchronizedFrame>::iterator> matches;
+    auto minTimestampNs = timestampNs;
+    auto maxTimestampNs = timestampNs;
+    for (auto& cameraFrames : m_pendingFrames)
+    {
+        if (cameraFrames.empty())
+        {
+            break;
+        }
+
+        const auto closest = std::min_element(cameraFrames.begin(), cameraFrames.end(),
+            [&](const SynchronizedFrame& a, const SynchronizedFrame& b) {
+                return TimestampDifference(a.timestampNs, timestampNs)
+                    < TimestampDifference(b.timestampNs, timestampNs);
+            });
+        minTimestampNs = std::min(minTimestampNs, closest->timestampNs);
+        maxTimestampNs = std::max(maxTimestampNs, closest->timestampNs);
+        matches.push_back(closest);
+    }
+
+    if (matches.size() == m_pendingFrames.size() && maxTimestampNs - minTimestampNs <= m_toleranceNs)
+    {
+        for (size_t c = 0; c < matches.size(); ++c)
+        {
+            output.slot.push_back(std::move(*matches[c]));
+            m_pendingFrames[c].erase(matches[c]);
+        }
+        m_lastSlotTimestampNs = minTimestampNs;
+        m_hasSlot = true;
+
+        // Frames older than the slot cannot be part of a later slot anymore
+        for (auto& cameraFrames : m_pendingFrames)
+        {
+            while (!cameraFrames.empty() && cameraFrames.front().timestampNs + m_toleranceNs < minTimestampNs)
+            {
+                output.unmatchedFrames.push_back(std::move(cameraFrames.front()));
+                cameraFrames.pop_front();
+            }
+        }
+    }
+
+    for (auto& cameraFrames : m_pendingFrames)
+    {
+        while (cameraFrames.size() > m_maxPendingFrames)
+        {
+            output.unmatchedFrames.push_back(std::move(cameraFrames.front()));
+            cameraFrames.pop_front();
+        }
+    }
+
+    m_numUnmatchedFrames += output.unmatchedFrames.size();
+    return output;
+}
+
+std::vector<SynchronizedFrame> FrameSynchronizer::Flush()
+{
+    std::vector<SynchronizedFrame> frames;
+    for (auto& cameraFrames : m_pendingFrames)
+    {
+        std::move(cameraFrames.begin(), cameraFrames.end(), std::back_inserter(frames));
+        cameraFrames.clear();
+    }
+
+    m_numUnmatchedFrames += frames.size();
+    return frames;
+}
+
+size_t FrameSynchronizer::NumUnmatchedFrames() const
+{
+    return m_numUnmatchedFrames;
+}
+
+} // namespace nion
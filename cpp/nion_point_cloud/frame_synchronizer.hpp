@@ -0,0 +1,75 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+// Project headers
+#include "point_cloud.hpp"
+
+namespace nion
+{
+
+// Point cloud of one camera, waiting for the point clouds of the other cameras
+struct SynchronizedFrame
+{
+    size_t camera{};
+    uint64_t timestampNs{};
+    const PointCloud* pointCloud{};
+
+    // Called once the point cloud is no longer used
+    std::function<void()> release{};
+};
+
+// Groups the frames of several cameras into time slots by their device timestamps. A slot contains one frame of
+// every camera, and the timestamps of its frames differ by at most the tolerance. The device clocks of the cameras
+// have to be synchronized, e.g. by PTP. Frames may be added out of order, as the frames of a camera are processed in
+// parallel. Frames that can no longer be part of a slot are returned as unmatched. Not thread-safe.
+class FrameSynchronizer
+{
+public:
+    struct Output
+    {
+        // Complete slot in the order of the cameras, or empty
+        std::vector<SynchronizedFrame> slot{};
+        std::vector<SynchronizedFrame> unmatchedFrames{};
+    };
+
+    // At most maxPendingFrames frames of a camera wait for the other cameras, older ones are unmatched
+    FrameSynchronizer(size_t numCameras, uint64_t toleranceNs, size_t maxPendingFrames);
+
+    Output Add(SynchronizedFrame frame);
+
+    // Remove all frames that are still waiting
+    std::vector<SynchronizedFrame> Flush();
+
+    size_t NumUnmatchedFrames() const;
+
+private:
+    uint64_t m_toleranceNs;
+    size_t m_maxPendingFrames;
+    std::vector<std::deque<SynchronizedFrame>> m_pendingFrames;
+    uint64_t m_lastSlotTimestampNs{};
+    bool m_hasSlot{};
+    size_t m_numUnmatchedFrames{};
+};
+
+} // namespace nion
@@ -0,0 +1,113 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <vector>
+
+namespace nion
+{
+
+// Non-owning view of a single-channel image. The stride is given in elements.
+template <typename T>
+struct PlaneView
+{
+    T* data{};
+    size_t width{};
+    size_t height{};
+    size_t stride{};
+
+    T* Row(size_t y) const
+    {
+        return data + y * stride;
+    }
+
+    size_t NumPixels() const
+    {
+        return width * height;
+    }
+};
+
+// View of the same image without write access
+template <typename T>
+PlaneView<const T> AsConst(PlaneView<T> view)
+{
+    return { view.data, view.width, view.height, view.stride };
+}
+
+// Rectangle of pixels, e.g. the part of an image that is processed
+struct PixelRegion
+{
+    size_t x{};
+    size_t y{};
+    size_t width{};
+    size_t height{};
+
+    bool IsEmpty() const
+    {
+        return width == 0 || height == 0;
+    }
+};
+
+// View of the pixels of the region, which must lie inside the image
+template <typename T>
+PlaneView<T> Crop(PlaneView<T> view, const PixelRegion& region)
+{
+    return { view.Row(region.y) + region.x, region.width, region.height, view.stride };
+}
+
+// Single-channel image that owns its memory. The memory is only allocated
+// on construction, so it can be reused for every frame.
+template <typename T>
+class Plane
+{
+public:
+    Plane() = default;
+
+    Plane(size_t width, size_t height)
+        : m_data(width * height)
+        , m_width(width)
+        , m_height(height)
+    {}
+
+    PlaneView<T> View()
+    {
+        return { m_data.data(), m_width, m_height, m_width };
+    }
+
+    PlaneView<const T> View() const
+    {
+        return { m_data.data(), m_width, m_height, m_width };
+    }
+
+    size_t Width() const
+    {
+        return m_width;
+    }
+
+    size_t Height() const
+    {
+        return m_height;
+    }
+
+private:
+    std::vector<T> m_data;
+    size_t m_width{};
+    size_t m_height{};
+};
+
+} // namespace nion
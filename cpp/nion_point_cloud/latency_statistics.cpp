@@ -0,0 +1,324 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "latency_statistics.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace nion
+{
+namespace
+{
+
+size_t HighestBit(uint64_t value)
+{
+    size_t bit = 0;
+    while (value >>= 1)
+    {
+        ++bit;
+    }
+    return bit;
+}
+
+double ToMicroseconds(uint64_t nanoseconds)
+{
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+
+} // namespace
+
+const char* ToString(LatencyStage stage)
+{
+    switch (stage)
+    {
+    case LatencyStage::WaitForBuffer:
+        return "WaitForBuffer";
+    case LatencyStage::ExtractBufferParts:
+        return "ExtractBufferParts";
+    case LatencyStage::RawFrameCopy:
+        return "RawFrameCopy";
+    case LatencyStage::DepthConversion:
+        return "DepthConversion";
+    case LatencyStage::DepthValidityThreshold:
+        return "DepthValidityThreshold";
+    case LatencyStage::DepthUndistortion:
+        return "DepthUndistortion";
+    case LatencyStage::DistanceFilter:
+        return "DistanceFilter";
+    case LatencyStage::IntensityUndistortion:
+        return "IntensityUndistortion";
+    case LatencyStage::DepthProcessing:
+        return "DepthProcessing";
+    case LatencyStage::TemporalFiltering:
+        return "TemporalFiltering";
+    case LatencyStage::OpenClProcessing:
+        return "OpenClProcessing";
+    case LatencyStage::PointCloudCreation:
+        return "PointCloudCreation";
+    case LatencyStage::VoxelGridDownsampling:
+        return "VoxelGridDownsampling";
+    case LatencyStage::PointCloudMerge:
+        return "PointCloudMerge";
+    case LatencyStage::PointCloudEncoding:
+        return "PointCloudEncoding";
+    case LatencyStage::WriteDepthMap:
+        return "WriteDepthMap";
+    case LatencyStage::WriteIntensity:
+        return "WriteIntensity";
+    case LatencyStage::WritePointCloud:
+        return "WritePointCloud";
+    case LatencyStage::SendPointCloud:
+        return "SendPointCloud";
+    case LatencyStage::PublishSharedMemory:
+        return "PublishSharedMemory";
+    case LatencyStage::WriteSequence:
+        return "WriteSequence";
+    case LatencyStage::RecordingCompression:
+        return "RecordingCompression";
+    case LatencyStage::ReceiveToPointCloud:
+        return "ReceiveToPointCloud";
+    case LatencyStage::ReceiveToFilesWritten:
+        return "ReceiveToFilesWritten";
+    case LatencyStage::DeviceFrameInterval:
+        return "DeviceFrameInterval";
+    case LatencyStage::TransportDelay:
+        return "TransportDelay";
+    case LatencyStage::Count:
+        break;
+    }
+
+    return "Unknown";
+}
+
+void LatencyHistogram::Record(uint64_t nanoseconds)
+{
+    m_buckets[BucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+
+    auto max = m_max.load(std::memory_order_relaxed);
+    while (nanoseconds > max && !m_max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64_t LatencyHistogram::Count() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Max() const
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) const
+{
+    const auto count = Count();
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count))));
+
+    uint64_t cumulativeCount = 0;
+    for (size_t i = 0; i < numBuckets; ++i)
+    {
+        cumulativeCount += m_buckets[i].load(std::memory_order_relaxed);
+        if (cumulativeCount >= rank)
+        {
+            return std::min(BucketUpperBound(i), Max());
+        }
+    }
+
+    return Max();
+}
+
+size_t LatencyHistogram::BucketIndex(uint64_t nanoseconds)
+{
+    if (nanoseconds < numSubBuckets)
+    {
+        return static_cast<size_t>(nanoseconds);
+    }
+
+    // Keep the highest subBucketBits + 1 bits of the value
+    const auto shift = HighestBit(nanoseconds) - subBucketBits;
+    const auto subBucket = static_cast<size_t>(nanoseconds >> shift) - numSubBuckets;
+    return numSubBuckets + shift * numSubBuckets + subBucket;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index)
+{
+    if (index < numSubBuckets)
+    {
+        return index;
+    }
+
+    const auto shift = (index - numSubBuckets) / numSubBuckets;
+    const auto subBucket = (index - numSubBuckets) % numSubBuckets;
+    const auto lowerBound = static_cast<uint64_t>(numSubBuckets + subBucket) << shift;
+    return lowerBound + ((uint64_t{ 1 } << shift) - 1);
+}
+
+LatencyStatistics& LatencyStatistics::Instance()
+{
+    static LatencyStatistics instance;
+    return instance;
+}
+
+void LatencyStatistics::SetEnabled(bool enabled)
+{
+    m_isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool LatencyStatistics::IsEnabled() const
+{
+    return m_isEnabled.load(std::memory_order_relaxed);
+}
+
+void LatencyStatistics::Record(LatencyStage stage, std::chrono::steady_clock::duration duration)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    m_histograms[static_cast<size_t>(stage)].Record(static_cast<uint64_t>(std::max<int64_t>(nanoseconds, 0)));
+}
+
+void LatencyStatistics::RecordSince(LatencyStage stage, std::chrono::steady_clock::time_point start)
+{
+    if (IsEnabled())
+    {
+        Record(stage, std::chrono::steady_clock::now() - start);
+    }
+}
+
+void LatencyStatistics::Print(std::ostream& stream) const
+{
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << "Latency statistics [us]:\n"
+           << std::left << std::setw(24) << "  Stage" << std::right << std::setw(8) << "Count" << std::setw(12)
+           << "p50" << std::setw(12) << "p99" << std::setw(12) << "Max" << "\n"
+           << std::fixed << std::setprecision(1);
+
+    for (size_t i = 0; i < m_histograms.size(); ++i)
+    {
+        const auto& histogram = m_histograms[i];
+        if (histogram.Count() == 0)
+        {
+            continue;
+        }
+
+        stream << "  " << std::left << std::setw(22) << ToString(static_cast<LatencyStage>(i)) << std::right
+               << std::setw(8) << histogram.Count() << std::setw(12) << ToMicroseconds(histogram.Percentile(50.0))
+               << std::setw(12) << ToMicroseconds(histogram.Percentile(99.0)) << std::setw(12)
+               << ToMicroseconds(histogram.Max()) << "\n";
+    }
+
+    stream.flush();
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void LatencyStatistics::WriteCsv(const std::string& filePath) const
+{
+    std::ofstream file(filePath);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    file << "stage,count,p50_us,p99_us,max_us\n";
+
+    for (size_t i = 0; i < m_histograms.size(); ++i)
+    {
+        const auto& histogram = m_histograms[i];
+        file << ToString(static_cast<LatencyStage>(i)) << "," << histogram.Count() << ","
+             << ToMicroseconds(histogram.Percentile(50.0)) << "," << ToMicroseconds(histogram.Percentile(99.0)) << ","
+             << ToMicroseconds(histogram.Max()) << "\n";
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write file: " + filePath);
+    }
+}
+
+void DeviceTimestampMonitor::OnFrameReceived(
+    uint64_t deviceTimestampNs, std::chrono::steady_clock::time_point receiveTime)
+{
+    auto& latencyStatistics = LatencyStatistics::Instance();
+    if (!latencyStatistics.IsEnabled())
+    {
+        return;
+    }
+
+    const auto receiveTimeNs = static_cast<int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(receiveTime.time_since_epoch()).count());
+    const auto transportOffsetNs = receiveTimeNs - static_cast<int64_t>(deviceTimestampNs);
+
+    if (!m_hasDeviceTimestamp || transportOffsetNs < m_minTransportOffsetNs)
+    {
+        m_minTransportOffsetNs = transportOffsetNs;
+    }
+
+    if (m_hasDeviceTimestamp && deviceTimestampNs > m_lastDeviceTimestampNs)
+    {
+        latencyStatistics.Record(LatencyStage::DeviceFrameInterval,
+            std::chrono::nanoseconds(deviceTimestampNs - m_lastDeviceTimestampNs));
+    }
+
+    latencyStatistics.Record(
+        LatencyStage::TransportDelay, std::chrono::nanoseconds(transportOffsetNs - m_minTransportOffsetNs));
+
+    m_lastDeviceTimestampNs = deviceTimestampNs;
+    m_hasDeviceTimestamp = true;
+}
+
+ScopedLatency::ScopedLatency(LatencyStage stage)
+    : m_stage(stage)
+    , m_isEnabled(LatencyStatistics::Instance().IsEnabled())
+{
+    if (m_isEnabled)
+    {
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedLatency::~ScopedLatency()
+{
+    Stop();
+}
+
+void ScopedLatency::Stop()
+{
+    if (m_isEnabled)
+    {
+        LatencyStatistics::Instance().Record(m_stage, std::chrono::steady_clock::now() - m_start);
+        m_isEnabled = false;
+    }
+}
+
+} // namespace nion
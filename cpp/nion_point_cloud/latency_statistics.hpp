@@ -0,0 +1,170 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace nion
+{
+
+enum class LatencyStage
+{
+    // Acquisition
+    WaitForBuffer,
+    ExtractBufferParts,
+    RawFrameCopy,
+
+    // Processing steps of the ICV backend. The direct backend only converts depth maps whose metric values are used.
+    DepthConversion,
+    DepthValidityThreshold,
+    DepthUndistortion,
+    DistanceFilter,
+    IntensityUndistortion,
+
+    // Fused depth processing of the direct backend
+    DepthProcessing,
+    TemporalFiltering,
+
+    // Upload, processing and download of a frame on the OpenCL device, see OpenClProcessor
+    OpenClProcessing,
+
+    PointCloudCreation,
+    VoxelGridDownsampling,
+
+    // Transforming the point cloud of one camera into a merged point cloud
+    PointCloudMerge,
+
+    // Output
+    PointCloudEncoding,
+    WriteDepthMap,
+    WriteIntensity,
+    WritePointCloud,
+    SendPointCloud,
+    PublishSharedMemory,
+    WriteSequence,
+    RecordingCompression,
+
+    // Host time from receiving the buffer until the point cloud of the frame is created or all files are written
+    ReceiveToPointCloud,
+    ReceiveToFilesWritten,
+
+    // Time between the device timestamps of consecutive frames
+    DeviceFrameInterval,
+
+    // Delay between the device timestamp and receiving the buffer, relative to the smallest delay seen so far.
+    // The device clock is not synchronized to the host, so only the variation of the delay is known.
+    TransportDelay,
+
+    Count
+};
+
+const char* ToString(LatencyStage stage);
+
+// Histogram of durations with logarithmic buckets with a resolution of 1/16 of a power of two,
+// i.e. a relative error below 7 %. Recording is lock-free and can be done from any thread.
+class LatencyHistogram
+{
+public:
+    void Record(uint64_t nanoseconds);
+
+    uint64_t Count() const;
+    uint64_t Max() const;
+
+    // Upper bound of the bucket containing the given percentile (0 to 100), limited to the maximum
+    uint64_t Percentile(double percentile) const;
+
+private:
+    static constexpr size_t subBucketBits = 4;
+    static constexpr size_t numSubBuckets = size_t{ 1 } << subBucketBits;
+    static constexpr size_t numBuckets = numSubBuckets + (64 - subBucketBits) * numSubBuckets;
+
+    static size_t BucketIndex(uint64_t nanoseconds);
+    static uint64_t BucketUpperBound(size_t index);
+
+    std::array<std::atomic<uint64_t>, numBuckets> m_buckets{};
+    std::atomic<uint64_t> m_count{ 0 };
+    std::atomic<uint64_t> m_max{ 0 };
+};
+
+// Durations of all stages of the acquisition, recorded with ScopedLatency or Record().
+// There is a single instance, so that every module can record its steps.
+class LatencyStatistics
+{
+public:
+    static LatencyStatistics& Instance();
+
+    // Recording is disabled by default and costs nothing when disabled
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    void Record(LatencyStage stage, std::chrono::steady_clock::duration duration);
+
+    // Record the time from start until now
+    void RecordSince(LatencyStage stage, std::chrono::steady_clock::time_point start);
+
+    // Print count, p50, p99 and maximum in microseconds of all stages with recorded values
+    void Print(std::ostream& stream) const;
+
+    void WriteCsv(const std::string& filePath) const;
+
+private:
+    LatencyStatistics() = default;
+
+    std::atomic<bool> m_isEnabled{ false };
+    std::array<LatencyHistogram, static_cast<size_t>(LatencyStage::Count)> m_histograms{};
+};
+
+// Records DeviceFrameInterval and TransportDelay from the device timestamps of the buffers of one camera.
+// Only call OnFrameReceived() from the acquisition thread of the camera.
+class DeviceTimestampMonitor
+{
+public:
+    void OnFrameReceived(uint64_t deviceTimestampNs, std::chrono::steady_clock::time_point receiveTime);
+
+private:
+    uint64_t m_lastDeviceTimestampNs{};
+    int64_t m_minTransportOffsetNs{};
+    bool m_hasDeviceTimestamp{};
+};
+
+// Records the time from construction to destruction, or to Stop(), as the duration of a stage
+class ScopedLatency
+{
+public:
+    explicit ScopedLatency(LatencyStage stage);
+    ~ScopedLatency();
+
+    void Stop();
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+    ScopedLatency(ScopedLatency&&) = delete;
+    ScopedLatency& operator=(ScopedLatency&&) = delete;
+
+private:
+    LatencyStage m_stage;
+    bool m_isEnabled;
+    std::chrono::steady_clock::time_point m_start{};
+};
+
+} // namespace nion
@@ -0,0 +1,51 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "lens_model.hpp"
+
+namespace nion
+{
+
+bool operator==(const ImageGeometry& a, const ImageGeometry& b)
+{
+    return a.binningHorizontal == b.binningHorizontal && a.binningVertical == b.binningVertical
+        && a.offsetX == b.offsetX && a.offsetY == b.offsetY && a.width == b.width && a.height == b.height;
+}
+
+bool operator!=(const ImageGeometry& a, const ImageGeometry& b)
+{
+    return !(a == b);
+}
+
+void DistortPixel(const LensModel& model, double u, double v, double& distortedU, double& distortedV)
+{
+    const auto x = (u - model.cx) / model.fx;
+    const auto y = (v - model.cy) / model.fy;
+
+    const auto r2 = x * x + y * y;
+    const auto r4 = r2 * r2;
+    const auto r6 = r4 * r2;
+
+    const auto radial = (1.0 + model.k1 * r2 + model.k2 * r4 + model.k3 * r6)
+        / (1.0 + model.k4 * r2 + model.k5 * r4 + model.k6 * r6);
+
+    const auto xd = x * radial + 2.0 * model.p1 * x * y + model.p2 * (r2 + 2.0 * x * x);
+    const auto yd = y * radial + model.p1 * (r2 + 2.0 * y * y) + 2.0 * model.p2 * x * y;
+
+    distortedU = xd * model.fx + model.cx;
+    distortedV = yd * model.fy + model.cy;
+}
+
+} // namespace nion
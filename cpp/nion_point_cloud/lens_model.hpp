@@ -0,0 +1,60 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdint>
+
+namespace nion
+{
+
+// Binning and ROI of the acquired images, as read from the device
+struct ImageGeometry
+{
+    uint32_t binningHorizontal{ 1 };
+    uint32_t binningVertical{ 1 };
+    uint32_t offsetX{};
+    uint32_t offsetY{};
+    uint32_t width{};
+    uint32_t height{};
+};
+
+// The image metadata, and with it the undistortion, only depends on the geometry, see CreateImageMetadata()
+bool operator==(const ImageGeometry& a, const ImageGeometry& b);
+bool operator!=(const ImageGeometry& a, const ImageGeometry& b);
+
+// Pinhole camera with radial (rational) and tangential distortion, in pixel
+// coordinates of the acquired images (i.e. with binning and ROI applied)
+struct LensModel
+{
+    double fx{};
+    double fy{};
+    double cx{};
+    double cy{};
+    double k1{};
+    double k2{};
+    double k3{};
+    double k4{};
+    double k5{};
+    double k6{};
+    double p1{};
+    double p2{};
+};
+
+// Map a pixel position of the undistorted image to its position in the distorted (acquired) image
+void DistortPixel(const LensModel& model, double u, double v, double& distortedU, double& distortedV);
+
+} // namespace nion
@@ -0,0 +1,155 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace nion
+{
+
+// Lock-free FIFO with a fixed capacity for any number of producer and consumer threads. All elements are allocated
+// on construction, so pushing and popping never allocates. Every cell carries a sequence number that tells producers
+// and consumers whether it is free or filled in the current round, so neither side ever waits for a lock: with a
+// full or empty queue, TryPush() or TryPop() return false immediately. The capacity is rounded up to a power of two,
+// and is at least 2.
+template <typename T>
+class LockFreeQueue
+{
+public:
+    explicit LockFreeQueue(size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("The capacity of the queue must be positive.");
+        }
+
+        // A single cell cannot tell a full round from an empty one, so there are at least two
+        size_t numCells = 2;
+        while (numCells < capacity)
+        {
+            numCells *= 2;
+        }
+
+        m_cells = std::make_unique<Cell[]>(numCells);
+        m_mask = numCells - 1;
+        for (size_t i = 0; i < numCells; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+    LockFreeQueue(LockFreeQueue&&) = delete;
+    LockFreeQueue& operator=(LockFreeQueue&&) = delete;
+
+    // Add an element if there is space left. Never waits.
+    bool TryPush(T value)
+    {
+        auto position = m_pushPosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = m_cells[position & m_mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0)
+            {
+                // The cell is free in this round, claim it
+                if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The cell still holds the element of the previous round
+                return false;
+            }
+            else
+            {
+                position = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Remove the oldest element if there is one. Never waits.
+    bool TryPop(T& value)
+    {
+        auto position = m_popPosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = m_cells[position & m_mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference
+                = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            if (difference == 0)
+            {
+                // The cell is filled in this round, claim it
+                if (m_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_popPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t Capacity() const
+    {
+        return m_mask + 1;
+    }
+
+private:
+    // Keeps the positions of producers and consumers on separate cache lines
+    static constexpr size_t cacheLineSize = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence{ 0 };
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask{};
+
+    char m_padding0[cacheLineSize]{};
+    std::atomic<size_t> m_pushPosition{ 0 };
+    char m_padding1[cacheLineSize - sizeof(std::atomic<size_t>)]{};
+    std::atomic<size_t> m_popPosition{ 0 };
+    char m_padding2[cacheLineSize - sizeof(std::atomic<size_t>)]{};
+};
+
+} // namespace nion
@@ -15,29 +15,81 @@
 
 // Standard headers
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
 #include <cstring>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 // IDS peak headers
 #include <peak/peak.hpp>
 #include <peak_icv/peak_icv.hpp>
 
+// Project headers
+#include "buffer_handle.hpp"
+#include "buffer_statistics.hpp"
+#include "calibration_cache.hpp"
+#include "device_configuration.hpp"
+#include "direct_processing.hpp"
+#include "file_output.hpp"
+#include "file_writer.hpp"
+#include "latency_statistics.hpp"
+#include "node_cache.hpp"
+#include "pipeline.hpp"
+#include "point_cloud_encoding.hpp"
+#include "point_cloud_merger.hpp"
+#include "point_cloud_stream.hpp"
+#include "processing.hpp"
+#include "recording.hpp"
+#include "sequence_file.hpp"
+#include "shared_memory_ring.hpp"
+#include "thread_placement.hpp"
+#include "throughput_controller.hpp"
+#include "worker_pool.hpp"
+
 namespace
 {
 // ---------------------------------------------------------------------------------------------------------------------
 // CONFIGURATION
 // ---------------------------------------------------------------------------------------------------------------------
 
+// Serial numbers of the IDS Nion devices to use. If empty, all connected IDS Nion devices are used.
+const std::vector<std::string> deviceSerialNumbers{};
+
 // Enable filtering of depth values based on the camera confidence image
 constexpr bool filterDepthMapByConfidenceEnabled = true;
 
 // Pixels with confidence values below this threshold are marked as invalid. The Range is 0 to 4095.
 constexpr int32_t confidenceThreshold = 100;
 
-// Camera exposure time in microseconds
+// Keep a copy of the factory calibration of every device in the output folder. The calibration file is then only
+// transferred from the device on the first start, or if its size changes. The device provides no checksum or version of
+// its calibration, so a recalibration that keeps the size is not detected and the old copy is used. Only enable the
+// cache if you delete the cache file (nion_calibration_<serial number>.bin) after every recalibration.
+constexpr bool calibrationCacheEnabled = false;
+
+// Camera exposure time in microseconds. The device may round the value, differences up to the tolerance are ignored.
 constexpr float exposureTimeUs = 1000.0F;
+constexpr double exposureTimeToleranceUs = 1.0;
+
+// How the settings above are written to the device at startup:
+// - ResetToDefault:   load the Default user set, then write the settings
+// - ApplyDifferences: keep the current state of the device and only write the settings that differ. Settings not
+//                     configured by this example keep the values of earlier sessions.
+// - CustomUserSet:    load customUserSet, which is saved with the settings on the first start and whenever the
+//                     settings change. This replaces loading Default and writing every setting.
+constexpr nion::DeviceStartupMode deviceStartupMode = nion::DeviceStartupMode::ResetToDefault;
+constexpr const char* customUserSet = "UserSet0";
 
 // Enable filtering of depth values based on the Z distance
 constexpr bool filterDistanceEnabled = true;
@@ -45,9 +97,215 @@ constexpr bool filterDistanceEnabled = true;
 // Valid Z distance interval in millimeters
 constexpr peak::common::IntervalF filterDistanceIntervalMm{ 100.0F, 1000.0F };
 
+// Direct backend: only process the pixels of this region of the undistorted images, e.g. the conveyor belt, so the
+// processing time follows the size of the region instead of the sensor resolution. Pixels outside of it are invalid,
+// and organized point clouds have the size of the region. A width or height of 0 processes the whole image.
+constexpr nion::PixelRegion workArea{ 0, 0, 0, 0 };
+
+// Direct backend: average every depth map with the previous ones of the camera, which reduces the noise in static
+// scenes, e.g. to allow a shorter exposure time. temporalFilterFrameCount depth maps (2 to 255, 0 to disable) are
+// averaged per pixel, and pixels that are valid in fewer than temporalFilterMinValidCount of them are invalid. Pixels
+// deviating more than temporalFilterMaxDeviationMm from the average keep their new depth, so moving objects are not
+// smeared.
+constexpr size_t temporalFilterFrameCount = 0;
+constexpr size_t temporalFilterMinValidCount = 2;
+constexpr float temporalFilterMaxDeviationMm = 20.0F;
+
+// Direct backend: process the frames on an OpenCL device, e.g. the GPU of a Jetson, instead of the worker threads.
+// Requires pipelined processing and building with NION_POINT_CLOUD_OPENCL, and does not support the temporal filter.
+// The device is selected by the index of the platform and of the device within the platform.
+constexpr bool openClProcessingEnabled = false;
+constexpr size_t openClPlatformIndex = 0;
+constexpr size_t openClDeviceIndex = 0;
+
 // Number of images acquired in this sample
 constexpr size_t imageAcquisitionCount = 10;
 
+// Acquire frames until the program is stopped with Ctrl+C, instead of imageAcquisitionCount frames
+constexpr bool continuousStreamingEnabled = false;
+
+// Maximum time to wait for a frame. Every timeout is reported, and the acquisition keeps waiting unless it is stopped.
+constexpr uint64_t bufferWaitTimeoutMs = 1000;
+
+// Process only the newest frame: If further finished buffers wait behind a received buffer, it is stale and queued
+// again without processing. This keeps the results fresh and the latency bounded when the processing falls behind,
+// instead of working through a growing backlog. The skipped frames are reported in the buffer statistics.
+constexpr bool latestFrameWinsEnabled = false;
+
+// Number of buffers announced to the data stream. The data stream requires a minimum number of buffers, which is
+// used if this value is smaller. More buffers absorb jitter in the processing time instead of losing frames.
+constexpr size_t bufferCount = 0;
+
+// Alternatively, size the buffer pool to hold the frames of this time span at the current frame rate.
+// Set to 0 to only use bufferCount.
+constexpr double bufferPoolDurationMs = 200.0;
+
+// Process the frames in a multi-threaded pipeline instead of one after another in the acquisition loop.
+// Depth processing, intensity processing and point cloud generation of several frames then run concurrently
+// on a pool of worker threads, together with acquisition and file output.
+constexpr bool pipelinedProcessingEnabled = true;
+
+// Backend used to process the frames:
+// - Icv:    peak ICV functions, each processing step creates a new image
+// - Direct: processes the data in place from the buffer memory into preallocated images, so that no
+//           memory is allocated per frame and the buffer can be queued as soon as its data is consumed
+constexpr nion::ProcessingBackend processingBackend = nion::ProcessingBackend::Icv;
+
+// Results written for every frame:
+// - Full:       depth map, intensity image and point cloud
+// - DepthMap:   only the depth map
+// - PointCloud: only the point cloud. The Direct backend skips the intensity image, so all points have intensity 0.
+// - Intensity:  only the intensity image
+// Processing steps that are not required are skipped, and if the device supports it, the unused multipart component
+// is not transmitted at all.
+constexpr nion::OutputProfile outputProfile = nion::OutputProfile::Full;
+
+// Direct backend: copy the raw depth map and intensity image of every buffer into preallocated memory and queue the
+// buffer right away, before the frame is processed. This keeps the data stream supplied with buffers even with the
+// minimum buffer count, at the cost of one copy per frame.
+constexpr bool rawFrameCopyEnabled = false;
+
+// Number of threads shared by the pipelines of all cameras, which process the frames of the cameras in turn.
+// 0 uses one thread per CPU core.
+constexpr size_t workerThreadCount = 0;
+
+// Maximum number of frames processed by the pipeline of a camera at the same time.
+// If the pipeline is full, new frames are dropped instead of blocking the acquisition.
+constexpr size_t pipelineMaxFramesInFlight = 4;
+
+// Adapt the load to the host at runtime, see ThroughputController in throughput_controller.hpp. Every
+// throughputControlPeriodFrames frames, frames lost by the data stream add buffers up to throughputMaxBufferCount.
+// Frames dropped by a full pipeline, many frames in flight or an end-to-end latency above throughputLatencyBudgetMs
+// first activate more workers, then process only every n-th frame up to throughputMaxDecimation, as long as all
+// cameras together still process throughputMinFrameRate frames per second, and finally double the binning up to
+// throughputMaxBinning. With enough headroom, these steps are undone. Changing the buffer count or the binning
+// restarts the acquisition of the cameras. Requires pipelined processing and is not supported with merged point
+// clouds. Changing the binning is not supported with a work area, recordings, the shared memory ring or the sequence
+// file, whose image size is fixed, and requires a device that supports the binning. All cameras have to start with
+// the same binning in both directions.
+constexpr bool throughputControlEnabled = false;
+constexpr double throughputLatencyBudgetMs = 200.0;
+constexpr double throughputMinFrameRate = 0.0;
+constexpr size_t throughputControlPeriodFrames = 50;
+constexpr size_t throughputMaxDecimation = 4;
+constexpr size_t throughputMaxBufferCount = 64;
+constexpr uint32_t throughputMaxBinning = 1;
+
+// Number of threads writing the output files in the background
+constexpr size_t fileWriterThreadCount = 2;
+
+// Maximum number of frames (or files, see below) waiting to be written
+constexpr size_t fileWriterQueueCapacity = 8;
+
+// What happens when the write queue is full:
+// - Block:      wait for the writer, which eventually drops frames at the acquisition instead
+// - DropNewest: discard the files of the new frame
+// - DropOldest: discard the files of the oldest queued frame
+constexpr nion::WriteQueuePolicy fileWriterQueuePolicy = nion::WriteQueuePolicy::Block;
+
+// Write the files of a frame together on one thread. Otherwise, they are queued separately and written in parallel.
+constexpr bool fileWriterGroupByFrame = true;
+
+// CPUs and real-time priority of the acquisition threads (one per camera, the main thread with a single camera), the
+// worker threads and the file writer threads, see ThreadPlacement in thread_placement.hpp. Pinning them to separate
+// CPUs of the NUMA node of the network adapter keeps them from migrating between cores and sockets, which shows up as
+// jitter in the latencies. An empty CPU list leaves the threads to the operating system, and a priority of 0 keeps the
+// normal scheduling. Real-time priorities (1 to 99) require root or CAP_SYS_NICE on Linux.
+const std::vector<size_t> acquisitionThreadCpus{};
+constexpr int acquisitionThreadPriority = 0;
+const std::vector<size_t> workerThreadCpus{};
+constexpr int workerThreadPriority = 0;
+const std::vector<size_t> fileWriterThreadCpus{};
+constexpr int fileWriterThreadPriority = 0;
+
+// Allocate the stream buffers on the NUMA node of the threads that read them, the workers with pipelined processing
+// and the acquisition threads otherwise, if their CPUs are set. Otherwise, the buffers are allocated by the transport
+// layer. The images of the pipelines are always allocated on the NUMA node of the workers.
+constexpr bool numaLocalStreamBuffersEnabled = true;
+
+// File format of the point clouds. The ICV backend always uses the PointCloudWriter. The direct backend creates and
+// encodes its point clouds without peak ICV, so it does not support the PointCloudWriter, and only writes point
+// clouds once one of the other formats is selected here.
+// - PointCloudWriter: PLY written by the PointCloudWriter of peak ICV, the same files as without the direct backend
+// - BinaryPly:        float coordinates and intensity
+// - QuantizedPly:     int16 coordinates in multiples of pointCloudCoordinateStepMm and uint16 intensity, or uint8
+//                     intensity divided by pointCloudIntensityStep if pointCloudIntensityAs8Bit is set
+// - Xyzi:             raw interleaved floats after a small header, see XyziHeader in point_cloud_encoding.hpp
+constexpr nion::PointCloudFormat pointCloudFormat = nion::PointCloudFormat::PointCloudWriter;
+constexpr float pointCloudCoordinateStepMm = 1.0F;
+constexpr bool pointCloudIntensityAs8Bit = false;
+constexpr float pointCloudIntensityStep = 16.0F;
+
+// Send the point cloud of every frame over TCP to all clients connected to pointCloudStreamPort, directly from the
+// memory of the pipeline. Every frame starts with a PointCloudStreamHeader, see point_cloud_stream.hpp. Organized
+// point clouds are followed by a validity bitmask if pointCloudStreamValidityMask is set. Requires the direct backend
+// with pipelined processing.
+constexpr bool pointCloudStreamEnabled = false;
+constexpr uint16_t pointCloudStreamPort = 5600;
+constexpr bool pointCloudStreamValidityMask = true;
+
+// Publish the depth map, intensity image and point cloud of every frame into a ring of sharedMemoryRingSlotCount
+// slots in shared memory, which processes on the same host can read in place, see SharedMemoryRingReader in
+// shared_memory_ring.hpp. With several cameras, every camera has its own ring, named sharedMemoryRingName followed
+// by the serial number. Requires the direct backend with pipelined processing.
+constexpr bool sharedMemoryRingEnabled = false;
+constexpr const char* sharedMemoryRingName = "nion_point_cloud";
+constexpr size_t sharedMemoryRingSlotCount = 4;
+
+// Append the depth map, intensity image and point cloud of every frame to a single memory-mapped file
+// <sequenceFileName>_<serial number>.nionseq in the output folder, which any frame can be read from directly, see
+// SequenceReader in sequence_file.hpp. Disable frameFileOutputEnabled to write no other files for long sessions.
+// The index of the file holds sequenceMaxFrameCount frames, later frames are not archived and reported at the end.
+// Requires the direct backend with pipelined processing.
+constexpr bool sequenceFileEnabled = false;
+constexpr const char* sequenceFileName = "sequence";
+constexpr size_t sequenceMaxFrameCount = 100000;
+
+// Write the results of every frame into separate files, e.g. point_cloud_xyzi_<frame>.ply. Can be disabled if they are
+// only streamed, published into shared memory or written into a sequence file.
+constexpr bool frameFileOutputEnabled = true;
+
+// Direct backend: create organized point clouds with one point per pixel, in which all values of invalid pixels are
+// set to organizedPointCloudInvalidValue. Otherwise, the point clouds only contain the valid pixels.
+constexpr bool organizedPointCloudEnabled = false;
+constexpr float organizedPointCloudInvalidValue = std::numeric_limits<float>::quiet_NaN();
+
+// Direct backend: downsample the point clouds by averaging the points within every cube of this size in millimeters,
+// before they are written or merged. 0 keeps all points. Downsampled point clouds are always unorganized.
+constexpr float voxelGridLeafSizeMm = 0.0F;
+
+// Merge the point clouds of all cameras into one point cloud per time slot, written as point_cloud_xyzi_merged_<slot>.
+// Requires the direct backend with pipelined processing. Frames belong to the same slot if their device timestamps
+// differ by at most pointCloudMergeToleranceUs, so the device clocks have to be synchronized, e.g. by PTP. At most
+// pointCloudMergeMaxPendingFrames frames per camera wait for the other cameras, which has to be smaller than
+// pipelineMaxFramesInFlight. Older frames are not merged. Requires unorganized point clouds, see
+// organizedPointCloudEnabled.
+constexpr bool pointCloudMergeEnabled = false;
+constexpr double pointCloudMergeToleranceUs = 1000.0;
+constexpr size_t pointCloudMergeMaxPendingFrames = 2;
+
+// Pose of every camera in the coordinate system of the merged point clouds: row-major rotation matrix and translation
+// in millimeters, e.g. { "1234567890", { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 100, 0, 0 } } }.
+// Cameras that are not listed keep their own coordinate system.
+const std::vector<nion::CameraPose> cameraPoses{};
+
+// Measure the duration of every acquisition, processing and output step. The percentiles are printed every
+// latencyReportInterval frames (0 to disable) and at the end, where they are also written to a CSV file.
+constexpr bool latencyStatisticsEnabled = true;
+constexpr size_t latencyReportInterval = 5;
+
+// Record the raw buffers together with the calibration data into recordingFileName.nionrec in the output folder
+// (with the serial number appended if there are several cameras), so that the processing can be replayed and
+// benchmarked without a camera (see nion_point_cloud_benchmark). The buffers are written in the acquisition loop,
+// which slows it down.
+constexpr bool recordingEnabled = false;
+constexpr const char* recordingFileName = "recording";
+
+// Compress the raw images of the recording losslessly, on recordingCompressionThreadCount threads including the
+// acquisition loop. The compressed size depends on the scene, invalid pixels and smooth surfaces compress best.
+constexpr bool recordingCompressionEnabled = true;
+constexpr size_t recordingCompressionThreadCount = 4;
+
 // ---------------------------------------------------------------------------------------------------------------------
 // PEAK LIBRARY LIFECYCLE
 // ---------------------------------------------------------------------------------------------------------------------
@@ -76,123 +334,243 @@ struct DeviceInfo
     std::shared_ptr<peak::core::NodeMap> nodeMap{};
 };
 
-// Open the first connected IDS Nion device
-DeviceInfo OpenFirstConnectedDevice()
+// Open all connected IDS Nion devices, or the ones listed in deviceSerialNumbers
+std::vector<DeviceInfo> OpenConnectedDevices()
 {
     auto& deviceManager = peak::DeviceManager::Instance();
     deviceManager.Update();
 
-    auto devices = deviceManager.Devices();
-    const auto it = std::find_if(
-        devices.cbegin(), devices.cend(), [](const std::shared_ptr<peak::core::DeviceDescriptor>& dev) {
-            return dev->ModelName().find("NION") != std::string::npos && dev->IsOpenable();
-        });
+    auto isSelected = [](const std::shared_ptr<peak::core::DeviceDescriptor>& dev) {
+        if (dev->ModelName().find("NION") == std::string::npos || !dev->IsOpenable())
+        {
+            return false;
+        }
+
+        return deviceSerialNumbers.empty()
+            || std::find(deviceSerialNumbers.begin(), deviceSerialNumbers.end(), dev->SerialNumber())
+            != deviceSerialNumbers.end();
+    };
 
-    if (it == devices.end())
+    std::vector<DeviceInfo> deviceInfos;
+    for (const auto& descriptor : deviceManager.Devices())
     {
-        throw std::runtime_error("No IDS Nion device found.");
+        if (isSelected(descriptor))
+        {
+            const auto device = descriptor->OpenDevice(peak::core::DeviceAccessType::Control);
+            deviceInfos.push_back({ device, device->RemoteDevice()->NodeMaps().at(0) });
+        }
     }
 
-    const auto device = (*it)->OpenDevice(peak::core::DeviceAccessType::Control);
-    const auto nodeMap = device->RemoteDevice()->NodeMaps().at(0);
+    if (deviceInfos.empty())
+    {
+        throw std::runtime_error("No IDS Nion device found.");
+    }
+    if (!deviceSerialNumbers.empty() && deviceInfos.size() != deviceSerialNumbers.size())
+    {
+        throw std::runtime_error("Not all IDS Nion devices listed in deviceSerialNumbers were found.");
+    }
 
-    return { device, nodeMap };
+    return deviceInfos;
 }
 
-void DeviceResetToDefault(const std::shared_ptr<peak::core::NodeMap>& nodeMap)
+// Settings written to the device, see deviceStartupMode
+nion::DeviceConfiguration CreateDeviceConfiguration()
 {
-    nodeMap->FindNode<peak::core::nodes::EnumerationNode>("UserSetSelector")->SetCurrentEntry("Default");
-
-    const auto cmd = nodeMap->FindNode<peak::core::nodes::CommandNode>("UserSetLoad");
-    cmd->Execute();
-    cmd->WaitUntilDone();
-}
+    nion::DeviceConfiguration configuration;
 
-void DeviceSetConfidenceThreshold(const std::shared_ptr<peak::core::NodeMap>& nodeMap, int32_t threshold)
-{
     // Sets the gray value of all pixels in the Range component whose corresponding value in the Confidence
-    // component is below the set threshold to Scan3dInvalidDataValue.
-    nodeMap->FindNode<peak::core::nodes::IntegerNode>("Scan3dRangeConfidenceThreshold")->SetValue(threshold);
+    // component is below the set threshold to Scan3dInvalidDataValue. The threshold is always written, so a
+    // threshold stored in the user set of the device does not keep filtering when the filter is disabled.
+    configuration.SetInteger(
+        "Scan3dRangeConfidenceThreshold", filterDepthMapByConfidenceEnabled ? confidenceThreshold : 0);
+
+    configuration.SetFloat("ExposureTime", exposureTimeUs, exposureTimeToleranceUs);
+
+    return configuration;
 }
 
-void DeviceSetExposureTime(const std::shared_ptr<peak::core::NodeMap>& nodeMap)
+void DeviceConfigure(nion::NodeCache& nodes)
 {
-    nodeMap->FindNode<peak::core::nodes::FloatNode>("ExposureTime")->SetValue(exposureTimeUs);
+    const auto configuration = CreateDeviceConfiguration();
+    const auto numWritten = nion::ConfigureDevice(nodes, configuration, deviceStartupMode, customUserSet);
+
+    std::cout << "Device configured: " << numWritten << " of " << configuration.NumValues() << " values written."
+              << std::endl;
 }
 
-peak::icv::CalibrationParameters DeviceReadCalibrationParameters(const std::shared_ptr<peak::core::NodeMap>& nodeMap)
+// Read the factory calibration file, which is parsed with peak::icv::CalibrationParameters
+std::vector<uint8_t> DeviceReadCalibrationData(
+    const std::shared_ptr<peak::core::Device>& device, nion::NodeCache& nodes)
 {
-    const peak::core::file::FileAdapter adapter(nodeMap, "LensCalibrationData");
+    if (calibrationCacheEnabled)
+    {
+        auto calibration = nion::ReadCalibrationDataCached(
+            nodes.NodeMap(), device->SerialNumber(), nion::GetOutputFilePath());
+        std::cout << "Calibration data " << (calibration.isFromCache ? "loaded from cache." : "read from device.")
+                  << std::endl;
+        return std::move(calibration.data);
+    }
+
+    const peak::core::file::FileAdapter adapter(nodes.NodeMap(), "LensCalibrationData");
 
     if (adapter.Size() <= 0)
     {
         throw std::runtime_error("No factory calibration data available.");
     }
 
-    return peak::icv::CalibrationParameters(adapter.Read(adapter.Size()));
+    return adapter.Read(adapter.Size());
 }
 
-float DeviceGetDepthMinimumValidValue(const std::shared_ptr<peak::core::NodeMap>& nodeMap)
+float DeviceGetDepthMinimumValidValue(nion::NodeCache& nodes)
 {
-    return static_cast<float>(nodeMap->FindNode<peak::core::nodes::FloatNode>("Scan3dAxisMin")->Value());
+    return static_cast<float>(nodes.Find<peak::core::nodes::FloatNode>("Scan3dAxisMin")->Value());
 }
 
-float DeviceGetDepthMaximumValidValue(const std::shared_ptr<peak::core::NodeMap>& nodeMap)
+float DeviceGetDepthMaximumValidValue(nion::NodeCache& nodes)
 {
-    return static_cast<float>(nodeMap->FindNode<peak::core::nodes::FloatNode>("Scan3dAxisMax")->Value());
+    return static_cast<float>(nodes.Find<peak::core::nodes::FloatNode>("Scan3dAxisMax")->Value());
 }
 
 // Get the scale factor for converting depth values into metric units
-float DeviceGetDepthScaleFactor(const std::shared_ptr<peak::core::NodeMap>& nodeMap)
+float DeviceGetDepthScaleFactor(nion::NodeCache& nodes)
 {
-    return static_cast<float>(nodeMap->FindNode<peak::core::nodes::FloatNode>("Scan3dCoordinateScale")->Value());
+    return static_cast<float>(nodes.Find<peak::core::nodes::FloatNode>("Scan3dCoordinateScale")->Value());
 }
 
-// Create a metadata object containing binning and ROI information
-// The metadata is required for correct undistortion of images.
-peak::common::Metadata DeviceGetImageMetadata(const std::shared_ptr<peak::core::NodeMap>& nodeMap)
+// Read binning and ROI of the images
+nion::ImageGeometry DeviceGetImageGeometry(nion::NodeCache& nodes)
 {
-    peak::common::Metadata metadata;
-
-    metadata.SetValueByKey<peak::common::MetadataKey::BinningHorizontal>(
-        nodeMap->FindNode<peak::core::nodes::IntegerNode>("BinningHorizontal")->Value());
-    metadata.SetValueByKey<peak::common::MetadataKey::BinningVertical>(
-        nodeMap->FindNode<peak::core::nodes::IntegerNode>("BinningVertical")->Value());
+    auto readValue = [&](const std::string& name) {
+        return static_cast<uint32_t>(nodes.Find<peak::core::nodes::IntegerNode>(name)->Value());
+    };
 
-    peak::common::RectangleU roi{ static_cast<uint32_t>(
-                                      nodeMap->FindNode<peak::core::nodes::IntegerNode>("OffsetX")->Value()),
-        static_cast<uint32_t>(nodeMap->FindNode<peak::core::nodes::IntegerNode>("OffsetY")->Value()),
-        static_cast<uint32_t>(nodeMap->FindNode<peak::core::nodes::IntegerNode>("Width")->Value()),
-        static_cast<uint32_t>(nodeMap->FindNode<peak::core::nodes::IntegerNode>("Height")->Value()) };
+    nion::ImageGeometry geometry;
+    geometry.binningHorizontal = readValue("BinningHorizontal");
+    geometry.binningVertical = readValue("BinningVertical");
+    geometry.offsetX = readValue("OffsetX");
+    geometry.offsetY = readValue("OffsetY");
+    geometry.width = readValue("Width");
+    geometry.height = readValue("Height");
 
-    metadata.SetValueByKey<peak::common::MetadataKey::Roi>(roi);
-    return metadata;
+    return geometry;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 // ACQUISITION
 // ---------------------------------------------------------------------------------------------------------------------
 
-// Start image acquisition and prepare the data stream
-std::shared_ptr<peak::core::DataStream> DeviceStartAcquisition(
-    const std::shared_ptr<peak::core::Device>& device, const std::shared_ptr<peak::core::NodeMap>& nodeMap)
+// Set by Ctrl+C to stop the acquisition of all cameras
+std::atomic<bool> isStopRequested{ false };
+
+void RequestStop(int /* signal */)
 {
-    auto stream = device->DataStreams().front()->OpenDataStream();
+    isStopRequested = true;
+}
 
-    nodeMap->FindNode<peak::core::nodes::EnumerationNode>("AcquisitionMode")->SetCurrentEntry("Continuous");
+// Get the number of buffers to announce, based on the requested number, e.g. bufferCount, and bufferPoolDurationMs
+size_t DeviceGetBufferCount(
+    nion::NodeCache& nodes, const std::shared_ptr<peak::core::DataStream>& stream, size_t requestedCount)
+{
+    auto count = std::max(stream->NumBuffersAnnouncedMinRequired(), requestedCount);
 
-    const auto payloadSize = nodeMap->FindNode<peak::core::nodes::IntegerNode>("PayloadSize")->Value();
+    if (bufferPoolDurationMs > 0.0 && nodes.Has("AcquisitionFrameRate"))
+    {
+        const auto frameRate = nodes.Find<peak::core::nodes::FloatNode>("AcquisitionFrameRate")->Value();
+        count = std::max(count, static_cast<size_t>(std::ceil(bufferPoolDurationMs * frameRate / 1000.0)));
+    }
 
-    for (size_t i = 0; i < stream->NumBuffersAnnouncedMinRequired(); ++i)
+    return count;
+}
+
+// Transmit only the multipart components that are used, which saves link bandwidth. Devices without component
+// selection always send all components.
+void DeviceEnableComponents(nion::NodeCache& nodes, bool isRangeEnabled, bool isIntensityEnabled)
+{
+    if (!nodes.Has("ComponentSelector") || !nodes.Has("ComponentEnable"))
     {
-        stream->QueueBuffer(stream->AllocAndAnnounceBuffer(payloadSize, nullptr));
+        std::cout << "Component selection not supported. All components are transmitted." << std::endl;
+        return;
     }
 
-    nodeMap->FindNode<peak::core::nodes::IntegerNode>("TLParamsLocked")->SetValue(1);
+    const auto selector = nodes.Find<peak::core::nodes::EnumerationNode>("ComponentSelector");
+    const auto enable = nodes.Find<peak::core::nodes::BooleanNode>("ComponentEnable");
+    const auto entries = selector->AvailableEntries();
+
+    auto setComponent = [&](const std::string& component, bool isEnabled) {
+        const auto hasEntry = std::any_of(entries.begin(), entries.end(), [&](const auto& entry) {
+            return entry->SymbolicValue() == component;
+        });
+
+        if (!hasEntry)
+        {
+            return;
+        }
+
+        selector->SetCurrentEntry(component);
+        if (enable->Value() != isEnabled)
+        {
+            enable->SetValue(isEnabled);
+        }
+    };
+
+    setComponent("Range", isRangeEnabled);
+    setComponent("Intensity", isIntensityEnabled);
+}
+
+// Announce and queue the buffers of the data stream. With CPUs in the placement, the buffer memory is allocated and
+// initialized by a thread on these CPUs, which puts it on their NUMA node. The data stream releases the memory when the
+// buffer is revoked. Otherwise, the transport layer allocates the buffers.
+void AnnounceBuffers(peak::core::DataStream& stream, size_t payloadSize, size_t numBuffers,
+    const nion::ThreadPlacement& placement)
+{
+    if (placement.cpus.empty())
+    {
+        for (size_t i = 0; i < numBuffers; ++i)
+        {
+            stream.QueueBuffer(stream.AllocAndAnnounceBuffer(payloadSize, nullptr));
+        }
+        return;
+    }
+
+    // The allocating thread only needs the CPUs, not the priority
+    std::vector<std::unique_ptr<uint8_t[]>> memory(numBuffers);
+    nion::RunPlaced(nion::ThreadPlacement{ placement.cpus, 0 }, [&] {
+        for (auto& bufferMemory : memory)
+        {
+            bufferMemory.reset(new uint8_t[payloadSize]());
+        }
+    });
+
+    for (auto& bufferMemory : memory)
+    {
+        auto buffer = stream.AnnounceBuffer(bufferMemory.get(), payloadSize, nullptr, [](void* data, void*) {
+            delete[] static_cast<uint8_t*>(data);
+        });
+        bufferMemory.release();
+
+        stream.QueueBuffer(buffer);
+    }
+}
+
+// Start image acquisition and prepare the data stream with at least the requested number of buffers. The buffers are
+// allocated on the NUMA node of the CPUs of the placement, see AnnounceBuffers().
+std::shared_ptr<peak::core::DataStream> DeviceStartAcquisition(const std::shared_ptr<peak::core::Device>& device,
+    nion::NodeCache& nodes, const nion::ThreadPlacement& bufferPlacement, size_t requestedBufferCount)
+{
+    auto stream = device->DataStreams().front()->OpenDataStream();
+
+    nodes.Find<peak::core::nodes::EnumerationNode>("AcquisitionMode")->SetCurrentEntry("Continuous");
+
+    const auto payloadSize = nodes.Find<peak::core::nodes::IntegerNode>("PayloadSize")->Value();
+    const auto numBuffers = DeviceGetBufferCount(nodes, stream, requestedBufferCount);
+
+    AnnounceBuffers(*stream, static_cast<size_t>(payloadSize), numBuffers, bufferPlacement);
+
+    nodes.Find<peak::core::nodes::IntegerNode>("TLParamsLocked")->SetValue(1);
 
     stream->StartAcquisition();
 
-    const auto cmd = nodeMap->FindNode<peak::core::nodes::CommandNode>("AcquisitionStart");
+    const auto cmd = nodes.Find<peak::core::nodes::CommandNode>("AcquisitionStart");
     cmd->Execute();
     cmd->WaitUntilDone();
 
@@ -206,9 +584,12 @@ struct MultipartBuffer
     std::shared_ptr<peak::core::BufferPart> intensity{};
 };
 
-// Extract depth and intensity images from a multipart buffer
-MultipartBuffer ExtractBufferParts(const std::shared_ptr<peak::core::Buffer>& buffer)
+// Extract depth and intensity images from a multipart buffer. Parts that are not required are null.
+MultipartBuffer ExtractBufferParts(
+    const std::shared_ptr<peak::core::Buffer>& buffer, bool isDepthMapRequired, bool isIntensityRequired)
 {
+    const nion::ScopedLatency latency(nion::LatencyStage::ExtractBufferParts);
+
     const auto& parts = buffer->Parts();
 
     auto getPart = [&](peak::core::BufferPartType type) {
@@ -224,19 +605,29 @@ MultipartBuffer ExtractBufferParts(const std::shared_ptr<peak::core::Buffer>& bu
         return *it;
     };
 
-    return { getPart(peak::core::BufferPartType::Image3D), getPart(peak::core::BufferPartType::Image2D) };
+    MultipartBuffer multipartBuffer;
+    if (isDepthMapRequired)
+    {
+        multipartBuffer.depthMap = getPart(peak::core::BufferPartType::Image3D);
+    }
+
+    if (isIntensityRequired)
+    {
+        multipartBuffer.intensity = getPart(peak::core::BufferPartType::Image2D);
+    }
+
+    return multipartBuffer;
 }
 
 // Stop acquisition and release buffers
-void DeviceStopAcquisition(
-    const std::shared_ptr<peak::core::NodeMap>& nodeMap, const std::shared_ptr<peak::core::DataStream>& stream)
+void DeviceStopAcquisition(nion::NodeCache& nodes, const std::shared_ptr<peak::core::DataStream>& stream)
 {
-    const auto cmd = nodeMap->FindNode<peak::core::nodes::CommandNode>("AcquisitionStop");
+    const auto cmd = nodes.Find<peak::core::nodes::CommandNode>("AcquisitionStop");
     cmd->Execute();
     cmd->WaitUntilDone();
 
     stream->StopAcquisition();
-    nodeMap->FindNode<peak::core::nodes::IntegerNode>("TLParamsLocked")->SetValue(0);
+    nodes.Find<peak::core::nodes::IntegerNode>("TLParamsLocked")->SetValue(0);
 
     stream->Flush(peak::core::DataStreamFlushMode::DiscardAll);
 
@@ -247,52 +638,617 @@ void DeviceStopAcquisition(
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// FILE OUTPUT
+// CAMERAS
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Everything required to acquire and process the frames of one camera
+struct Camera
+{
+    std::shared_ptr<peak::core::Device> device{};
+    std::unique_ptr<nion::NodeCache> nodes{};
+
+    // Serial number, used in the file names and messages if there are several cameras. Empty otherwise.
+    std::string name{};
+    std::string messagePrefix{};
+
+    std::unique_ptr<peak::icv::CalibrationParameters> calibration{};
+    nion::ProcessingParameters parameters{};
+    nion::OutputStages stages{};
+    std::unique_ptr<nion::RecordingWriter> recordingWriter{};
+
+    std::shared_ptr<peak::core::DataStream> stream{};
+    std::unique_ptr<nion::BufferHandlePool> bufferHandles{};
+    std::unique_ptr<nion::BufferMonitor> bufferMonitor{};
+    nion::DeviceTimestampMonitor timestampMonitor{};
+
+    // Throughput control: knobs applied to the camera, and the lost frames already reported to the controller
+    nion::ThroughputKnobs appliedKnobs{};
+    uint64_t numReportedLostFrames{};
+
+    // Pipelined processing. Frames dropped by pipelines replaced after a change of the binning are kept separately.
+    std::unique_ptr<nion::Pipeline> pipeline{};
+    size_t numPreviouslyDroppedFrames{};
+    std::unique_ptr<nion::SharedMemoryRing> sharedMemoryRing{};
+    std::unique_ptr<nion::SequenceWriter> sequenceWriter{};
+
+    // Processing in the acquisition loop. Every frame that is queued or being written holds a workspace
+    // of the direct backend, and one more is required to process the next frame.
+    std::unique_ptr<peak::icv::Undistortion> undistortion{};
+    std::unique_ptr<nion::DirectProcessor> directProcessor{};
+    std::unique_ptr<nion::WorkspacePool> workspacePool{};
+    std::unique_ptr<nion::RawFrameArena> rawFrameArena{};
+};
+
+// Configure the device and read everything required to process its frames
+void SetUpCamera(Camera& camera, const DeviceInfo& deviceInfo, bool hasSeveralCameras)
+{
+    camera.device = deviceInfo.device;
+
+    // All nodes are looked up once and reused
+    camera.nodes = std::make_unique<nion::NodeCache>(deviceInfo.nodeMap);
+    auto& nodes = *camera.nodes;
+
+    if (hasSeveralCameras)
+    {
+        camera.name = camera.device->SerialNumber();
+        camera.messagePrefix = "Camera " + camera.name + ": ";
+    }
+
+    DeviceConfigure(nodes);
+
+    const auto calibrationData = DeviceReadCalibrationData(camera.device, nodes);
+    camera.calibration = std::make_unique<peak::icv::CalibrationParameters>(calibrationData);
+
+    auto& parameters = camera.parameters;
+    parameters.scaleFactor = DeviceGetDepthScaleFactor(nodes);
+    parameters.validDepthInterval = { DeviceGetDepthMinimumValidValue(nodes), DeviceGetDepthMaximumValidValue(nodes) };
+    parameters.filterDistanceEnabled = filterDistanceEnabled;
+    parameters.filterDistanceIntervalMm = filterDistanceIntervalMm;
+    parameters.geometry = DeviceGetImageGeometry(nodes);
+    parameters.metadata = nion::CreateImageMetadata(parameters.geometry);
+    parameters.backend = processingBackend;
+    parameters.outputProfile = outputProfile;
+    parameters.organizedPointCloud = organizedPointCloudEnabled;
+    parameters.invalidPointValue = organizedPointCloudInvalidValue;
+    parameters.voxelLeafSizeMm = voxelGridLeafSizeMm;
+    parameters.copyRawFrames = rawFrameCopyEnabled;
+    parameters.temporalFilter.frameCount = temporalFilterFrameCount;
+    parameters.temporalFilter.minValidCount = temporalFilterMinValidCount;
+    parameters.temporalFilter.maxDeviationMm = temporalFilterMaxDeviationMm;
+    parameters.writeFrameFiles = frameFileOutputEnabled;
+    parameters.workArea = workArea;
+    parameters.openCl.enabled = openClProcessingEnabled;
+    parameters.openCl.platformIndex = openClPlatformIndex;
+    parameters.openCl.deviceIndex = openClDeviceIndex;
+
+    // Recordings always contain both images
+    camera.stages = nion::GetOutputStages(parameters);
+    DeviceEnableComponents(nodes, camera.stages.processDepthMap || recordingEnabled,
+        camera.stages.processIntensity || recordingEnabled);
+
+    if (recordingEnabled)
+    {
+        nion::RecordingInfo recordingInfo;
+        recordingInfo.calibrationData = calibrationData;
+        recordingInfo.scaleFactor = parameters.scaleFactor;
+        recordingInfo.validDepthMin = parameters.validDepthInterval.minimum;
+        recordingInfo.validDepthMax = parameters.validDepthInterval.maximum;
+        recordingInfo.geometry = parameters.geometry;
+        recordingInfo.isCompressed = recordingCompressionEnabled;
+
+        nion::PlaneCompressionSettings compressionSettings;
+        compressionSettings.numThreads = recordingCompressionThreadCount;
+
+        const auto recordingFilePath = nion::GetOutputFilePath() + recordingFileName
+            + (camera.name.empty() ? "" : "_" + camera.name) + ".nionrec";
+        camera.recordingWriter = std::make_unique<nion::RecordingWriter>(
+            recordingFilePath, recordingInfo, compressionSettings);
+    }
+
+    if (!pipelinedProcessingEnabled)
+    {
+        // Undistortion object initialized with factory calibration data
+        camera.undistortion = std::make_unique<peak::icv::Undistortion>(*camera.calibration);
+
+        if (processingBackend == nion::ProcessingBackend::Direct)
+        {
+            camera.directProcessor = std::make_unique<nion::DirectProcessor>(*camera.calibration, parameters);
+            camera.workspacePool = std::make_unique<nion::WorkspacePool>(
+                fileWriterQueueCapacity + fileWriterThreadCount + 1, parameters.geometry.width,
+                parameters.geometry.height);
+
+            // Frames are processed one after another, so a single copy is enough
+            if (rawFrameCopyEnabled)
+            {
+                camera.rawFrameArena = std::make_unique<nion::RawFrameArena>(
+                    1, parameters.geometry.width, parameters.geometry.height);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// THROUGHPUT CONTROL
 // ---------------------------------------------------------------------------------------------------------------------
 
-// Get platform-dependent output directory
-std::string GetOutputFilePath()
+// Everything the acquisition threads need to apply the knobs of the throughput controller
+struct ThroughputControl
+{
+    nion::ThroughputController& controller;
+    nion::WorkerPool& workerPool;
+    nion::PointCloudStream* pointCloudStream{};
+};
+
+// CPUs whose NUMA node holds the buffers of the data streams, see numaLocalStreamBuffersEnabled
+nion::ThreadPlacement GetBufferPlacement()
+{
+    nion::ThreadPlacement placement;
+    if (numaLocalStreamBuffersEnabled)
+    {
+        placement.cpus = pipelinedProcessingEnabled ? workerThreadCpus : acquisitionThreadCpus;
+    }
+
+    return placement;
+}
+
+// Report the end-to-end latency of every frame of the pipeline to the controller
+void ConnectThroughputController(nion::Pipeline& pipeline, nion::ThroughputController& controller)
+{
+    pipeline.SetFrameLatencyCallback([&controller](std::chrono::steady_clock::duration latency) {
+        controller.OnFrameFinished(latency);
+    });
+}
+
+// Create the pipeline of the camera. The controller may be null.
+std::unique_ptr<nion::Pipeline> CreatePipeline(Camera& camera, nion::WorkerPool& workerPool,
+    nion::FileWriter& fileWriter, const nion::PointCloudFormatSettings& pointCloudFormatSettings,
+    nion::PointCloudStream* pointCloudStream, nion::ThroughputController* controller)
 {
-#ifdef __linux__
-    return "/tmp/";
-#elif _WIN32
-    return "C:/Users/Public/Pictures/";
-#else
-#    error Platform not supported
-#endif
+    auto pipeline = std::make_unique<nion::Pipeline>(*camera.calibration, camera.parameters,
+        pipelineMaxFramesInFlight, workerPool, fileWriter, pointCloudFormatSettings, camera.name);
+
+    if (pointCloudStream)
+    {
+        pipeline->SetPointCloudStream(*pointCloudStream);
+    }
+    if (controller)
+    {
+        ConnectThroughputController(*pipeline, *controller);
+    }
+
+    return pipeline;
 }
 
-void WriteDepthMapToFile(const peak::icv::Image& depthMap, size_t i)
+// Start the data stream of the camera with the number of buffers, and the buffer pool and statistics belonging to it
+void StartStream(Camera& camera, size_t numBuffers)
 {
-    const peak::icv::ImageWriter imageWriter;
+    camera.stream = DeviceStartAcquisition(camera.device, *camera.nodes, GetBufferPlacement(), numBuffers);
+    camera.bufferHandles = std::make_unique<nion::BufferHandlePool>(
+        camera.stream, camera.stream->AnnouncedBuffers().size());
+    camera.bufferMonitor = std::make_unique<nion::BufferMonitor>(camera.stream,
+        static_cast<size_t>(camera.nodes->Find<peak::core::nodes::IntegerNode>("PayloadSize")->Value()));
+}
+
+// Restart the acquisition of the camera with the number of buffers and the binning of the knobs. All frames in flight
+// are finished first. If the binning changes the image geometry, the pipeline is replaced, as its undistortion and
+// images depend on it.
+void RestartAcquisition(Camera& camera, const nion::ThroughputKnobs& knobs, nion::FileWriter& fileWriter,
+    const nion::PointCloudFormatSettings& pointCloudFormatSettings, const ThroughputControl& throughputControl)
+{
+    const auto& prefix = camera.messagePrefix;
+    auto& nodes = *camera.nodes;
+
+    camera.pipeline->Finish();
+    DeviceStopAcquisition(nodes, camera.stream);
+
+    // The statistics belong to the data stream and start over with the new one
+    std::cout << prefix << "Before restarting the acquisition: ";
+    nion::PrintBufferStatistics(camera.bufferMonitor->Statistics());
+    camera.bufferMonitor.reset();
+    camera.bufferHandles.reset();
+    camera.stream.reset();
+
+    if (knobs.binning != camera.appliedKnobs.binning)
+    {
+        nodes.Find<peak::core::nodes::IntegerNode>("BinningHorizontal")->SetValue(knobs.binning);
+        nodes.Find<peak::core::nodes::IntegerNode>("BinningVertical")->SetValue(knobs.binning);
+    }
+
+    const auto geometry = DeviceGetImageGeometry(nodes);
+    if (geometry != camera.parameters.geometry)
+    {
+        camera.parameters.geometry = geometry;
+        camera.parameters.metadata = nion::CreateImageMetadata(geometry);
+
+        camera.numPreviouslyDroppedFrames += camera.pipeline->NumDroppedFrames();
+        camera.pipeline.reset();
+        camera.pipeline = CreatePipeline(camera, throughputControl.workerPool, fileWriter, pointCloudFormatSettings,
+            throughputControl.pointCloudStream, &throughputControl.controller);
+    }
+
+    StartStream(camera, knobs.numBuffers);
+    camera.numReportedLostFrames = 0;
+
+    std::cout << prefix << "Restarted the acquisition with " << camera.stream->AnnouncedBuffers().size()
+              << " buffers and " << geometry.width << "x" << geometry.height << " pixels." << std::endl;
+}
+
+// Apply the knobs of the controller that differ from the ones of the camera. Changing the number of workers affects
+// all cameras and takes effect right away, the decimation is applied by the acquisition loop.
+void ApplyThroughputKnobs(Camera& camera, nion::FileWriter& fileWriter,
+    const nion::PointCloudFormatSettings& pointCloudFormatSettings, const ThroughputControl& throughputControl)
+{
+    const auto knobs = throughputControl.controller.Knobs();
+
+    if (knobs.numWorkers != camera.appliedKnobs.numWorkers)
+    {
+        throughputControl.workerPool.SetNumActiveThreads(knobs.numWorkers);
+    }
+    if (knobs.numBuffers != camera.appliedKnobs.numBuffers || knobs.binning != camera.appliedKnobs.binning)
+    {
+        RestartAcquisition(camera, knobs, fileWriter, pointCloudFormatSettings, throughputControl);
+    }
+
+    camera.appliedKnobs = knobs;
+}
+
+// Wait for the next finished buffer of the camera and report every timeout. Returns nullptr if the acquisition is
+// stopped first. With latestFrameWinsEnabled, stale buffers are queued again until the newest one is reached.
+std::shared_ptr<peak::core::Buffer> WaitForNextBuffer(Camera& camera)
+{
+    auto& stream = camera.stream;
+
+    std::shared_ptr<peak::core::Buffer> buffer;
+    while (!buffer)
+    {
+        if (isStopRequested)
+        {
+            return nullptr;
+        }
+
+        try
+        {
+            buffer = stream->WaitForFinishedBuffer(bufferWaitTimeoutMs);
+        }
+        catch (const peak::core::TimeoutException&)
+        {
+            camera.bufferMonitor->OnWaitTimeout();
+            std::cout << camera.messagePrefix << "No frame received within " << bufferWaitTimeoutMs << " ms."
+                      << std::endl;
+        }
+    }
+
+    // The buffers are delivered in the order they were filled, so the last waiting one is the newest
+    while (latestFrameWinsEnabled && stream->NumBuffersAwaitDelivery() > 0)
+    {
+        camera.timestampMonitor.OnFrameReceived(buffer->Timestamp_ns(), std::chrono::steady_clock::now());
+        camera.bufferMonitor->OnBufferReceived(*buffer);
+        camera.bufferMonitor->OnStaleBuffer();
+
+        stream->QueueBuffer(buffer);
+        buffer = stream->WaitForFinishedBuffer(0);
+    }
+
+    return buffer;
+}
+
+// Acquire and process imageAcquisitionCount frames of the camera, or frames until the acquisition is stopped with
+// continuousStreamingEnabled. With several cameras, this runs on one thread per camera, and only the first camera
+// prints the latency statistics in between. The throughput control may be null.
+void AcquireFrames(Camera& camera, nion::FileWriter& fileWriter,
+    const nion::PointCloudFormatSettings& pointCloudFormatSettings, bool isReportingLatencies,
+    const ThroughputControl* throughputControl)
+{
+    nion::PlaceCurrentThread({ acquisitionThreadCpus, acquisitionThreadPriority });
+
+    auto& latencyStatistics = nion::LatencyStatistics::Instance();
+    const auto& prefix = camera.messagePrefix;
+    const auto& stages = camera.stages;
+
+    for (size_t i = 0; continuousStreamingEnabled || i < imageAcquisitionCount; ++i)
+    {
+        if (isReportingLatencies && latencyStatisticsEnabled && latencyReportInterval > 0 && i > 0
+            && i % latencyReportInterval == 0)
+        {
+            latencyStatistics.Print(std::cout);
+        }
+
+        if (throughputControl)
+        {
+            ApplyThroughputKnobs(camera, fileWriter, pointCloudFormatSettings, *throughputControl);
+        }
+
+        nion::ScopedLatency waitLatency(nion::LatencyStage::WaitForBuffer);
+        auto buffer = WaitForNextBuffer(camera);
+        waitLatency.Stop();
+
+        if (!buffer)
+        {
+            break;
+        }
+
+        const auto receiveTime = std::chrono::steady_clock::now();
+        camera.timestampMonitor.OnFrameReceived(buffer->Timestamp_ns(), receiveTime);
+        camera.bufferMonitor->OnBufferReceived(*buffer);
+
+        // Queues the buffer again once the last copy is released, also when the frame is skipped or fails
+        auto bufferHandle = camera.bufferHandles->Acquire(buffer);
+
+        if (buffer->IsIncomplete())
+        {
+            std::cout << prefix << "Incomplete buffer " << i << ". Skipping." << std::endl;
+            continue;
+        }
+        if (!buffer->HasNewData())
+        {
+            std::cout << prefix << "Buffer " << i << " has no new data. Skipping." << std::endl;
+            continue;
+        }
+
+        if (!buffer->HasParts())
+        {
+            throw std::runtime_error("Buffer has no parts. Aborting.");
+        }
+
+        auto parts = ExtractBufferParts(buffer, stages.processDepthMap || camera.recordingWriter,
+            stages.processIntensity || camera.recordingWriter);
+
+        if (camera.recordingWriter)
+        {
+            camera.recordingWriter->WriteFrame(buffer->FrameID(), buffer->Timestamp_ns(),
+                nion::ViewRawDepthMap(*parts.depthMap), nion::ViewRawIntensity(*parts.intensity));
+        }
 
-    // When written to file the set region is ignored and
-    // all pixels are displayed if you want to change this
-    // you have to paint the unused pixels with the Painter class
-    const auto undistortedDepthMapFilePath = GetOutputFilePath() + "undistorted_depth_map_" + std::to_string(i)
-        + ".tiff";
-    imageWriter.Write(undistortedDepthMapFilePath, depthMap);
-    std::cout << "Undistorted depth map written to: " << undistortedDepthMapFilePath << std::endl;
+        // Frames skipped by the decimation are still recorded
+        const auto isProcessed = !throughputControl || throughputControl->controller.ShouldProcess(i);
+
+        if (camera.pipeline)
+        {
+            // The pipeline releases the buffer once its processing steps no longer need the data
+            auto isDropped = false;
+            if (isProcessed
+                && !camera.pipeline->Submit(i, buffer->Timestamp_ns(), receiveTime, std::move(bufferHandle),
+                    parts.depthMap, parts.intensity))
+            {
+                std::cout << prefix << "Pipeline is busy. Dropping buffer " << i << "." << std::endl;
+                isDropped = true;
+            }
+
+            if (throughputControl)
+            {
+                const auto occupancy = static_cast<double>(camera.pipeline->NumFramesInFlight())
+                    / static_cast<double>(pipelineMaxFramesInFlight);
+                // A frame the device could not deliver for lack of an empty buffer (underrun) leaves a gap in the
+                // frame IDs as well, so only the gaps are counted. Adding the underruns would count such frames twice.
+                const auto numLostFrames = camera.bufferMonitor->Statistics().numLostFrames;
+
+                if (throughputControl->controller.OnFrameReceived(receiveTime, isProcessed, isDropped, occupancy,
+                        numLostFrames - camera.numReportedLostFrames))
+                {
+                    const auto knobs = throughputControl->controller.Knobs();
+                    std::cout << "Throughput control: " << knobs.numWorkers << " workers, every " << knobs.decimation
+                              << ". frame, " << knobs.numBuffers << " buffers, binning " << knobs.binning << "."
+                              << std::endl;
+                }
+                camera.numReportedLostFrames = numLostFrames;
+            }
+            continue;
+        }
+
+        const auto fileSuffix = nion::FrameFileSuffix(camera.name, i);
+
+        if (camera.directProcessor)
+        {
+            auto& directProcessor = *camera.directProcessor;
+            auto* workspacePool = camera.workspacePool.get();
+            auto* workspace = workspacePool->Acquire();
+
+            // Read the raw images in place from the buffer memory, or from a copy if enabled, in which case the
+            // buffer can be reused before the frame is processed
+            nion::PlaneView<const uint16_t> rawDepth;
+            nion::PlaneView<const uint16_t> rawIntensity;
+            if (stages.processDepthMap)
+            {
+                rawDepth = nion::ViewRawDepthMap(*parts.depthMap);
+            }
+            if (stages.processIntensity)
+            {
+                rawIntensity = nion::ViewRawIntensity(*parts.intensity);
+            }
+
+            auto* rawFrame = camera.rawFrameArena ? camera.rawFrameArena->TryCopy(rawDepth, rawIntensity) : nullptr;
+            if (rawFrame)
+            {
+                rawDepth = rawDepth.data ? nion::AsConst(rawFrame->depth) : rawDepth;
+                rawIntensity = rawIntensity.data ? nion::AsConst(rawFrame->intensity) : rawIntensity;
+                bufferHandle.Reset();
+            }
+
+            if (stages.processDepthMap)
+            {
+                directProcessor.ProcessDepthMap(rawDepth, *workspace);
+            }
+            if (stages.processIntensity)
+            {
+                directProcessor.UndistortIntensity(rawIntensity, *workspace);
+            }
+
+            // The raw data has been consumed, so the buffer can already be reused
+            bufferHandle.Reset();
+            if (rawFrame)
+            {
+                camera.rawFrameArena->Release(rawFrame);
+            }
+
+            if (stages.createPointCloud)
+            {
+                directProcessor.CreatePointCloud(*workspace);
+                latencyStatistics.RecordSince(nion::LatencyStage::ReceiveToPointCloud, receiveTime);
+            }
+            if (stages.writeDepthMap)
+            {
+                directProcessor.ConvertDepthMap(*workspace);
+            }
+
+            // The workspace is returned to the pool once its files are written
+            auto job = nion::CreateFrameWriteJob(fileSuffix, *workspace, stages, pointCloudFormatSettings);
+            job.onFinished = [workspacePool, workspace, &latencyStatistics, receiveTime] {
+                latencyStatistics.RecordSince(nion::LatencyStage::ReceiveToFilesWritten, receiveTime);
+                workspacePool->Release(workspace);
+            };
+            fileWriter.Submit(std::move(job));
+            continue;
+        }
+
+        // -------------------------------------------------------------------------------------------------------------
+        // Depth map processing
+        // -------------------------------------------------------------------------------------------------------------
+
+        std::shared_ptr<const peak::icv::Image> undistortedDepth;
+        if (stages.processDepthMap)
+        {
+            undistortedDepth = std::make_shared<const peak::icv::Image>(
+                nion::ProcessDepthMap(*parts.depthMap, *camera.undistortion, camera.parameters));
+        }
+
+        // -------------------------------------------------------------------------------------------------------------
+        // Intensity image processing
+        // -------------------------------------------------------------------------------------------------------------
+
+        std::shared_ptr<const peak::icv::Image> undistortedIntensity;
+        if (stages.processIntensity)
+        {
+            undistortedIntensity = std::make_shared<const peak::icv::Image>(
+                nion::ProcessIntensity(*parts.intensity, *camera.undistortion, camera.parameters));
+        }
+
+        // Queue buffer that it can be reused. This can be done after the buffer data is no longer used.
+        bufferHandle.Reset();
+
+        // -------------------------------------------------------------------------------------------------------------
+        // Point cloud generation
+        // -------------------------------------------------------------------------------------------------------------
+
+        std::shared_ptr<const peak::icv::PointCloudXYZI> pointCloud;
+        if (stages.writePointCloud)
+        {
+            nion::ScopedLatency pointCloudLatency(nion::LatencyStage::PointCloudCreation);
+            pointCloud = std::make_shared<const peak::icv::PointCloudXYZI>(*undistortedDepth, *undistortedIntensity);
+            pointCloudLatency.Stop();
+            latencyStatistics.RecordSince(nion::LatencyStage::ReceiveToPointCloud, receiveTime);
+        }
+
+        // Images that were only required for the point cloud are not written
+        if (!stages.writeDepthMap)
+        {
+            undistortedDepth.reset();
+        }
+        if (!stages.writeIntensity)
+        {
+            undistortedIntensity.reset();
+        }
+
+        // -------------------------------------------------------------------------------------------------------------
+        // File output in the background
+        // -------------------------------------------------------------------------------------------------------------
+
+        auto job = nion::CreateFrameWriteJob(
+            fileSuffix, std::move(undistortedDepth), std::move(undistortedIntensity), std::move(pointCloud));
+        job.onFinished = [&latencyStatistics, receiveTime] {
+            latencyStatistics.RecordSince(nion::LatencyStage::ReceiveToFilesWritten, receiveTime);
+        };
+        fileWriter.Submit(std::move(job));
+    }
 }
 
-void WriteIntensityToFile(const peak::icv::Image& intensity, size_t i)
+// Merge the point clouds created by the pipelines of all cameras, see pointCloudMergeEnabled
+std::unique_ptr<nion::PointCloudMerger> CreatePointCloudMerger(std::vector<Camera>& cameras,
+    nion::WorkerPool& workerPool, nion::FileWriter& fileWriter,
+    const nion::PointCloudFormatSettings& pointCloudFormatSettings)
 {
-    const peak::icv::ImageWriter imageWriter;
+    if (processingBackend != nion::ProcessingBackend::Direct)
+    {
+        throw std::runtime_error("Merging point clouds requires the Direct backend.");
+    }
+    if (pointCloudMergeMaxPendingFrames >= pipelineMaxFramesInFlight)
+    {
+        throw std::runtime_error("pointCloudMergeMaxPendingFrames has to be smaller than pipelineMaxFramesInFlight.");
+    }
+
+    std::vector<nion::RigidTransform> cameraTransforms;
+    size_t maxNumPoints = 0;
+    for (const auto& camera : cameras)
+    {
+        const auto serialNumber = camera.device->SerialNumber();
+        const auto pose = std::find_if(cameraPoses.begin(), cameraPoses.end(), [&](const nion::CameraPose& p) {
+            return p.serialNumber == serialNumber;
+        });
+        cameraTransforms.push_back(pose != cameraPoses.end() ? pose->transform : nion::RigidTransform{});
+
+        const auto& geometry = camera.parameters.geometry;
+        maxNumPoints += static_cast<size_t>(geometry.width) * geometry.height;
+    }
+
+    nion::PointCloudMergerSettings settings;
+    settings.toleranceNs = static_cast<uint64_t>(pointCloudMergeToleranceUs * 1000.0);
+    settings.maxPendingFrames = pointCloudMergeMaxPendingFrames;
+
+    auto merger = std::make_unique<nion::PointCloudMerger>(std::move(cameraTransforms), maxNumPoints, settings,
+        workerPool, fileWriter, pointCloudFormatSettings);
 
-    const auto undistortedIntensityImageFilePath = GetOutputFilePath() + "undistorted_intensity_image_"
-        + std::to_string(i) + ".png";
-    imageWriter.Write(undistortedIntensityImageFilePath, intensity);
-    std::cout << "Undistorted intensity image written to: " << undistortedIntensityImageFilePath << std::endl;
+    for (size_t c = 0; c < cameras.size(); ++c)
+    {
+        auto* mergerPointer = merger.get();
+        cameras[c].pipeline->SetPointCloudCallback(
+            [mergerPointer, c](uint64_t timestampNs, const nion::PointCloud& pointCloud, std::function<void()> done) {
+                mergerPointer->Add(c, timestampNs, pointCloud, std::move(done));
+            });
+    }
+
+    return merger;
 }
 
-void WritePointCloudToFile(const peak::icv::PointCloudXYZI& pointCloud, size_t i)
+// Acquire the frames of all cameras at the same time, each on its own thread. An error of one camera stops all of them.
+void AcquireFramesOfAllCameras(std::vector<Camera>& cameras, nion::FileWriter& fileWriter,
+    const nion::PointCloudFormatSettings& pointCloudFormatSettings, const ThroughputControl* throughputControl)
 {
-    const peak::icv::PointCloudWriter pointCloudWriter;
+    if (cameras.size() == 1)
+    {
+        AcquireFrames(cameras.front(), fileWriter, pointCloudFormatSettings, true, throughputControl);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(cameras.size());
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < cameras.size(); ++c)
+    {
+        threads.emplace_back([&, c] {
+            try
+            {
+                AcquireFrames(cameras[c], fileWriter, pointCloudFormatSettings, c == 0, throughputControl);
+            }
+            catch (...)
+            {
+                // Stop the other cameras, which would otherwise acquire forever with continuousStreamingEnabled.
+                // They only wait for buffers for bufferWaitTimeoutMs at a time, so they notice it without a wakeup.
+                isStopRequested = true;
+                errors[c] = std::current_exception();
+            }
+        });
+    }
 
-    const auto pointCloudFilePath = GetOutputFilePath() + "point_cloud_xyzi_" + std::to_string(i) + ".ply";
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
 
-    pointCloudWriter.Write(pointCloudFilePath, pointCloud);
-    std::cout << "Point cloud written to: " << pointCloudFilePath << std::endl;
+    for (const auto& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
 }
 
 } // namespace
@@ -307,106 +1263,307 @@ int main()
     {
         InitializeLibraries();
 
-        auto deviceInfo = OpenFirstConnectedDevice();
-        auto nodeMap = deviceInfo.nodeMap;
-        auto device = deviceInfo.device;
+        const auto deviceInfos = OpenConnectedDevices();
+        std::cout << "Using " << deviceInfos.size() << " IDS Nion device(s)." << std::endl;
 
-        DeviceResetToDefault(nodeMap);
+        // Declared before the file writer and the worker pool, which use the cameras until they are destroyed
+        std::vector<Camera> cameras(deviceInfos.size());
+        for (size_t c = 0; c < cameras.size(); ++c)
+        {
+            SetUpCamera(cameras[c], deviceInfos[c], cameras.size() > 1);
+        }
 
-        if (filterDepthMapByConfidenceEnabled)
+        if (processingBackend == nion::ProcessingBackend::Direct)
         {
-            DeviceSetConfidenceThreshold(nodeMap, confidenceThreshold);
+            std::cout << "Depth conversion uses " << nion::DepthConversionInstructionSet() << " instructions."
+                      << std::endl;
         }
 
-        DeviceSetExposureTime(nodeMap);
+        nion::FileWriterSettings fileWriterSettings;
+        fileWriterSettings.numThreads = fileWriterThreadCount;
+        fileWriterSettings.queueCapacity = fileWriterQueueCapacity;
+        fileWriterSettings.policy = fileWriterQueuePolicy;
+        fileWriterSettings.groupByFrame = fileWriterGroupByFrame;
+        fileWriterSettings.placement = { fileWriterThreadCpus, fileWriterThreadPriority };
 
-        const auto calibration = DeviceReadCalibrationParameters(nodeMap);
-        const auto minimumValidValue = DeviceGetDepthMinimumValidValue(nodeMap);
-        const auto maximumValidValue = DeviceGetDepthMaximumValidValue(nodeMap);
-        const auto scaleFactor = DeviceGetDepthScaleFactor(nodeMap);
-        const auto metadata = DeviceGetImageMetadata(nodeMap);
+        nion::PointCloudFormatSettings pointCloudFormatSettings;
+        pointCloudFormatSettings.format = pointCloudFormat;
+        pointCloudFormatSettings.coordinateStepMm = pointCloudCoordinateStepMm;
+        pointCloudFormatSettings.intensityAs8Bit = pointCloudIntensityAs8Bit;
+        pointCloudFormatSettings.intensityStep = pointCloudIntensityStep;
 
-        // Undistortion object initialized with factory calibration data
-        peak::icv::Undistortion undistortion(calibration);
+        if (pointCloudMergeEnabled && !pipelinedProcessingEnabled)
+        {
+            throw std::runtime_error("Merging point clouds requires pipelined processing.");
+        }
+        if (pointCloudMergeEnabled && !nion::GetOutputStages(outputProfile, processingBackend).createPointCloud)
+        {
+            throw std::runtime_error("Merging point clouds requires an output profile with point clouds.");
+        }
+        // The invalid points of organized point clouds would be transformed into the merged point clouds as well
+        if (pointCloudMergeEnabled && organizedPointCloudEnabled && voxelGridLeafSizeMm <= 0.0F)
+        {
+            throw std::runtime_error("Merging point clouds requires unorganized point clouds.");
+        }
+        const auto writesPointCloudFiles = pointCloudMergeEnabled
+            || (frameFileOutputEnabled && nion::GetOutputStages(outputProfile, processingBackend).writePointCloud);
+        if (processingBackend == nion::ProcessingBackend::Direct && writesPointCloudFiles
+            && pointCloudFormat == nion::PointCloudFormat::PointCloudWriter)
+        {
+            throw std::runtime_error("The Direct backend does not write point clouds with the PointCloudWriter. Select "
+                                     "BinaryPly, QuantizedPly or Xyzi as pointCloudFormat.");
+        }
+        if (voxelGridLeafSizeMm > 0.0F && processingBackend != nion::ProcessingBackend::Direct)
+        {
+            throw std::runtime_error("Voxel grid downsampling requires the Direct backend.");
+        }
+        if (rawFrameCopyEnabled && processingBackend != nion::ProcessingBackend::Direct)
+        {
+            throw std::runtime_error("Copying raw frames requires the Direct backend.");
+        }
+        if (temporalFilterFrameCount > 1 && processingBackend != nion::ProcessingBackend::Direct)
+        {
+            throw std::runtime_error("Temporal filtering requires the Direct backend.");
+        }
+        if (!workArea.IsEmpty() && processingBackend != nion::ProcessingBackend::Direct)
+        {
+            throw std::runtime_error("A work area requires the Direct backend.");
+        }
+        if (openClProcessingEnabled
+            && (processingBackend != nion::ProcessingBackend::Direct || !pipelinedProcessingEnabled))
+        {
+            throw std::runtime_error("OpenCL processing requires the Direct backend with pipelined processing.");
+        }
+        if (openClProcessingEnabled && temporalFilterFrameCount > 1)
+        {
+            throw std::runtime_error("OpenCL processing does not support the temporal filter.");
+        }
+        if (pointCloudStreamEnabled
+            && (processingBackend != nion::ProcessingBackend::Direct || !pipelinedProcessingEnabled))
+        {
+            throw std::runtime_error("Streaming point clouds requires the Direct backend with pipelined processing.");
+        }
+        if (sharedMemoryRingEnabled
+            && (processingBackend != nion::ProcessingBackend::Direct || !pipelinedProcessingEnabled))
+        {
+            throw std::runtime_error("The shared memory ring requires the Direct backend with pipelined processing.");
+        }
+        if (sequenceFileEnabled
+            && (processingBackend != nion::ProcessingBackend::Direct || !pipelinedProcessingEnabled))
+        {
+            throw std::runtime_error("The sequence file requires the Direct backend with pipelined processing.");
+        }
+        if (throughputControlEnabled && (!pipelinedProcessingEnabled || pointCloudMergeEnabled))
+        {
+            throw std::runtime_error("Throughput control requires pipelined processing without merged point clouds.");
+        }
+        if (throughputControlEnabled && throughputMaxBinning > 1
+            && (!workArea.IsEmpty() || recordingEnabled || sharedMemoryRingEnabled || sequenceFileEnabled))
+        {
+            throw std::runtime_error("Changing the binning is not supported with a work area, recordings, the shared "
+                                     "memory ring or the sequence file.");
+        }
+
+        // Opened before the pipelines, so clients can connect while the acquisition starts
+        std::unique_ptr<nion::PointCloudStream> pointCloudStream;
+        if (pointCloudStreamEnabled)
+        {
+            nion::PointCloudStreamSettings streamSettings;
+            streamSettings.port = pointCloudStreamPort;
+            streamSettings.validityMask = pointCloudStreamValidityMask;
+            pointCloudStream = std::make_unique<nion::PointCloudStream>(streamSettings);
+            std::cout << "Streaming point clouds on port " << pointCloudStreamPort << "." << std::endl;
+        }
 
-        auto stream = DeviceStartAcquisition(device, nodeMap);
+        // Declared before the file writer, which returns the merged point clouds to the merger
+        std::unique_ptr<nion::PointCloudMerger> pointCloudMerger;
 
-        for (size_t i = 0; i < imageAcquisitionCount; ++i)
+        // Declared before the file writer and the worker pool, whose remaining tasks report the frames of the
+        // pipelines to the controller while they are destroyed
+        std::unique_ptr<nion::ThroughputController> throughputController;
+        std::unique_ptr<ThroughputControl> throughputControl;
+
+        // Shared by all cameras. The worker pool is destroyed first, as its tasks submit files to the writer.
+        nion::FileWriter fileWriter(fileWriterSettings);
+        std::unique_ptr<nion::WorkerPool> workerPool;
+        if (pipelinedProcessingEnabled)
         {
-            auto buffer = stream->WaitForFinishedBuffer(PEAK_INFINITE_TIMEOUT);
+            const auto numThreads = workerThreadCount > 0
+                ? workerThreadCount
+                : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            workerPool = std::make_unique<nion::WorkerPool>(
+                numThreads, nion::ThreadPlacement{ workerThreadCpus, workerThreadPriority });
 
-            if (buffer->IsIncomplete())
+            for (auto& camera : cameras)
             {
-                std::cout << "Incomplete buffer " << i << ". Skipping." << std::endl;
-                stream->QueueBuffer(buffer);
-                continue;
+                camera.pipeline = CreatePipeline(
+                    camera, *workerPool, fileWriter, pointCloudFormatSettings, pointCloudStream.get(), nullptr);
+
+                if (sharedMemoryRingEnabled)
+                {
+                    const auto ringName = sharedMemoryRingName + (camera.name.empty() ? "" : "_" + camera.name);
+                    const auto& geometry = camera.parameters.geometry;
+                    camera.sharedMemoryRing = std::make_unique<nion::SharedMemoryRing>(
+                        ringName, sharedMemoryRingSlotCount, geometry.width, geometry.height);
+                    camera.pipeline->SetSharedMemoryRing(*camera.sharedMemoryRing);
+                    std::cout << camera.messagePrefix << "Publishing into shared memory " << ringName << "."
+                              << std::endl;
+                }
+
+                if (sequenceFileEnabled)
+                {
+                    nion::SequenceSettings sequenceSettings;
+                    sequenceSettings.maxNumFrames = sequenceMaxFrameCount;
+
+                    const auto sequenceFilePath = nion::GetOutputFilePath() + sequenceFileName
+                        + (camera.name.empty() ? "" : "_" + camera.name) + ".nionseq";
+                    const auto& geometry = camera.parameters.geometry;
+                    camera.sequenceWriter = std::make_unique<nion::SequenceWriter>(
+                        sequenceFilePath, geometry.width, geometry.height, sequenceSettings);
+                    camera.pipeline->SetSequenceWriter(*camera.sequenceWriter);
+                }
             }
-            if (!buffer->HasNewData())
+
+            if (pointCloudMergeEnabled)
             {
-                std::cout << "Buffer " << i << " has no new data. Skipping." << std::endl;
-                stream->QueueBuffer(buffer);
-                continue;
+                pointCloudMerger = CreatePointCloudMerger(cameras, *workerPool, fileWriter, pointCloudFormatSettings);
             }
+        }
 
-            if (!buffer->HasParts())
+        auto& latencyStatistics = nion::LatencyStatistics::Instance();
+        latencyStatistics.SetEnabled(latencyStatisticsEnabled);
+
+        for (auto& camera : cameras)
+        {
+            StartStream(camera, bufferCount);
+        }
+
+        // Starts with all workers, the buffers announced to the cameras and their binning
+        if (throughputControlEnabled)
+        {
+            // The binning knob is applied to both directions of all cameras, so they have to start from the same one
+            const auto binning = cameras.front().parameters.geometry.binningHorizontal;
+            for (const auto& camera : cameras)
             {
-                throw std::runtime_error("Buffer has no parts. Aborting.");
+                const auto& geometry = camera.parameters.geometry;
+                if (throughputMaxBinning > 1
+                    && (geometry.binningHorizontal != binning || geometry.binningVertical != binning))
+                {
+                    throw std::runtime_error("Changing the binning requires the same horizontal and vertical binning "
+                                             "on all cameras.");
+                }
             }
 
-            auto parts = ExtractBufferParts(buffer);
+            nion::ThroughputKnobs knobs;
+            knobs.numWorkers = workerPool->NumThreads();
+            knobs.binning = binning;
+            for (const auto& camera : cameras)
+            {
+                knobs.numBuffers = std::max(knobs.numBuffers, camera.stream->AnnouncedBuffers().size());
+            }
 
-            // ---------------------------------------------------------------------------------------------------------
-            // Depth map processing
-            // ---------------------------------------------------------------------------------------------------------
+            nion::ThroughputControlSettings settings;
+            settings.latencyBudgetMs = throughputLatencyBudgetMs;
+            settings.minFrameRate = throughputMinFrameRate;
+            settings.periodFrameCount = throughputControlPeriodFrames;
+            settings.maxNumWorkers = knobs.numWorkers;
+            settings.maxDecimation = throughputMaxDecimation;
+            settings.maxNumBuffers = std::max(throughputMaxBufferCount, knobs.numBuffers);
+            settings.maxBinning = std::max(throughputMaxBinning, knobs.binning);
 
-            // Create image from raw depth buffer and attach metadata
-            peak::icv::Image rawDepth(parts.depthMap->ToImageView());
-            rawDepth.SetMetadata(metadata);
+            throughputController = std::make_unique<nion::ThroughputController>(settings, knobs);
+            throughputControl = std::make_unique<ThroughputControl>(
+                ThroughputControl{ *throughputController, *workerPool, pointCloudStream.get() });
 
-            // Convert depth values to floating-point metric coordinates
-            auto depth = rawDepth.ConvertPixelFormatWithFactor(peak::common::PixelFormat::Coord3D_C32f, scaleFactor);
+            for (auto& camera : cameras)
+            {
+                camera.appliedKnobs = knobs;
+                ConnectThroughputController(*camera.pipeline, *throughputController);
+            }
+        }
 
-            // Remove invalid depth pixels and get region of only valid pixels
-            peak::icv::ThresholdF validPixelThreshold{ minimumValidValue, maximumValidValue };
+        // Ctrl+C stops the acquisition, and all frames received until then are still processed and written
+        std::signal(SIGINT, RequestStop);
+        if (continuousStreamingEnabled)
+        {
+            std::cout << "Streaming until Ctrl+C is pressed." << std::endl;
+        }
 
-            auto validPixelsRegion = validPixelThreshold.Process(depth);
+        AcquireFramesOfAllCameras(cameras, fileWriter, pointCloudFormatSettings, throughputControl.get());
 
-            depth.SetRegion(validPixelsRegion);
+        // Frames waiting for the frames of other cameras are released before the pipelines can finish
+        if (pointCloudMerger)
+        {
+            for (auto& camera : cameras)
+            {
+                camera.pipeline->WaitUntilProcessed();
+            }
 
-            // Undistort the depth map
-            auto undistortedDepth = undistortion.Process(depth);
+            pointCloudMerger->Finish();
+            std::cout << "Merged point clouds: " << pointCloudMerger->NumMergedPointClouds()
+                      << ", unmatched frames: " << pointCloudMerger->NumUnmatchedFrames()
+                      << ", dropped slots: " << pointCloudMerger->NumDroppedSlots() << std::endl;
+        }
 
-            // Optional distance-based filtering
-            if (filterDistanceEnabled)
+        // All buffers have to be returned to the stream before the acquisition is stopped
+        for (auto& camera : cameras)
+        {
+            if (camera.pipeline)
             {
-                peak::icv::ThresholdF distanceFilter(filterDistanceIntervalMm);
-                undistortedDepth.SetRegion(distanceFilter.Process(undistortedDepth));
+                camera.pipeline->Finish();
+                std::cout << camera.messagePrefix << "Frames dropped by the pipeline: "
+                          << camera.numPreviouslyDroppedFrames + camera.pipeline->NumDroppedFrames() << std::endl;
             }
+        }
 
-            WriteDepthMapToFile(undistortedDepth, i);
+        fileWriter.Finish();
+        std::cout << "Files dropped by the file writer: " << fileWriter.NumDroppedFiles() << std::endl;
 
-            // ---------------------------------------------------------------------------------------------------------
-            // Intensity image processing
-            // ---------------------------------------------------------------------------------------------------------
+        if (pointCloudStream)
+        {
+            std::cout << "Point clouds streamed: " << pointCloudStream->NumSentFrames()
+                      << ", clients disconnected: " << pointCloudStream->NumDisconnectedClients() << std::endl;
+        }
 
-            peak::icv::Image intensity(parts.intensity->ToImageView());
-            intensity.SetMetadata(metadata);
+        for (auto& camera : cameras)
+        {
+            std::cout << camera.messagePrefix;
+            nion::PrintBufferStatistics(camera.bufferMonitor->Statistics());
 
-            auto undistortedIntensity = undistortion.Process(intensity);
-            WriteIntensityToFile(undistortedIntensity, i);
+            if (camera.recordingWriter)
+            {
+                std::cout << camera.messagePrefix << camera.recordingWriter->NumFrames()
+                          << " frames recorded." << std::endl;
+            }
 
-            // Queue buffer that it can be reused. This can be done after the buffer data is no longer used.
-            stream->QueueBuffer(buffer);
+            if (camera.sequenceWriter)
+            {
+                camera.sequenceWriter->Close();
+                std::cout << camera.messagePrefix << camera.sequenceWriter->NumFrames()
+                          << " frames written to the sequence file." << std::endl;
+                if (camera.sequenceWriter->NumSkippedFrames() > 0)
+                {
+                    std::cout << camera.messagePrefix << "Warning: " << camera.sequenceWriter->NumSkippedFrames()
+                              << " frames not written, the index of the sequence file was full. Increase "
+                                 "sequenceMaxFrameCount to archive longer sessions."
+                              << std::endl;
+                }
+            }
+        }
 
-            // ---------------------------------------------------------------------------------------------------------
-            // Point cloud generation
-            // ---------------------------------------------------------------------------------------------------------
+        if (latencyStatisticsEnabled)
+        {
+            latencyStatistics.Print(std::cout);
 
-            peak::icv::PointCloudXYZI pointCloud(undistortedDepth, undistortedIntensity);
-            WritePointCloudToFile(pointCloud, i);
+            const auto latencyFilePath = nion::GetOutputFilePath() + "latency_statistics.csv";
+            latencyStatistics.WriteCsv(latencyFilePath);
+            std::cout << "Latency statistics written to: " << latencyFilePath << std::endl;
         }
 
-        DeviceStopAcquisition(nodeMap, stream);
+        for (auto& camera : cameras)
+        {
+            DeviceStopAcquisition(*camera.nodes, camera.stream);
+        }
     }
     catch (const std::exception& e)
     {
@@ -0,0 +1,204 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "mapped_file.hpp"
+
+// Standard headers
+#include <stdexcept>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace nion
+{
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& filePath, Mode mode)
+    : m_filePath(filePath)
+    , m_mode(mode)
+{
+    const auto isCreating = (mode == Mode::Create);
+    const auto handle = CreateFileA(filePath.c_str(), isCreating ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+        FILE_SHARE_READ, nullptr, isCreating ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    LARGE_INTEGER size{};
+    GetFileSizeEx(handle, &size);
+    m_handle = handle;
+    m_size = static_cast<uint64_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+    CloseHandle(m_handle);
+}
+
+void MappedFile::Reserve(uint64_t size)
+{
+    if (size <= m_size)
+    {
+        return;
+    }
+
+    // Setting the end of the file allocates its disk space
+    LARGE_INTEGER end{};
+    end.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(m_handle, end, nullptr, FILE_BEGIN) || !SetEndOfFile(m_handle))
+    {
+        throw std::runtime_error("Failed to allocate disk space for file: " + m_filePath);
+    }
+
+    m_size = size;
+}
+
+void MappedFile::Truncate(uint64_t size)
+{
+    LARGE_INTEGER end{};
+    end.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(m_handle, end, nullptr, FILE_BEGIN) || !SetEndOfFile(m_handle))
+    {
+        throw std::runtime_error("Failed to truncate file: " + m_filePath);
+    }
+
+    m_size = size;
+}
+
+uint8_t* MappedFile::Map(uint64_t offset, size_t size)
+{
+    // The views keep the mapping object alive, so it is closed right away
+    const auto isReadOnly = (m_mode == Mode::Read);
+    const auto mapping = CreateFileMappingA(
+        m_handle, nullptr, isReadOnly ? PAGE_READONLY : PAGE_READWRITE, 0, 0, nullptr);
+    if (!mapping)
+    {
+        throw std::runtime_error("Failed to map file: " + m_filePath);
+    }
+
+    auto* data = MapViewOfFile(mapping, isReadOnly ? FILE_MAP_READ : FILE_MAP_WRITE, static_cast<DWORD>(offset >> 32),
+        static_cast<DWORD>(offset & 0xFFFFFFFF), size);
+    CloseHandle(mapping);
+    if (!data)
+    {
+        throw std::runtime_error("Failed to map file: " + m_filePath);
+    }
+
+    return static_cast<uint8_t*>(data);
+}
+
+void MappedFile::Unmap(uint8_t* data, size_t /* size */)
+{
+    UnmapViewOfFile(data);
+}
+
+size_t MappedFile::MappingAlignment()
+{
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+#else
+MappedFile::MappedFile(const std::string& filePath, Mode mode)
+    : m_filePath(filePath)
+    , m_mode(mode)
+{
+    const auto fd = (mode == Mode::Create) ? open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)
+                                           : open(filePath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    struct stat status{};
+    if (fstat(fd, &status) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    m_handle = reinterpret_cast<void*>(static_cast<intptr_t>(fd));
+    m_size = static_cast<uint64_t>(status.st_size);
+}
+
+MappedFile::~MappedFile()
+{
+    close(static_cast<int>(reinterpret_cast<intptr_t>(m_handle)));
+}
+
+void MappedFile::Reserve(uint64_t size)
+{
+    if (size <= m_size)
+    {
+        return;
+    }
+
+    const auto fd = static_cast<int>(reinterpret_cast<intptr_t>(m_handle));
+    if (posix_fallocate(fd, static_cast<off_t>(m_size), static_cast<off_t>(size - m_size)) != 0)
+    {
+        throw std::runtime_error("Failed to allocate disk space for file: " + m_filePath);
+    }
+
+    m_size = size;
+}
+
+void MappedFile::Truncate(uint64_t size)
+{
+    const auto fd = static_cast<int>(reinterpret_cast<intptr_t>(m_handle));
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        throw std::runtime_error("Failed to truncate file: " + m_filePath);
+    }
+
+    m_size = size;
+}
+
+uint8_t* MappedFile::Map(uint64_t offset, size_t size)
+{
+    const auto fd = static_cast<int>(reinterpret_cast<intptr_t>(m_handle));
+    const auto protection = (m_mode == Mode::Read) ? PROT_READ : PROT_READ | PROT_WRITE;
+    auto* data = mmap(nullptr, size, protection, MAP_SHARED, fd, static_cast<off_t>(offset));
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("Failed to map file: " + m_filePath);
+    }
+
+    return static_cast<uint8_t*>(data);
+}
+
+void MappedFile::Unmap(uint8_t* data, size_t size)
+{
+    munmap(data, size);
+}
+
+size_t MappedFile::MappingAlignment()
+{
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+#endif
+
+uint64_t MappedFile::Size() const
+{
+    return m_size;
+}
+
+} // namespace nion
@@ -0,0 +1,70 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace nion
+{
+
+// File that is accessed through memory mappings of parts of it
+class MappedFile
+{
+public:
+    enum class Mode
+    {
+        // Open an existing file for reading
+        Read,
+        // Create a new file or replace an existing one, for reading and writing
+        Create
+    };
+
+    MappedFile(const std::string& filePath, Mode mode);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    uint64_t Size() const;
+
+    // Grow the file to the given size and allocate its disk space, so writing into mappings of it does not fail
+    // later for lack of space and the file is stored in few extents
+    void Reserve(uint64_t size);
+
+    // Shrink the file to the given size. Parts beyond it must not be mapped.
+    void Truncate(uint64_t size);
+
+    // Map size bytes at the offset, which has to be a multiple of MappingAlignment(), into memory. The mapping is
+    // read-only in Read mode.
+    uint8_t* Map(uint64_t offset, size_t size);
+    void Unmap(uint8_t* data, size_t size);
+
+    // Alignment of the offsets of mappings, the page size or allocation granularity of the platform
+    static size_t MappingAlignment();
+
+private:
+    std::string m_filePath;
+    Mode m_mode;
+    void* m_handle{};
+    uint64_t m_size{};
+};
+
+} // namespace nion
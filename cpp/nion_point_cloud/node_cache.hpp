@@ -0,0 +1,74 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// IDS peak headers
+#include <peak/peak.hpp>
+
+namespace nion
+{
+
+// Caches the node handles of a node map, so that every node is only looked up once by its name.
+// Not thread-safe, the device is configured from a single thread.
+class NodeCache
+{
+public:
+    explicit NodeCache(std::shared_ptr<peak::core::NodeMap> nodeMap)
+        : m_nodeMap(std::move(nodeMap))
+    {}
+
+    template <typename T>
+    std::shared_ptr<T> Find(const std::string& name)
+    {
+        const auto it = m_nodes.find(name);
+        if (it == m_nodes.end())
+        {
+            auto node = m_nodeMap->FindNode<T>(name);
+            m_nodes.emplace(name, node);
+            return node;
+        }
+
+        auto node = std::dynamic_pointer_cast<T>(it->second);
+        if (!node)
+        {
+            throw std::logic_error("Node " + name + " was looked up with a different type before.");
+        }
+
+        return node;
+    }
+
+    bool Has(const std::string& name)
+    {
+        return m_nodes.count(name) > 0 || m_nodeMap->HasNode(name);
+    }
+
+    const std::shared_ptr<peak::core::NodeMap>& NodeMap() const
+    {
+        return m_nodeMap;
+    }
+
+private:
+    std::shared_ptr<peak::core::NodeMap> m_nodeMap;
+    std::unordered_map<std::string, std::shared_ptr<peak::core::nodes::Node>> m_nodes;
+};
+
+} // namespace nion
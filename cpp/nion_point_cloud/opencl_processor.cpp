@@ -0,0 +1,663 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "opencl_processor.hpp"
+
+// Standard headers
+#include <stdexcept>
+
+#ifdef NION_POINT_CLOUD_OPENCL
+#    include <algorithm>
+#    include <array>
+#    include <cstring>
+#    include <limits>
+#    include <string>
+#    include <type_traits>
+#    include <vector>
+
+#    define CL_TARGET_OPENCL_VERSION 120
+#    include <CL/cl.h>
+#endif
+
+// Project headers
+#include "bounded_queue.hpp"
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+
+#ifdef NION_POINT_CLOUD_OPENCL
+
+namespace
+{
+
+// The kernels use the same arithmetic as DirectProcessor and CreatePointCloud(). Contracting multiplications and
+// additions into fused multiply-adds is disabled, as it would change the rounding.
+const char* const kernelSource = R"(
+#pragma OPENCL FP_CONTRACT OFF
+
+#define INVALID_INDEX 0xFFFFFFFFu
+
+// Layout of UndistortionMap::BilinearSample
+typedef struct
+{
+    uint index;
+    float weightX;
+    float weightY;
+} BilinearSample;
+
+// Nearest source pixel of every pixel of the work area, invalid pixels are 0. rowBounds holds the first and one past
+// the last valid x of every row, relative to the work area.
+__kernel void UndistortDepth(__global const ushort* rawDepth, __global const uint* sourceIndices,
+    __global const uchar* isRawDepthValid, uint imageWidth, uint areaX, uint areaY, __global ushort* depth,
+    __global uchar* valid, __global int* rowBounds)
+{
+    const uint x = get_global_id(0);
+    const uint y = get_global_id(1);
+    const uint index = y * get_global_size(0) + x;
+
+    const uint sourceIndex = sourceIndices[(areaY + y) * imageWidth + areaX + x];
+    const bool isInside = sourceIndex != INVALID_INDEX;
+    const ushort value = isInside ? rawDepth[sourceIndex] : 0;
+    const bool isValid = isInside && isRawDepthValid[value] != 0;
+
+    depth[index] = isValid ? value : 0;
+    valid[index] = isValid ? 1 : 0;
+
+    if (isValid)
+    {
+        atomic_min(&rowBounds[2 * y], (int)x);
+        atomic_max(&rowBounds[2 * y + 1], (int)x + 1);
+    }
+}
+
+// Bilinear interpolation of the four neighboring source pixels
+__kernel void UndistortIntensity(__global const ushort* rawIntensity, __global const BilinearSample* samples,
+    uint imageWidth, uint areaX, uint areaY, __global ushort* intensity)
+{
+    const uint x = get_global_id(0);
+    const uint y = get_global_id(1);
+    const uint index = y * get_global_size(0) + x;
+
+    const BilinearSample sample = samples[(areaY + y) * imageWidth + areaX + x];
+    if (sample.index == INVALID_INDEX)
+    {
+        intensity[index] = 0;
+        return;
+    }
+
+    __global const ushort* top = rawIntensity + sample.index;
+    __global const ushort* bottom = top + imageWidth;
+    const float fx = sample.weightX;
+    const float fy = sample.weightY;
+
+    const float topValue = (float)top[0] * (1.0f - fx) + (float)top[1] * fx;
+    const float bottomValue = (float)bottom[0] * (1.0f - fx) + (float)bottom[1] * fx;
+
+    intensity[index] = (ushort)(topValue * (1.0f - fy) + bottomValue * fy + 0.5f);
+}
+
+// Organized point cloud of the work area with 4 floats per point, in the layout of PointXYZI
+__kernel void BackProject(__global const ushort* depth, __global const uchar* valid, __global const ushort* intensity,
+    uint areaX, uint areaY, float scaleFactor, float inverseFx, float inverseFy, float cx, float cy,
+    float invalidValue, __global float* points)
+{
+    const uint x = get_global_id(0);
+    const uint y = get_global_id(1);
+    const uint index = y * get_global_size(0) + x;
+    __global float* point = points + 4 * index;
+
+    if (valid[index] == 0)
+    {
+        point[0] = invalidValue;
+        point[1] = invalidValue;
+        point[2] = invalidValue;
+        point[3] = invalidValue;
+        return;
+    }
+
+    const float z = (float)depth[index] * scaleFactor;
+    point[0] = ((float)(areaX + x) - cx) * inverseFx * z;
+    point[1] = ((float)(areaY + y) - cy) * inverseFy * z;
+    point[2] = z;
+    point[3] = (float)intensity[index];
+}
+)";
+
+static_assert(sizeof(UndistortionMap::BilinearSample) == 3 * sizeof(cl_uint),
+    "The kernels expect an index and two weights per bilinear sample.");
+static_assert(sizeof(PointXYZI) == 4 * sizeof(cl_float), "The kernels write four floats per point.");
+
+void Check(cl_int status, const char* operation)
+{
+    if (status != CL_SUCCESS)
+    {
+        throw std::runtime_error(
+            std::string("OpenCL: ") + operation + " failed with error " + std::to_string(status) + ".");
+    }
+}
+
+struct ClRelease
+{
+    void operator()(cl_context context) const
+    {
+        clReleaseContext(context);
+    }
+
+    void operator()(cl_command_queue queue) const
+    {
+        clReleaseCommandQueue(queue);
+    }
+
+    void operator()(cl_program program) const
+    {
+        clReleaseProgram(program);
+    }
+
+    void operator()(cl_kernel kernel) const
+    {
+        clReleaseKernel(kernel);
+    }
+
+    void operator()(cl_mem buffer) const
+    {
+        clReleaseMemObject(buffer);
+    }
+};
+
+// Releases the OpenCL object on destruction
+template <typename T>
+using ClHandle = std::unique_ptr<std::remove_pointer_t<T>, ClRelease>;
+
+cl_device_id SelectDevice(const OpenClSettings& settings)
+{
+    cl_uint numPlatforms = 0;
+    const auto platformStatus = clGetPlatformIDs(0, nullptr, &numPlatforms);
+    if (platformStatus != CL_SUCCESS || settings.platformIndex >= numPlatforms)
+    {
+        throw std::runtime_error("There is no OpenCL platform with the configured index.");
+    }
+
+    std::vector<cl_platform_id> platforms(numPlatforms);
+    Check(clGetPlatformIDs(numPlatforms, platforms.data(), nullptr), "Querying the platforms");
+    const auto platform = platforms[settings.platformIndex];
+
+    cl_uint numDevices = 0;
+    const auto deviceStatus = clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, 0, nullptr, &numDevices);
+    if (deviceStatus != CL_SUCCESS || settings.deviceIndex >= numDevices)
+    {
+        throw std::runtime_error("The OpenCL platform has no device with the configured index.");
+    }
+
+    std::vector<cl_device_id> devices(numDevices);
+    Check(clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, numDevices, devices.data(), nullptr), "Querying the devices");
+    return devices[settings.deviceIndex];
+}
+
+void BuildProgram(cl_program program, cl_device_id device)
+{
+    const auto status = clBuildProgram(program, 1, &device, "", nullptr, nullptr);
+    if (status == CL_SUCCESS)
+    {
+        return;
+    }
+
+    size_t logSize = 0;
+    clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &logSize);
+    std::string log(logSize, '\0');
+    clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, logSize, &log[0], nullptr);
+
+    throw std::runtime_error("OpenCL: Building the kernels failed with error " + std::to_string(status) + ":\n" + log);
+}
+
+ClHandle<cl_mem> CreateBuffer(cl_context context, cl_mem_flags flags, size_t size, const void* hostData = nullptr)
+{
+    cl_int status = CL_SUCCESS;
+    ClHandle<cl_mem> buffer(clCreateBuffer(context, flags, size, const_cast<void*>(hostData), &status));
+    Check(status, "Creating a buffer");
+    return buffer;
+}
+
+ClHandle<cl_kernel> CreateKernel(cl_program program, const char* name)
+{
+    cl_int status = CL_SUCCESS;
+    ClHandle<cl_kernel> kernel(clCreateKernel(program, name, &status));
+    Check(status, "Creating a kernel");
+    return kernel;
+}
+
+template <typename T>
+void SetArgument(cl_kernel kernel, cl_uint index, const T& value)
+{
+    Check(clSetKernelArg(kernel, index, sizeof(T), &value), "Setting a kernel argument");
+}
+
+// Run the kernel once for every pixel of the work area
+void EnqueueKernel(cl_command_queue queue, cl_kernel kernel, const PixelRegion& area)
+{
+    const size_t globalSize[2]{ area.width, area.height };
+    Check(clEnqueueNDRangeKernel(queue, kernel, 2, nullptr, globalSize, nullptr, 0, nullptr, nullptr),
+        "Running a kernel");
+}
+
+// Copy the raw image into the pinned buffer, and into the device buffer if the device has its own memory
+void Upload(cl_command_queue queue, PlaneView<const uint16_t> image, cl_mem hostBuffer, cl_mem deviceBuffer)
+{
+    const auto size = image.NumPixels() * sizeof(uint16_t);
+
+    cl_int status = CL_SUCCESS;
+    auto* mapped = clEnqueueMapBuffer(
+        queue, hostBuffer, CL_TRUE, CL_MAP_WRITE_INVALIDATE_REGION, 0, size, 0, nullptr, nullptr, &status);
+    Check(status, "Mapping a raw image");
+
+    std::memcpy(mapped, image.data, size);
+    Check(clEnqueueUnmapMemObject(queue, hostBuffer, mapped, 0, nullptr, nullptr), "Unmapping a raw image");
+
+    if (deviceBuffer)
+    {
+        Check(clEnqueueCopyBuffer(queue, hostBuffer, deviceBuffer, 0, 0, size, 0, nullptr, nullptr),
+            "Uploading a raw image");
+    }
+}
+
+// Download an image of the size of the work area into the work area of the workspace image, without waiting
+template <typename T>
+void DownloadArea(cl_command_queue queue, cl_mem buffer, PlaneView<T> image, const PixelRegion& area)
+{
+    const size_t bufferOrigin[3]{ 0, 0, 0 };
+    const size_t hostOrigin[3]{ area.x * sizeof(T), area.y, 0 };
+    const size_t region[3]{ area.width * sizeof(T), area.height, 1 };
+
+    Check(clEnqueueReadBufferRect(queue, buffer, CL_FALSE, bufferOrigin, hostOrigin, region, area.width * sizeof(T),
+              0, image.stride * sizeof(T), 0, image.data, 0, nullptr, nullptr),
+        "Downloading an image");
+}
+
+// The raw images are read with the indices of the undistortion map, which assume contiguous images
+void CheckRawImage(PlaneView<const uint16_t> image, const FrameWorkspace& workspace)
+{
+    if (image.width != workspace.rawDepth.Width() || image.height != workspace.rawDepth.Height())
+    {
+        throw std::runtime_error("Image size does not match the size of the workspace.");
+    }
+    if (image.stride != image.width)
+    {
+        throw std::runtime_error("Only contiguous images can be undistorted.");
+    }
+}
+
+// Bounding box of the valid pixels in image coordinates, in the same way as DirectProcessor::ProcessDepthMap()
+PixelRegion GetValidBounds(const std::vector<cl_int>& rowBounds, const PixelRegion& area)
+{
+    auto minX = area.width;
+    size_t maxX = 0;
+    auto minY = area.height;
+    size_t maxY = 0;
+
+    for (size_t y = 0; y < area.height; ++y)
+    {
+        const auto first = rowBounds[2 * y];
+        const auto last = rowBounds[2 * y + 1];
+        if (first >= last)
+        {
+            continue;
+        }
+
+        minX = std::min(minX, static_cast<size_t>(first));
+        maxX = std::max(maxX, static_cast<size_t>(last));
+        minY = std::min(minY, y);
+        maxY = y + 1;
+    }
+
+    return minX < maxX ? PixelRegion{ area.x + minX, area.y + minY, maxX - minX, maxY - minY }
+                       : PixelRegion{ area.x, area.y, 0, 0 };
+}
+
+// Remove the invalid points of an organized point cloud of the work area in place, keeping the order of the points
+void CompactValidPoints(PlaneView<const uint8_t> valid, PointCloud& pointCloud)
+{
+    auto* points = pointCloud.points.data();
+    size_t numValid = 0;
+
+    for (size_t y = 0; y < valid.height; ++y)
+    {
+        const auto* validRow = valid.Row(y);
+        const auto* pointRow = points + y * valid.width;
+
+        for (size_t x = 0; x < valid.width; ++x)
+        {
+            if (validRow[x] != 0)
+            {
+                points[numValid++] = pointRow[x];
+            }
+        }
+    }
+
+    pointCloud.points.resize(numValid);
+    pointCloud.width = numValid;
+    pointCloud.height = 1;
+}
+
+} // namespace
+
+// Command queue, kernels and device memory of one frame. The arguments of the kernels never change.
+struct OpenClProcessor::FrameSlot
+{
+    ClHandle<cl_command_queue> queue;
+    ClHandle<cl_kernel> depthKernel;
+    ClHandle<cl_kernel> intensityKernel;
+    ClHandle<cl_kernel> pointKernel;
+
+    // Raw images in pinned host memory, and their copies on devices that do not share the memory of the host
+    ClHandle<cl_mem> rawDepthHost;
+    ClHandle<cl_mem> rawDepthDevice;
+    ClHandle<cl_mem> rawIntensityHost;
+    ClHandle<cl_mem> rawIntensityDevice;
+
+    // Results in the size of the work area
+    ClHandle<cl_mem> depth;
+    ClHandle<cl_mem> depthValid;
+    ClHandle<cl_mem> rowBounds;
+    ClHandle<cl_mem> intensity;
+    ClHandle<cl_mem> points;
+
+    std::vector<cl_int> hostRowBounds;
+};
+
+struct OpenClProcessor::State
+{
+    explicit State(size_t numSlots)
+        : freeSlots(numSlots)
+    {}
+
+    cl_device_id device{};
+    ClHandle<cl_context> context;
+    ClHandle<cl_program> program;
+
+    // Read by the kernels of all frames
+    ClHandle<cl_mem> sourceIndices;
+    ClHandle<cl_mem> bilinearSamples;
+    ClHandle<cl_mem> isRawDepthValid;
+
+    std::vector<std::unique_ptr<FrameSlot>> slots;
+    BoundedQueue<FrameSlot*> freeSlots;
+};
+
+OpenClProcessor::OpenClProcessor(
+    const DirectProcessor& processor, const ProcessingParameters& parameters, size_t numSlots)
+    : m_parameters(parameters)
+    , m_stages(GetOutputStages(parameters))
+    , m_workArea(processor.WorkArea())
+    , m_state(std::make_unique<State>(numSlots))
+{
+    if (parameters.temporalFilter.frameCount > 1)
+    {
+        throw std::invalid_argument("OpenCL processing does not support the temporal filter.");
+    }
+
+    auto& state = *m_state;
+    state.device = SelectDevice(parameters.openCl);
+
+    cl_int status = CL_SUCCESS;
+    state.context.reset(clCreateContext(nullptr, 1, &state.device, nullptr, nullptr, &status));
+    Check(status, "Creating the context");
+    auto* context = state.context.get();
+
+    const char* source = kernelSource;
+    state.program.reset(clCreateProgramWithSource(context, 1, &source, nullptr, &status));
+    Check(status, "Creating the program");
+    BuildProgram(state.program.get(), state.device);
+
+    const auto& map = processor.Undistortion();
+    const auto& sourceIndices = map.NearestSourceIndices();
+    const auto& bilinearSamples = map.BilinearSamples();
+    const auto& isRawDepthValid = processor.RawDepthValidity();
+    const auto readOnlyCopy = CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR;
+    state.sourceIndices = CreateBuffer(
+        context, readOnlyCopy, sourceIndices.size() * sizeof(uint32_t), sourceIndices.data());
+    state.bilinearSamples = CreateBuffer(context, readOnlyCopy,
+        bilinearSamples.size() * sizeof(UndistortionMap::BilinearSample), bilinearSamples.data());
+    state.isRawDepthValid = CreateBuffer(context, readOnlyCopy, isRawDepthValid.size(), isRawDepthValid.data());
+
+    // Integrated GPUs read the pinned raw images in place
+    cl_bool isUnifiedMemory = CL_FALSE;
+    Check(clGetDeviceInfo(state.device, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(isUnifiedMemory), &isUnifiedMemory,
+              nullptr),
+        "Querying the device");
+
+    const auto& area = m_workArea;
+    const auto imageWidth = static_cast<cl_uint>(parameters.geometry.width);
+    const auto imageSize = map.Width() * map.Height() * sizeof(uint16_t);
+    const auto areaX = static_cast<cl_uint>(area.x);
+    const auto areaY = static_cast<cl_uint>(area.y);
+    const auto numAreaPixels = area.width * area.height;
+
+    const auto& model = processor.Model();
+    const auto inverseFx = static_cast<cl_float>(1.0 / model.fx);
+    const auto inverseFy = static_cast<cl_float>(1.0 / model.fy);
+    const auto cx = static_cast<cl_float>(model.cx);
+    const auto cy = static_cast<cl_float>(model.cy);
+
+    for (size_t i = 0; i < numSlots; ++i)
+    {
+        auto slot = std::make_unique<FrameSlot>();
+        slot->queue.reset(clCreateCommandQueue(context, state.device, 0, &status));
+        Check(status, "Creating a command queue");
+        auto* queue = slot->queue.get();
+
+        if (m_stages.processDepthMap)
+        {
+            slot->rawDepthHost = CreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_ALLOC_HOST_PTR, imageSize);
+            if (!isUnifiedMemory)
+            {
+                slot->rawDepthDevice = CreateBuffer(context, CL_MEM_READ_ONLY, imageSize);
+            }
+
+            slot->depth = CreateBuffer(context, CL_MEM_READ_WRITE, numAreaPixels * sizeof(uint16_t));
+            slot->depthValid = CreateBuffer(context, CL_MEM_READ_WRITE, numAreaPixels * sizeof(uint8_t));
+            slot->rowBounds = CreateBuffer(context, CL_MEM_READ_WRITE, 2 * area.height * sizeof(cl_int));
+            slot->hostRowBounds.resize(2 * area.height);
+
+            slot->depthKernel = CreateKernel(state.program.get(), "UndistortDepth");
+            auto* kernel = slot->depthKernel.get();
+            SetArgument(kernel, 0, isUnifiedMemory ? slot->rawDepthHost.get() : slot->rawDepthDevice.get());
+            SetArgument(kernel, 1, state.sourceIndices.get());
+            SetArgument(kernel, 2, state.isRawDepthValid.get());
+            SetArgument(kernel, 3, imageWidth);
+            SetArgument(kernel, 4, areaX);
+            SetArgument(kernel, 5, areaY);
+            SetArgument(kernel, 6, slot->depth.get());
+            SetArgument(kernel, 7, slot->depthValid.get());
+            SetArgument(kernel, 8, slot->rowBounds.get());
+        }
+
+        if (m_stages.processIntensity || m_stages.createPointCloud)
+        {
+            slot->intensity = CreateBuffer(context, CL_MEM_READ_WRITE, numAreaPixels * sizeof(uint16_t));
+        }
+
+        if (m_stages.processIntensity)
+        {
+            slot->rawIntensityHost = CreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_ALLOC_HOST_PTR, imageSize);
+            if (!isUnifiedMemory)
+            {
+                slot->rawIntensityDevice = CreateBuffer(context, CL_MEM_READ_ONLY, imageSize);
+            }
+
+            slot->intensityKernel = CreateKernel(state.program.get(), "UndistortIntensity");
+            auto* kernel = slot->intensityKernel.get();
+            SetArgument(kernel, 0, isUnifiedMemory ? slot->rawIntensityHost.get() : slot->rawIntensityDevice.get());
+            SetArgument(kernel, 1, state.bilinearSamples.get());
+            SetArgument(kernel, 2, imageWidth);
+            SetArgument(kernel, 3, areaX);
+            SetArgument(kernel, 4, areaY);
+            SetArgument(kernel, 5, slot->intensity.get());
+        }
+        else if (m_stages.createPointCloud)
+        {
+            // Points without intensity image have intensity 0, as with the CPU
+            const uint16_t zero = 0;
+            Check(clEnqueueFillBuffer(queue, slot->intensity.get(), &zero, sizeof(zero), 0,
+                      numAreaPixels * sizeof(uint16_t), 0, nullptr, nullptr),
+                "Clearing the intensity image");
+        }
+
+        if (m_stages.createPointCloud)
+        {
+            slot->points = CreateBuffer(context, CL_MEM_WRITE_ONLY, numAreaPixels * sizeof(PointXYZI));
+
+            slot->pointKernel = CreateKernel(state.program.get(), "BackProject");
+            auto* kernel = slot->pointKernel.get();
+            SetArgument(kernel, 0, slot->depth.get());
+            SetArgument(kernel, 1, slot->depthValid.get());
+            SetArgument(kernel, 2, slot->intensity.get());
+            SetArgument(kernel, 3, areaX);
+            SetArgument(kernel, 4, areaY);
+            SetArgument(kernel, 5, static_cast<cl_float>(parameters.scaleFactor));
+            SetArgument(kernel, 6, inverseFx);
+            SetArgument(kernel, 7, inverseFy);
+            SetArgument(kernel, 8, cx);
+            SetArgument(kernel, 9, cy);
+            SetArgument(kernel, 10, static_cast<cl_float>(parameters.invalidPointValue));
+            SetArgument(kernel, 11, slot->points.get());
+        }
+
+        Check(clFinish(queue), "Initializing a command queue");
+
+        state.freeSlots.Push(slot.get());
+        state.slots.push_back(std::move(slot));
+    }
+}
+
+OpenClProcessor::~OpenClProcessor() = default;
+
+void OpenClProcessor::Process(
+    PlaneView<const uint16_t> rawDepth, PlaneView<const uint16_t> rawIntensity, FrameWorkspace& workspace) const
+{
+    const ScopedLatency latency(LatencyStage::OpenClProcessing);
+
+    FrameSlot* slot = nullptr;
+    m_state->freeSlots.Pop(slot);
+
+    try
+    {
+        ProcessOnSlot(*slot, rawDepth, rawIntensity, workspace);
+    }
+    catch (...)
+    {
+        // Commands already enqueued may still write into the workspace
+        clFinish(slot->queue.get());
+        m_state->freeSlots.Push(slot);
+        throw;
+    }
+
+    m_state->freeSlots.Push(slot);
+}
+
+void OpenClProcessor::ProcessOnSlot(FrameSlot& slot, PlaneView<const uint16_t> rawDepth,
+    PlaneView<const uint16_t> rawIntensity, FrameWorkspace& workspace) const
+{
+    auto* queue = slot.queue.get();
+    const auto& area = m_workArea;
+
+    // Pixels outside of the work area keep the 0 of the allocation, as with the CPU
+    if (m_stages.processDepthMap)
+    {
+        CheckRawImage(rawDepth, workspace);
+        Upload(queue, rawDepth, slot.rawDepthHost.get(), slot.rawDepthDevice.get());
+
+        const std::array<cl_int, 2> noValidPixel{ std::numeric_limits<cl_int>::max(), 0 };
+        Check(clEnqueueFillBuffer(queue, slot.rowBounds.get(), noValidPixel.data(), sizeof(noValidPixel), 0,
+                  slot.hostRowBounds.size() * sizeof(cl_int), 0, nullptr, nullptr),
+            "Clearing the row bounds");
+
+        EnqueueKernel(queue, slot.depthKernel.get(), area);
+        DownloadArea(queue, slot.depth.get(), workspace.rawDepth.View(), area);
+        DownloadArea(queue, slot.depthValid.get(), workspace.depthValid.View(), area);
+        Check(clEnqueueReadBuffer(queue, slot.rowBounds.get(), CL_FALSE, 0,
+                  slot.hostRowBounds.size() * sizeof(cl_int), slot.hostRowBounds.data(), 0, nullptr, nullptr),
+            "Downloading the row bounds");
+    }
+
+    if (m_stages.processIntensity)
+    {
+        CheckRawImage(rawIntensity, workspace);
+        Upload(queue, rawIntensity, slot.rawIntensityHost.get(), slot.rawIntensityDevice.get());
+
+        EnqueueKernel(queue, slot.intensityKernel.get(), area);
+        DownloadArea(queue, slot.intensity.get(), workspace.intensity.View(), area);
+    }
+
+    // The device creates organized point clouds of the work area, which are reduced to the valid points on the host
+    // for unorganized and downsampled point clouds
+    const auto isDownsampled = m_parameters.voxelLeafSizeMm > 0.0F;
+    auto& pointCloud = isDownsampled ? workspace.densePointCloud : workspace.pointCloud;
+    if (m_stages.createPointCloud)
+    {
+        pointCloud.points.resize(area.width * area.height);
+        pointCloud.width = area.width;
+        pointCloud.height = area.height;
+
+        EnqueueKernel(queue, slot.pointKernel.get(), area);
+        Check(clEnqueueReadBuffer(queue, slot.points.get(), CL_FALSE, 0, pointCloud.points.size() * sizeof(PointXYZI),
+                  pointCloud.points.data(), 0, nullptr, nullptr),
+            "Downloading the point cloud");
+    }
+
+    Check(clFinish(queue), "Processing a frame");
+
+    workspace.isDepthConverted = false;
+    if (m_stages.processDepthMap)
+    {
+        workspace.workArea = area;
+        workspace.validBounds = GetValidBounds(slot.hostRowBounds, area);
+    }
+
+    if (!m_stages.createPointCloud || (m_parameters.organizedPointCloud && !isDownsampled))
+    {
+        return;
+    }
+
+    CompactValidPoints(Crop(AsConst(workspace.depthValid.View()), area), pointCloud);
+    if (isDownsampled)
+    {
+        const ScopedLatency latency(LatencyStage::VoxelGridDownsampling);
+        workspace.voxelGrid.Downsample(workspace.densePointCloud, m_parameters.voxelLeafSizeMm, workspace.pointCloud);
+    }
+}
+
+#else
+
+struct OpenClProcessor::State
+{};
+
+OpenClProcessor::OpenClProcessor(
+    const DirectProcessor& /* processor */, const ProcessingParameters& parameters, size_t /* numSlots */)
+    : m_parameters(parameters)
+{
+    throw std::runtime_error("OpenCL processing requires building the example with NION_POINT_CLOUD_OPENCL.");
+}
+
+OpenClProcessor::~OpenClProcessor() = default;
+
+void OpenClProcessor::Process(PlaneView<const uint16_t> /* rawDepth */, PlaneView<const uint16_t> /* rawIntensity */,
+    FrameWorkspace& /* workspace */) const
+{
+    throw std::logic_error("OpenCL processing is not available.");
+}
+
+#endif
+
+} // namespace nion
@@ -0,0 +1,73 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Project headers
+#include "direct_processing.hpp"
+#include "image_plane.hpp"
+#include "processing.hpp"
+
+namespace nion
+{
+
+// Processes the raw images of the direct backend on an OpenCL device, e.g. the integrated GPU of a Jetson or a
+// discrete GPU, instead of the CPU. The raw depth map and intensity image of a frame are copied once into pinned host
+// memory. Devices that share the memory of the host read them there, other devices get a single upload. Conversion,
+// thresholding, undistortion and back-projection then run on the device, and the results are downloaded into the
+// FrameWorkspace. They match the results of the DirectProcessor the processor was created from, as it uses the same
+// undistortion map, depth validity and work area.
+//
+// Every frame in flight has its own command queue and device memory, so the transfers of one frame overlap with the
+// processing of the frames processed by the other worker threads. Only available if the example is built with
+// NION_POINT_CLOUD_OPENCL, otherwise the constructor throws.
+class OpenClProcessor
+{
+public:
+    // Uploads the undistortion map and depth validity of the processor once. numSlots is the number of frames that
+    // are processed at the same time, usually the number of frames in flight.
+    OpenClProcessor(const DirectProcessor& processor, const ProcessingParameters& parameters, size_t numSlots);
+    ~OpenClProcessor();
+
+    OpenClProcessor(const OpenClProcessor&) = delete;
+    OpenClProcessor& operator=(const OpenClProcessor&) = delete;
+    OpenClProcessor(OpenClProcessor&&) = delete;
+    OpenClProcessor& operator=(OpenClProcessor&&) = delete;
+
+    // Process the raw images of the output stages of the parameters into the workspace, including the point cloud,
+    // and wait until the results are downloaded. Can be called by several threads at once, and waits while all slots
+    // are in use.
+    void Process(
+        PlaneView<const uint16_t> rawDepth, PlaneView<const uint16_t> rawIntensity, FrameWorkspace& workspace) const;
+
+private:
+    struct FrameSlot;
+    struct State;
+
+    void ProcessOnSlot(FrameSlot& slot, PlaneView<const uint16_t> rawDepth, PlaneView<const uint16_t> rawIntensity,
+        FrameWorkspace& workspace) const;
+
+    ProcessingParameters m_parameters;
+    OutputStages m_stages;
+    PixelRegion m_workArea;
+    std::unique_ptr<State> m_state;
+};
+
+} // namespace nion
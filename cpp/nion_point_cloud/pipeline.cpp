@@ -0,0 +1,601 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "pipeline.hpp"
+
+// Standard headers
+#include <stdexcept>
+#include <utility>
+
+// Project headers
+#include "file_output.hpp"
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+
+Pipeline::Pipeline(const peak::icv::CalibrationParameters& calibration, const ProcessingParameters& parameters,
+    size_t maxFramesInFlight, WorkerPool& workerPool, FileWriter& fileWriter,
+    const PointCloudFormatSettings& pointCloudFormat, std::string cameraName)
+    : m_parameters(parameters)
+    , m_stages(GetOutputStages(parameters))
+    , m_maxFramesInFlight(maxFramesInFlight)
+    , m_pointCloudFormat(pointCloudFormat)
+    , m_cameraName(std::move(cameraName))
+    , m_freeFrames(maxFramesInFlight)
+    , m_freeIcvUndistortions(maxFramesInFlight)
+    , m_workerPool(workerPool)
+    , m_workerClient(workerPool.AddClient())
+    , m_fileWriter(fileWriter)
+{
+    for (size_t i = 0; i < maxFramesInFlight; ++i)
+    {
+        m_frames.push_back(std::make_unique<PipelineFrame>());
+        m_freeFrames.TryPush(m_frames.back().get());
+    }
+
+    if (parameters.backend == ProcessingBackend::Direct)
+    {
+        m_directProcessor = std::make_unique<DirectProcessor>(calibration, parameters);
+
+        // Allocated and initialized by a thread with the placement of the workers, so the images are on their
+        // NUMA node
+        RunPlaced(workerPool.Placement(), [&] {
+            m_workspacePool = std::make_unique<WorkspacePool>(
+                maxFramesInFlight, parameters.geometry.width, parameters.geometry.height);
+
+            if (parameters.copyRawFrames)
+            {
+                m_rawFrameArena = std::make_unique<RawFrameArena>(
+                    maxFramesInFlight, parameters.geometry.width, parameters.geometry.height);
+            }
+        });
+
+        if (parameters.openCl.enabled)
+        {
+            m_openClProcessor = std::make_unique<OpenClProcessor>(*m_directProcessor, parameters, maxFramesInFlight);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < maxFramesInFlight; ++i)
+        {
+            m_icvUndistortions.push_back(std::make_unique<IcvUndistortion>(calibration));
+            m_freeIcvUndistortions.Push(m_icvUndistortions.back().get());
+        }
+    }
+}
+
+Pipeline::~Pipeline()
+{
+    WaitForFramesInFlight();
+    m_workerPool.RemoveClient(m_workerClient);
+}
+
+void Pipeline::SetPointCloudStream(PointCloudStream& stream)
+{
+    if (!m_directProcessor)
+    {
+        throw std::logic_error("Streaming point clouds requires the direct backend.");
+    }
+
+    m_pointCloudStream = &stream;
+}
+
+void Pipeline::SetSharedMemoryRing(SharedMemoryRing& ring)
+{
+    if (!m_directProcessor)
+    {
+        throw std::logic_error("Publishing into shared memory requires the direct backend.");
+    }
+
+    m_sharedMemoryRing = &ring;
+}
+
+void Pipeline::SetSequenceWriter(SequenceWriter& writer)
+{
+    if (!m_directProcessor)
+    {
+        throw std::logic_error("Writing a sequence file requires the direct backend.");
+    }
+
+    m_sequenceWriter = &writer;
+}
+
+void Pipeline::SetPointCloudCallback(PointCloudCallback callback)
+{
+    if (!m_directProcessor)
+    {
+        throw std::logic_error("Point cloud callbacks require the direct backend.");
+    }
+
+    if (!m_stages.createPointCloud)
+    {
+        throw std::logic_error("Point cloud callbacks require an output profile with point clouds.");
+    }
+
+    m_pointCloudCallback = std::move(callback);
+}
+
+void Pipeline::SetFrameLatencyCallback(std::function<void(std::chrono::steady_clock::duration latency)> callback)
+{
+    m_frameLatencyCallback = std::move(callback);
+}
+
+bool Pipeline::Submit(size_t index, uint64_t deviceTimestampNs, std::chrono::steady_clock::time_point receiveTime,
+    BufferHandle buffer, std::shared_ptr<peak::core::BufferPart> depthMapPart,
+    std::shared_ptr<peak::core::BufferPart> intensityPart)
+{
+    RethrowError();
+
+    // Checks the pixel format and size of the raw images
+    PlaneView<const uint16_t> rawDepth;
+    PlaneView<const uint16_t> rawIntensity;
+    if (m_directProcessor)
+    {
+        if (m_stages.processDepthMap)
+        {
+            rawDepth = ViewRawDepthMap(*depthMapPart);
+        }
+
+        if (m_stages.processIntensity)
+        {
+            rawIntensity = ViewRawIntensity(*intensityPart);
+        }
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(m_framesMutex);
+        if (m_framesInFlight >= m_maxFramesInFlight)
+        {
+            ++m_numDroppedFrames;
+            return false;
+        }
+
+        ++m_framesInFlight;
+        ++m_framesProcessing;
+    }
+
+    // Undone if the frame cannot be submitted, so neither Finish() nor the destructor wait for it
+    PipelineFrame* frame = nullptr;
+    int numSteps = 0;
+    int numSubmittedSteps = 0;
+    try
+    {
+        // There is a frame for every frame in flight, so one is always available here
+        if (!m_freeFrames.TryPop(frame))
+        {
+            throw std::logic_error("No free pipeline frame available.");
+        }
+
+        frame->index = index;
+        frame->deviceTimestampNs = deviceTimestampNs;
+        frame->receiveTime = receiveTime;
+        frame->depthMapPart = std::move(depthMapPart);
+        frame->intensityPart = std::move(intensityPart);
+        frame->rawDepth = rawDepth;
+        frame->rawIntensity = rawIntensity;
+        frame->hasFailed = false;
+        frame->numPendingUsers = 1;
+
+        // Without a free copy, the frame is processed in place from the buffer
+        if (m_rawFrameArena)
+        {
+            frame->rawFrame = m_rawFrameArena->TryCopy(rawDepth, rawIntensity);
+            if (frame->rawFrame)
+            {
+                if (rawDepth.data)
+                {
+                    frame->rawDepth = AsConst(frame->rawFrame->depth);
+                }
+
+                if (rawIntensity.data)
+                {
+                    frame->rawIntensity = AsConst(frame->rawFrame->intensity);
+                }
+
+                frame->depthMapPart.reset();
+                frame->intensityPart.reset();
+                buffer.Reset();
+            }
+        }
+
+        // There is a workspace or an undistortion for every frame in flight, so one is always available here
+        if (m_workspacePool)
+        {
+            frame->workspace = m_workspacePool->TryAcquire();
+            if (!frame->workspace)
+            {
+                throw std::logic_error("No free workspace available.");
+            }
+        }
+        else if (!m_freeIcvUndistortions.TryPop(frame->icvUndistortion))
+        {
+            throw std::logic_error("No free undistortion available.");
+        }
+
+        // The OpenCL device processes both images of a frame in one step
+        if (m_openClProcessor)
+        {
+            numSteps = 1;
+            frame->numPendingSteps = numSteps;
+            SubmitStep(frame, &Pipeline::OpenClStep, std::move(buffer));
+            return true;
+        }
+
+        // Every step holds the buffer, which is queued again once all of them have read its data
+        numSteps = (m_stages.processDepthMap ? 1 : 0) + (m_stages.processIntensity ? 1 : 0);
+        frame->numPendingSteps = numSteps;
+        if (m_stages.processDepthMap)
+        {
+            SubmitStep(frame, &Pipeline::DepthStep, buffer);
+            ++numSubmittedSteps;
+        }
+
+        if (m_stages.processIntensity)
+        {
+            SubmitStep(frame, &Pipeline::IntensityStep, std::move(buffer));
+        }
+
+        return true;
+    }
+    catch (...)
+    {
+        if (numSubmittedSteps > 0)
+        {
+            // The submitted steps finish the frame once the steps that were not submitted are done
+            frame->hasFailed = true;
+            for (auto i = numSubmittedSteps; i < numSteps; ++i)
+            {
+                FinishStep(*frame);
+            }
+        }
+        else
+        {
+            AbortFrame(frame);
+        }
+        throw;
+    }
+}
+
+void Pipeline::SubmitStep(PipelineFrame* frame, Step step, BufferHandle buffer)
+{
+    m_workerPool.Submit(m_workerClient, [this, frame, step, buffer = std::move(buffer)]() mutable {
+        RunStep(*frame, step, std::move(buffer));
+    });
+}
+
+void Pipeline::WaitUntilProcessed()
+{
+    std::unique_lock<std::mutex> lock(m_framesMutex);
+    m_framesFinished.wait(lock, [this] {
+        return m_framesProcessing == 0;
+    });
+}
+
+void Pipeline::Finish()
+{
+    WaitForFramesInFlight();
+    RethrowError();
+}
+
+size_t Pipeline::NumDroppedFrames() const
+{
+    return m_numDroppedFrames;
+}
+
+size_t Pipeline::NumFramesInFlight() const
+{
+    const std::lock_guard<std::mutex> lock(m_framesMutex);
+    return m_framesInFlight;
+}
+
+void Pipeline::RunStep(PipelineFrame& frame, Step step, BufferHandle buffer)
+{
+    try
+    {
+        (this->*step)(frame);
+    }
+    catch (...)
+    {
+        frame.hasFailed = true;
+        SetError(std::current_exception());
+    }
+
+    // The raw data is no longer used by this step
+    buffer.Reset();
+    FinishStep(frame);
+}
+
+void Pipeline::FinishStep(PipelineFrame& frame)
+{
+    if (--frame.numPendingSteps > 0)
+    {
+        return;
+    }
+
+    // All steps have read the raw images
+    if (frame.rawFrame)
+    {
+        m_rawFrameArena->Release(frame.rawFrame);
+        frame.rawFrame = nullptr;
+    }
+
+    if (frame.icvUndistortion)
+    {
+        m_freeIcvUndistortions.Push(frame.icvUndistortion);
+        frame.icvUndistortion = nullptr;
+    }
+
+    if (frame.hasFailed)
+    {
+        FinishFrame(frame);
+    }
+    else
+    {
+        PointCloudStep(frame);
+    }
+
+    FinishProcessing();
+}
+
+void Pipeline::DepthStep(PipelineFrame& frame)
+{
+    if (m_directProcessor)
+    {
+        m_directProcessor->ProcessDepthMap(frame.rawDepth, *frame.workspace);
+    }
+    else
+    {
+        frame.depth = std::make_unique<peak::icv::Image>(
+            ProcessDepthMap(*frame.depthMapPart, frame.icvUndistortion->depth, m_parameters));
+    }
+
+    frame.depthMapPart.reset();
+}
+
+void Pipeline::IntensityStep(PipelineFrame& frame)
+{
+    if (m_directProcessor)
+    {
+        m_directProcessor->UndistortIntensity(frame.rawIntensity, *frame.workspace);
+    }
+    else
+    {
+        frame.intensity = std::make_unique<peak::icv::Image>(
+            ProcessIntensity(*frame.intensityPart, frame.icvUndistortion->intensity, m_parameters));
+    }
+
+    frame.intensityPart.reset();
+}
+
+void Pipeline::OpenClStep(PipelineFrame& frame)
+{
+    m_openClProcessor->Process(frame.rawDepth, frame.rawIntensity, *frame.workspace);
+
+    frame.depthMapPart.reset();
+    frame.intensityPart.reset();
+}
+
+void Pipeline::PointCloudStep(PipelineFrame& frame)
+{
+    auto* workspace = frame.workspace;
+    auto isSubmitted = false;
+
+    try
+    {
+        const auto fileSuffix = FrameFileSuffix(m_cameraName, frame.index);
+
+        FileWriteJob job;
+        if (m_directProcessor)
+        {
+            // The OpenCL processor already created the point cloud
+            if (m_stages.createPointCloud && !m_openClProcessor)
+            {
+                m_directProcessor->CreatePointCloud(*workspace);
+            }
+
+            // The shared memory ring and the sequence file take the raw depth map unless the temporal filter already
+            // converted it, only the depth map file requires metric depth values
+            const auto depthMap = m_stages.processDepthMap ? m_directProcessor->DepthMap(*workspace) : DepthMapView{};
+            if (m_stages.processDepthMap && m_stages.writeDepthMap)
+            {
+                m_directProcessor->ConvertDepthMap(*workspace);
+            }
+
+            // Sent, published and archived on the worker, so the consumers neither wait for the files nor lose the
+            // frames that the file writer drops
+            if (m_pointCloudStream && m_stages.createPointCloud)
+            {
+                m_pointCloudStream->Send(frame.index, frame.deviceTimestampNs, workspace->pointCloud,
+                    Crop(AsConst(workspace->depthValid.View()), workspace->workArea));
+            }
+
+            if (m_sharedMemoryRing)
+            {
+                m_sharedMemoryRing->Publish(frame.index, frame.deviceTimestampNs, depthMap,
+                    m_stages.processIntensity ? AsConst(workspace->intensity.View()) : PlaneView<const uint16_t>{},
+                    m_stages.createPointCloud ? &workspace->pointCloud : nullptr);
+            }
+
+            // Frames beyond the capacity of the index are counted by the writer and not archived
+            if (m_sequenceWriter)
+            {
+                m_sequenceWriter->WriteFrame(frame.index, frame.deviceTimestampNs, depthMap,
+                    m_stages.processIntensity ? AsConst(workspace->intensity.View()) : PlaneView<const uint16_t>{},
+                    m_stages.createPointCloud ? &workspace->pointCloud : nullptr);
+            }
+
+            job = CreateFrameWriteJob(fileSuffix, *workspace, m_stages, m_pointCloudFormat);
+        }
+        else
+        {
+            // The ICV point cloud is only used for its file
+            std::shared_ptr<const peak::icv::PointCloudXYZI> pointCloud;
+            if (m_stages.writePointCloud)
+            {
+                const ScopedLatency latency(LatencyStage::PointCloudCreation);
+                pointCloud = std::make_shared<const peak::icv::PointCloudXYZI>(*frame.depth, *frame.intensity);
+            }
+
+            // Results that were only needed for the point cloud are not written
+            std::shared_ptr<const peak::icv::Image> depth;
+            if (m_stages.writeDepthMap)
+            {
+                depth = std::move(frame.depth);
+            }
+
+            std::shared_ptr<const peak::icv::Image> intensity;
+            if (m_stages.writeIntensity)
+            {
+                intensity = std::move(frame.intensity);
+            }
+
+            job = CreateFrameWriteJob(fileSuffix, std::move(depth), std::move(intensity), std::move(pointCloud));
+        }
+
+        auto& latencyStatistics = LatencyStatistics::Instance();
+        const auto receiveTime = frame.receiveTime;
+        if (m_stages.createPointCloud)
+        {
+            latencyStatistics.RecordSince(LatencyStage::ReceiveToPointCloud, receiveTime);
+        }
+
+        job.onFinished = [this, &frame, &latencyStatistics, receiveTime] {
+            latencyStatistics.RecordSince(LatencyStage::ReceiveToFilesWritten, receiveTime);
+            if (m_frameLatencyCallback)
+            {
+                m_frameLatencyCallback(std::chrono::steady_clock::now() - receiveTime);
+            }
+
+            ReleaseFrame(frame);
+        };
+
+        // Handed over before the files, which may have to wait for the file writer
+        if (m_pointCloudCallback && m_stages.createPointCloud)
+        {
+            ++frame.numPendingUsers;
+            m_pointCloudCallback(frame.deviceTimestampNs, workspace->pointCloud, [this, &frame] {
+                ReleaseFrame(frame);
+            });
+        }
+
+        // Waits if the write queue is full and the file writer uses the blocking policy.
+        // From here on, the file writer releases the frame.
+        isSubmitted = true;
+        m_fileWriter.Submit(std::move(job));
+    }
+    catch (...)
+    {
+        SetError(std::current_exception());
+
+        if (!isSubmitted)
+        {
+            ReleaseFrame(frame);
+        }
+    }
+}
+
+void Pipeline::AbortFrame(PipelineFrame* frame)
+{
+    if (frame)
+    {
+        if (frame->rawFrame)
+        {
+            m_rawFrameArena->Release(frame->rawFrame);
+            frame->rawFrame = nullptr;
+        }
+
+        if (frame->icvUndistortion)
+        {
+            m_freeIcvUndistortions.Push(frame->icvUndistortion);
+            frame->icvUndistortion = nullptr;
+        }
+
+        FinishFrame(*frame);
+    }
+    else
+    {
+        const std::lock_guard<std::mutex> lock(m_framesMutex);
+        --m_framesInFlight;
+        m_framesFinished.notify_all();
+    }
+
+    FinishProcessing();
+}
+
+void Pipeline::ReleaseFrame(PipelineFrame& frame)
+{
+    if (--frame.numPendingUsers == 0)
+    {
+        FinishFrame(frame);
+    }
+}
+
+void Pipeline::FinishFrame(PipelineFrame& frame)
+{
+    if (frame.workspace)
+    {
+        m_workspacePool->Release(frame.workspace);
+        frame.workspace = nullptr;
+    }
+
+    // Frees the results of the ICV backend that were not handed to the file writer
+    frame.depthMapPart.reset();
+    frame.intensityPart.reset();
+    frame.depth.reset();
+    frame.intensity.reset();
+    m_freeFrames.TryPush(&frame);
+
+    // Notified with the lock held, as the pipeline may be destroyed as soon as the last frame is finished
+    const std::lock_guard<std::mutex> lock(m_framesMutex);
+    --m_framesInFlight;
+    m_framesFinished.notify_all();
+}
+
+void Pipeline::FinishProcessing()
+{
+    const std::lock_guard<std::mutex> lock(m_framesMutex);
+    --m_framesProcessing;
+    m_framesFinished.notify_all();
+}
+
+void Pipeline::WaitForFramesInFlight()
+{
+    std::unique_lock<std::mutex> lock(m_framesMutex);
+    m_framesFinished.wait(lock, [this] {
+        return m_framesInFlight == 0 && m_framesProcessing == 0;
+    });
+}
+
+void Pipeline::SetError(std::exception_ptr error)
+{
+    const std::lock_guard<std::mutex> lock(m_errorMutex);
+    if (!m_error)
+    {
+        m_error = std::move(error);
+    }
+}
+
+void Pipeline::RethrowError()
+{
+    const std::lock_guard<std::mutex> lock(m_errorMutex);
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+} // namespace nion
@@ -0,0 +1,252 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// IDS peak headers
+#include <peak/peak.hpp>
+#include <peak_icv/peak_icv.hpp>
+
+// Project headers
+#include "bounded_queue.hpp"
+#include "buffer_handle.hpp"
+#include "direct_processing.hpp"
+#include "file_writer.hpp"
+#include "lock_free_queue.hpp"
+#include "opencl_processor.hpp"
+#include "point_cloud_encoding.hpp"
+#include "point_cloud_stream.hpp"
+#include "processing.hpp"
+#include "raw_frame_arena.hpp"
+#include "sequence_file.hpp"
+#include "shared_memory_ring.hpp"
+#include "worker_pool.hpp"
+
+namespace nion
+{
+
+// Undistortion of the ICV backend for one frame in flight. The ICV undistortion objects are not shared between
+// threads, so every frame in flight uses its own ones, and the steps of consecutive frames run in parallel.
+struct IcvUndistortion
+{
+    explicit IcvUndistortion(const peak::icv::CalibrationParameters& calibration)
+        : depth(calibration)
+        , intensity(calibration)
+    {}
+
+    peak::icv::Undistortion depth;
+    peak::icv::Undistortion intensity;
+};
+
+// Data of a single frame while it passes through the pipeline. The frames are allocated once per frame in
+// flight and reused, see Pipeline::Submit().
+struct PipelineFrame
+{
+    size_t index{};
+    uint64_t deviceTimestampNs{};
+    std::chrono::steady_clock::time_point receiveTime{};
+    std::shared_ptr<peak::core::BufferPart> depthMapPart{};
+    std::shared_ptr<peak::core::BufferPart> intensityPart{};
+
+    // Raw images read by the direct backend, either in the buffer or in a copy of the raw frame arena
+    PlaneView<const uint16_t> rawDepth{};
+    PlaneView<const uint16_t> rawIntensity{};
+    RawFrame* rawFrame{};
+
+    // Results of the ICV backend, and the undistortion used for them until both images are processed
+    IcvUndistortion* icvUndistortion{};
+    std::unique_ptr<peak::icv::Image> depth{};
+    std::unique_ptr<peak::icv::Image> intensity{};
+
+    // Results of the direct backend, taken from the pool of the pipeline and
+    // returned once the files of the frame are written
+    FrameWorkspace* workspace{};
+
+    // Depth and intensity processing still running. The step that finishes last creates the point cloud.
+    std::atomic<int> numPendingSteps{};
+    std::atomic<bool> hasFailed{ false };
+
+    // File writer and point cloud callback still using the results
+    std::atomic<int> numPendingUsers{ 1 };
+};
+
+// Processes the frames of one camera in steps that run as tasks on a WorkerPool:
+//
+//   Submit() ─┬─> depth processing ─────┬─> point cloud generation ──> FileWriter
+//             └─> intensity processing ─┘
+//
+// Depth map and intensity image of a frame are processed in parallel, and so are consecutive
+// frames, so the throughput scales with the number of worker threads. The worker pool and the
+// file writer can be shared by the pipelines of several cameras. A frame stays in flight until
+// its files are written and, if set, the point cloud callback released it. Submit() never waits:
+// if the pipeline is full, the frame is dropped and its buffer returned to the stream. Steps that
+// the output profile of the processing parameters does not need are skipped, see GetOutputStages().
+// With OpenCL, depth map, intensity image and point cloud of a frame are processed in a single
+// step on the device, see OpenClProcessor.
+class Pipeline
+{
+public:
+    // Receives the point cloud and device timestamp of every frame of the direct backend, see
+    // SetPointCloudCallback(). release must be called exactly once when the point cloud is no longer used.
+    using PointCloudCallback = std::function<void(
+        uint64_t deviceTimestampNs, const PointCloud& pointCloud, std::function<void()> release)>;
+
+    // The worker pool and the file writer must outlive the pipeline. The camera name is
+    // part of the output file names, see FrameFileSuffix().
+    Pipeline(const peak::icv::CalibrationParameters& calibration, const ProcessingParameters& parameters,
+        size_t maxFramesInFlight, WorkerPool& workerPool, FileWriter& fileWriter,
+        const PointCloudFormatSettings& pointCloudFormat, std::string cameraName);
+
+    // Waits for all frames in flight and removes the pipeline from the worker pool
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+    Pipeline(Pipeline&&) = delete;
+    Pipeline& operator=(Pipeline&&) = delete;
+
+    // Additionally hand the point cloud of every frame to the callback, e.g. to merge the point clouds of several
+    // cameras. The frame stays in flight until the callback releases it. Called from the worker threads, and must not
+    // throw. Only supported by the direct backend with an output profile that creates point clouds, and has to be set
+    // before the first frame is submitted.
+    void SetPointCloudCallback(PointCloudCallback callback);
+
+    // Additionally send the point cloud of every frame to the clients of the stream, on the worker before the files of
+    // the frame are submitted. The stream must outlive the pipeline. Only supported by the direct backend, and has to
+    // be set before the first frame is submitted.
+    void SetPointCloudStream(PointCloudStream& stream);
+
+    // Additionally publish the results of every frame into the shared memory ring, on the worker before the files of
+    // the frame are submitted. The ring must outlive the pipeline. Only supported by the direct backend, and has to be
+    // set before the first frame is submitted.
+    void SetSharedMemoryRing(SharedMemoryRing& ring);
+
+    // Additionally append the results of every frame to the sequence file, on the worker before the files of the frame
+    // are submitted. The writer must outlive the pipeline. Only supported by the direct backend, and has to be set
+    // before the first frame is submitted.
+    void SetSequenceWriter(SequenceWriter& writer);
+
+    // Additionally report the end-to-end latency of every frame once its files are written, e.g. to control the load
+    // of the host. Called from the file writer threads, and must not throw. Has to be set before the first frame is
+    // submitted.
+    void SetFrameLatencyCallback(std::function<void(std::chrono::steady_clock::duration latency)> callback);
+
+    // Hand a frame over to the pipeline. Returns false if the frame was dropped, in which case the buffer is
+    // released right away. With copyRawFrames, the raw images are copied and the buffer is released before the
+    // frame is processed, unless all copies are in use. The receive time is the start of the end-to-end latencies.
+    // Buffer parts that the output profile does not need may be null.
+    bool Submit(size_t index, uint64_t deviceTimestampNs, std::chrono::steady_clock::time_point receiveTime,
+        BufferHandle buffer, std::shared_ptr<peak::core::BufferPart> depthMapPart,
+        std::shared_ptr<peak::core::BufferPart> intensityPart);
+
+    // Wait until the point clouds of all submitted frames are created, so no callback follows.
+    // Their files may still be written.
+    void WaitUntilProcessed();
+
+    // Wait until all submitted frames are processed and their files are written or dropped.
+    // Rethrows the first error that occurred while processing a frame.
+    void Finish();
+
+    size_t NumDroppedFrames() const;
+
+    // Number of submitted frames whose files are not written yet, at most maxFramesInFlight
+    size_t NumFramesInFlight() const;
+
+private:
+    using Step = void (Pipeline::*)(PipelineFrame&);
+
+    void SubmitStep(PipelineFrame* frame, Step step, BufferHandle buffer);
+    void RunStep(PipelineFrame& frame, Step step, BufferHandle buffer);
+
+    // Called once for every step of a frame. The last one runs the point cloud step, or finishes a failed frame.
+    void FinishStep(PipelineFrame& frame);
+    void DepthStep(PipelineFrame& frame);
+    void IntensityStep(PipelineFrame& frame);
+    void OpenClStep(PipelineFrame& frame);
+    void PointCloudStep(PipelineFrame& frame);
+
+    // Called by every user of the results of a frame. The last one finishes the frame.
+    void ReleaseFrame(PipelineFrame& frame);
+
+    // Release the results of a frame and return it to the free frames, so a new frame can be submitted
+    void FinishFrame(PipelineFrame& frame);
+
+    // The point cloud step of a frame is done or skipped
+    void FinishProcessing();
+
+    // Undo the reservation of a frame that could not be submitted, before any of its steps was submitted. The frame
+    // is null if none was taken from the free frames.
+    void AbortFrame(PipelineFrame* frame);
+
+    void WaitForFramesInFlight();
+    void SetError(std::exception_ptr error);
+    void RethrowError();
+
+    ProcessingParameters m_parameters;
+    OutputStages m_stages;
+    size_t m_maxFramesInFlight;
+    PointCloudFormatSettings m_pointCloudFormat;
+    std::string m_cameraName;
+
+    // Frames in flight, taken when a frame is submitted and returned once it is finished. The free frames are kept in
+    // a lock-free queue, so submitting and finishing a frame does not allocate.
+    std::vector<std::unique_ptr<PipelineFrame>> m_frames;
+    LockFreeQueue<PipelineFrame*> m_freeFrames;
+
+    // One undistortion per frame in flight, allocated once for the ICV backend
+    std::vector<std::unique_ptr<IcvUndistortion>> m_icvUndistortions;
+    BoundedQueue<IcvUndistortion*> m_freeIcvUndistortions;
+
+    // One workspace and raw frame copy per frame in flight, allocated once for the direct backend
+    std::unique_ptr<DirectProcessor> m_directProcessor;
+    std::unique_ptr<WorkspacePool> m_workspacePool;
+    std::unique_ptr<RawFrameArena> m_rawFrameArena;
+
+    // Replaces the depth, intensity and point cloud processing of the direct processor if OpenCL is enabled
+    std::unique_ptr<OpenClProcessor> m_openClProcessor;
+
+    WorkerPool& m_workerPool;
+    size_t m_workerClient;
+    FileWriter& m_fileWriter;
+
+    PointCloudCallback m_pointCloudCallback{};
+    PointCloudStream* m_pointCloudStream{};
+    SharedMemoryRing* m_sharedMemoryRing{};
+    SequenceWriter* m_sequenceWriter{};
+    std::function<void(std::chrono::steady_clock::duration)> m_frameLatencyCallback{};
+
+    mutable std::mutex m_framesMutex;
+    std::condition_variable m_framesFinished;
+    size_t m_framesInFlight{};
+    size_t m_framesProcessing{};
+    std::atomic<size_t> m_numDroppedFrames{ 0 };
+
+    std::mutex m_errorMutex;
+    std::exception_ptr m_error{};
+};
+
+} // namespace nion
@@ -0,0 +1,435 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "plane_compression.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace nion
+{
+namespace
+{
+
+constexpr char compressedPlaneMagic[4] = { 'N', 'C', 'M', 'P' };
+constexpr uint32_t compressedPlaneVersion = 1;
+
+static_assert(sizeof(CompressedPlaneHeader) == 24, "CompressedPlaneHeader must not contain padding.");
+
+constexpr size_t groupSize = 16;
+
+// Bit width byte and 16 errors of at most 16 bits
+constexpr size_t maxEncodedGroupSize = 1 + groupSize * sizeof(uint16_t);
+
+size_t NumChunks(size_t height, size_t chunkRows)
+{
+    return (height + chunkRows - 1) / chunkRows;
+}
+
+size_t MaxEncodedChunkSize(size_t width, size_t chunkRows)
+{
+    return (width * chunkRows + groupSize - 1) / groupSize * maxEncodedGroupSize;
+}
+
+// Median edge detector of LOCO-I, from the left (a), upper (b) and upper left (c) pixel
+uint16_t PredictPixel(uint16_t a, uint16_t b, uint16_t c)
+{
+    if (c >= std::max(a, b))
+    {
+        return std::min(a, b);
+    }
+    if (c <= std::min(a, b))
+    {
+        return std::max(a, b);
+    }
+
+    return static_cast<uint16_t>(a + b - c);
+}
+
+// Map small positive and negative errors to small values: 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+uint16_t ZigzagEncode(uint16_t error)
+{
+    return static_cast<uint16_t>((error << 1) ^ (error & 0x8000U ? 0xFFFFU : 0U));
+}
+
+uint16_t ZigzagDecode(uint16_t value)
+{
+    return static_cast<uint16_t>((value >> 1) ^ (value & 1U ? 0xFFFFU : 0U));
+}
+
+uint8_t BitWidth(uint16_t value)
+{
+    uint8_t width = 0;
+    while (value)
+    {
+        ++width;
+        value = static_cast<uint16_t>(value >> 1);
+    }
+
+    return width;
+}
+
+// Write the group with the smallest bit width that holds all of its values. Returns the end of the group.
+uint8_t* EncodeGroup(const uint16_t* values, uint8_t* output)
+{
+    uint16_t allBits = 0;
+    for (size_t i = 0; i < groupSize; ++i)
+    {
+        allBits = static_cast<uint16_t>(allBits | values[i]);
+    }
+
+    const auto bitWidth = BitWidth(allBits);
+    *output++ = bitWidth;
+
+    // 16 values of any width fill whole bytes
+    uint64_t bits = 0;
+    size_t numBits = 0;
+    for (size_t i = 0; i < groupSize; ++i)
+    {
+        bits |= static_cast<uint64_t>(values[i]) << numBits;
+        numBits += bitWidth;
+        while (numBits >= 8)
+        {
+            *output++ = static_cast<uint8_t>(bits);
+            bits >>= 8;
+            numBits -= 8;
+        }
+    }
+
+    return output;
+}
+
+// Read a group written by EncodeGroup(). Returns the end of the group.
+const uint8_t* DecodeGroup(const uint8_t* input, const uint8_t* end, uint16_t* values)
+{
+    if (input == end || *input > 16 || static_cast<size_t>(end - input - 1) < 2 * size_t{ *input })
+    {
+        throw std::runtime_error("Compressed plane is truncated or corrupt.");
+    }
+
+    const auto bitWidth = *input++;
+    const auto mask = static_cast<uint64_t>((1U << bitWidth) - 1);
+
+    uint64_t bits = 0;
+    size_t numBits = 0;
+    for (size_t i = 0; i < groupSize; ++i)
+    {
+        while (numBits < bitWidth)
+        {
+            bits |= static_cast<uint64_t>(*input++) << numBits;
+            numBits += 8;
+        }
+
+        values[i] = static_cast<uint16_t>(bits & mask);
+        bits >>= bitWidth;
+        numBits -= bitWidth;
+    }
+
+    return input;
+}
+
+// Zigzag-encoded prediction errors of a row. The first row of a chunk (without upper row) is predicted from the
+// left pixel only.
+void EncodeRow(const uint16_t* row, const uint16_t* upperRow, size_t width, uint16_t* errors)
+{
+    if (!upperRow)
+    {
+        uint16_t left = 0;
+        for (size_t x = 0; x < width; ++x)
+        {
+            errors[x] = ZigzagEncode(static_cast<uint16_t>(row[x] - left));
+            left = row[x];
+        }
+        return;
+    }
+
+    errors[0] = ZigzagEncode(static_cast<uint16_t>(row[0] - upperRow[0]));
+    for (size_t x = 1; x < width; ++x)
+    {
+        const auto prediction = PredictPixel(row[x - 1], upperRow[x], upperRow[x - 1]);
+        errors[x] = ZigzagEncode(static_cast<uint16_t>(row[x] - prediction));
+    }
+}
+
+// Inverse of EncodeRow()
+void DecodeRow(const uint16_t* errors, const uint16_t* upperRow, size_t width, uint16_t* row)
+{
+    if (!upperRow)
+    {
+        uint16_t left = 0;
+        for (size_t x = 0; x < width; ++x)
+        {
+            left = static_cast<uint16_t>(left + ZigzagDecode(errors[x]));
+            row[x] = left;
+        }
+        return;
+    }
+
+    row[0] = static_cast<uint16_t>(upperRow[0] + ZigzagDecode(errors[0]));
+    for (size_t x = 1; x < width; ++x)
+    {
+        const auto prediction = PredictPixel(row[x - 1], upperRow[x], upperRow[x - 1]);
+        row[x] = static_cast<uint16_t>(prediction + ZigzagDecode(errors[x]));
+    }
+}
+
+// Returns the size of the encoded chunk
+size_t EncodeChunk(PlaneView<const uint16_t> plane, size_t y0, size_t y1, uint8_t* output)
+{
+    // The errors of all rows, padded to whole groups
+    const auto numValues = plane.width * (y1 - y0);
+    const auto numGroups = (numValues + groupSize - 1) / groupSize;
+    thread_local std::vector<uint16_t> errors;
+    errors.assign(numGroups * groupSize, 0);
+
+    for (size_t y = y0; y < y1; ++y)
+    {
+        EncodeRow(plane.Row(y), y > y0 ? plane.Row(y - 1) : nullptr, plane.width,
+            errors.data() + (y - y0) * plane.width);
+    }
+
+    auto* position = output;
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+        position = EncodeGroup(errors.data() + g * groupSize, position);
+    }
+
+    return static_cast<size_t>(position - output);
+}
+
+void DecodeChunk(const uint8_t* input, size_t size, PlaneView<uint16_t> plane, size_t y0, size_t y1)
+{
+    const auto* end = input + size;
+
+    const auto numValues = plane.width * (y1 - y0);
+    const auto numGroups = (numValues + groupSize - 1) / groupSize;
+    thread_local std::vector<uint16_t> errors;
+    errors.resize(numGroups * groupSize);
+
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+        input = DecodeGroup(input, end, errors.data() + g * groupSize);
+    }
+
+    for (size_t y = y0; y < y1; ++y)
+    {
+        DecodeRow(errors.data() + (y - y0) * plane.width, y > y0 ? plane.Row(y - 1) : nullptr, plane.width,
+            plane.Row(y));
+    }
+}
+
+} // namespace
+
+PlaneCompressor::PlaneCompressor(const PlaneCompressionSettings& settings)
+    : m_settings(settings)
+{
+    if (m_settings.chunkRows == 0)
+    {
+        throw std::invalid_argument("Chunks of compressed planes require at least one row.");
+    }
+
+    for (size_t i = 1; i < m_settings.numThreads; ++i)
+    {
+        m_threads.emplace_back(&PlaneCompressor::RunHelper, this);
+    }
+}
+
+PlaneCompressor::~PlaneCompressor()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_hasChunks.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void PlaneCompressor::Compress(PlaneView<const uint16_t> plane, std::vector<uint8_t>& data)
+{
+    const std::lock_guard<std::mutex> callLock(m_callMutex);
+
+    const auto chunkRows = m_settings.chunkRows;
+    const auto numChunks = NumChunks(plane.height, chunkRows);
+    const auto maxChunkSize = MaxEncodedChunkSize(plane.width, chunkRows);
+    const auto tableOffset = sizeof(CompressedPlaneHeader);
+    const auto dataOffset = tableOffset + numChunks * sizeof(uint32_t);
+
+    // Every chunk is encoded into its own region of the maximum size first
+    data.resize(dataOffset + numChunks * maxChunkSize);
+    m_chunks.resize(numChunks);
+
+    const std::function<void(size_t)> encodeChunk = [&](size_t c) {
+        const auto y0 = c * chunkRows;
+        const auto y1 = std::min(y0 + chunkRows, plane.height);
+        m_chunks[c].size = EncodeChunk(plane, y0, y1, data.data() + dataOffset + c * maxChunkSize);
+    };
+    RunChunks(numChunks, encodeChunk);
+
+    CompressedPlaneHeader header{};
+    std::memcpy(header.magic, compressedPlaneMagic, sizeof(header.magic));
+    header.version = compressedPlaneVersion;
+    header.width = static_cast<uint32_t>(plane.width);
+    header.height = static_cast<uint32_t>(plane.height);
+    header.chunkRows = static_cast<uint32_t>(chunkRows);
+    header.numChunks = static_cast<uint32_t>(numChunks);
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    auto size = dataOffset;
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+        const auto chunkSize = static_cast<uint32_t>(m_chunks[c].size);
+        std::memcpy(data.data() + tableOffset + c * sizeof(uint32_t), &chunkSize, sizeof(chunkSize));
+
+        // Regions only move towards the front, the first one stays in place
+        std::memmove(data.data() + size, data.data() + dataOffset + c * maxChunkSize, chunkSize);
+        size += chunkSize;
+    }
+
+    data.resize(size);
+}
+
+void PlaneCompressor::Decompress(const uint8_t* data, size_t size, PlaneView<uint16_t> plane)
+{
+    const std::lock_guard<std::mutex> callLock(m_callMutex);
+
+    CompressedPlaneHeader header{};
+    if (size < sizeof(header))
+    {
+        throw std::runtime_error("Compressed plane is truncated or corrupt.");
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, compressedPlaneMagic, sizeof(header.magic)) != 0
+        || header.version != compressedPlaneVersion || header.chunkRows == 0
+        || header.numChunks != NumChunks(header.height, header.chunkRows))
+    {
+        throw std::runtime_error("Not a compressed plane or unsupported version.");
+    }
+    if (header.width != plane.width || header.height != plane.height)
+    {
+        throw std::invalid_argument("Image size does not match the size of the compressed plane.");
+    }
+
+    const size_t numChunks = header.numChunks;
+    const auto tableOffset = sizeof(CompressedPlaneHeader);
+    const auto dataOffset = tableOffset + numChunks * sizeof(uint32_t);
+    if (size < dataOffset)
+    {
+        throw std::runtime_error("Compressed plane is truncated or corrupt.");
+    }
+
+    m_chunks.resize(numChunks);
+    auto offset = dataOffset;
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+        uint32_t chunkSize = 0;
+        std::memcpy(&chunkSize, data + tableOffset + c * sizeof(uint32_t), sizeof(chunkSize));
+        if (chunkSize > size - offset)
+        {
+            throw std::runtime_error("Compressed plane is truncated or corrupt.");
+        }
+
+        m_chunks[c] = { offset, chunkSize };
+        offset += chunkSize;
+    }
+
+    const size_t chunkRows = header.chunkRows;
+    const std::function<void(size_t)> decodeChunk = [&](size_t c) {
+        const auto y0 = c * chunkRows;
+        const auto y1 = std::min(y0 + chunkRows, plane.height);
+        DecodeChunk(data + m_chunks[c].offset, m_chunks[c].size, plane, y0, y1);
+    };
+    RunChunks(numChunks, decodeChunk);
+}
+
+void PlaneCompressor::RunChunks(size_t numChunks, const std::function<void(size_t)>& chunkFunction)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_chunkFunction = &chunkFunction;
+    m_numChunks = numChunks;
+    m_nextChunk = 0;
+    m_numDoneChunks = 0;
+    m_hasChunks.notify_all();
+
+    ProcessChunks(lock);
+    m_chunksDone.wait(lock, [this] { return m_numDoneChunks == m_numChunks; });
+
+    m_chunkFunction = nullptr;
+    m_numChunks = 0;
+    m_nextChunk = 0;
+
+    const auto error = m_error;
+    m_error = nullptr;
+    lock.unlock();
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void PlaneCompressor::ProcessChunks(std::unique_lock<std::mutex>& lock)
+{
+    while (m_nextChunk < m_numChunks)
+    {
+        const auto chunk = m_nextChunk++;
+        const auto* chunkFunction = m_chunkFunction;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+        {
+            (*chunkFunction)(chunk);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        if (error && !m_error)
+        {
+            m_error = error;
+        }
+        if (++m_numDoneChunks == m_numChunks)
+        {
+            m_chunksDone.notify_all();
+        }
+    }
+}
+
+void PlaneCompressor::RunHelper()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_hasChunks.wait(lock, [this] { return m_isStopping || m_nextChunk < m_numChunks; });
+        if (m_isStopping)
+        {
+            return;
+        }
+
+        ProcessChunks(lock);
+    }
+}
+
+} // namespace nion
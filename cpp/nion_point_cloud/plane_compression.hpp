@@ -0,0 +1,125 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "image_plane.hpp"
+
+namespace nion
+{
+
+// Layout of a compressed plane. The header and the chunk sizes are stored in the byte order of the host, which is
+// little-endian on all platforms supported by IDS peak. The chunks are byte streams and do not depend on it.
+//
+//   CompressedPlaneHeader
+//   size of every chunk (numChunks uint32)
+//   chunks, each one holding chunkRows rows (the last one possibly less)
+//
+// Every pixel of a chunk is predicted from its decoded neighbors: in the first row of the chunk from the left pixel,
+// in the other rows from the left, upper and upper left pixel (median edge detector, as in LOCO-I). The prediction
+// errors are zigzag-encoded and stored in groups of 16, each one as a byte with the bit width of the largest error of
+// the group followed by the 16 errors with this width, packed from the least significant bit on. Invalid depth pixels
+// and smooth surfaces give small errors, so most groups take a few bits per pixel, and a group of equal pixels takes a
+// single byte.
+struct CompressedPlaneHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t chunkRows;
+    uint32_t numChunks;
+};
+
+struct PlaneCompressionSettings
+{
+    // Threads that compress or decompress the chunks of a plane in parallel, including the calling thread
+    size_t numThreads{ 4 };
+
+    // Rows of a chunk. Chunks are compressed independently of each other.
+    size_t chunkRows{ 32 };
+};
+
+// Lossless compression of 16 bit planes, e.g. the raw depth maps and intensity images of a recording. The
+// compression needs no dictionary and runs in a single pass, and the chunks of a plane are compressed on several
+// threads, so it is faster than writing the uncompressed plane to disk.
+class PlaneCompressor
+{
+public:
+    explicit PlaneCompressor(const PlaneCompressionSettings& settings);
+
+    // Stops the helper threads
+    ~PlaneCompressor();
+
+    PlaneCompressor(const PlaneCompressor&) = delete;
+    PlaneCompressor& operator=(const PlaneCompressor&) = delete;
+    PlaneCompressor(PlaneCompressor&&) = delete;
+    PlaneCompressor& operator=(PlaneCompressor&&) = delete;
+
+    // Compress the plane into data, which only allocates if its capacity is exceeded. Concurrent calls are processed
+    // one after another, each one on all threads.
+    void Compress(PlaneView<const uint16_t> plane, std::vector<uint8_t>& data);
+
+    // Decompress data of the given size into the plane, which must have the size of the compressed plane. Throws a
+    // std::runtime_error if the data is not a valid compressed plane.
+    void Decompress(const uint8_t* data, size_t size, PlaneView<uint16_t> plane);
+
+private:
+    // Encoded data of a chunk, compacted after all chunks are encoded
+    struct EncodedChunk
+    {
+        size_t offset{};
+        size_t size{};
+    };
+
+    // Call chunkFunction for all chunk indices, on the helper threads and the calling thread
+    void RunChunks(size_t numChunks, const std::function<void(size_t)>& chunkFunction);
+
+    // Process chunks of the current call until all are taken. Must be called with the mutex locked.
+    void ProcessChunks(std::unique_lock<std::mutex>& lock);
+
+    void RunHelper();
+
+    PlaneCompressionSettings m_settings;
+    std::vector<EncodedChunk> m_chunks;
+
+    // Serializes the calls, which share the chunks and the helper threads
+    std::mutex m_callMutex;
+
+    std::mutex m_mutex;
+    std::condition_variable m_hasChunks;
+    std::condition_variable m_chunksDone;
+    const std::function<void(size_t)>* m_chunkFunction{};
+    size_t m_numChunks{};
+    size_t m_nextChunk{};
+    size_t m_numDoneChunks{};
+    std::exception_ptr m_error{};
+    bool m_isStopping{};
+
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace nion
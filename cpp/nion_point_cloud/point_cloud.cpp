@@ -0,0 +1,160 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "point_cloud.hpp"
+
+namespace nion
+{
+namespace
+{
+
+// The undistorted images follow the ideal pinhole model
+struct PinholeModel
+{
+    explicit PinholeModel(const LensModel& model)
+        : inverseFx(static_cast<float>(1.0 / model.fx))
+        , inverseFy(static_cast<float>(1.0 / model.fy))
+        , cx(static_cast<float>(model.cx))
+        , cy(static_cast<float>(model.cy))
+    {}
+
+    float RayX(size_t x) const
+    {
+        return (static_cast<float>(x) - cx) * inverseFx;
+    }
+
+    float RayY(size_t y) const
+    {
+        return (static_cast<float>(y) - cy) * inverseFy;
+    }
+
+    float inverseFx;
+    float inverseFy;
+    float cx;
+    float cy;
+};
+
+// The metric value of a depth pixel, with the same rounding as ConvertDepth()
+float MetricDepth(float value, float /* scaleFactor */)
+{
+    return value;
+}
+
+float MetricDepth(uint16_t value, float scaleFactor)
+{
+    return static_cast<float>(value) * scaleFactor;
+}
+
+template <typename T>
+PixelRegion RegionOrImage(const PixelRegion& region, PlaneView<const T> image)
+{
+    return region.IsEmpty() ? PixelRegion{ 0, 0, image.width, image.height } : region;
+}
+
+template <typename T>
+void CreateUnorganizedPointCloud(PlaneView<const T> depth, float scaleFactor, PlaneView<const uint8_t> depthValid,
+    PlaneView<const uint16_t> intensity, const LensModel& model, PointCloud& pointCloud, const PixelRegion& region)
+{
+    auto& points = pointCloud.points;
+    points.clear();
+
+    const PinholeModel pinhole(model);
+    const auto area = RegionOrImage(region, depth);
+
+    for (size_t y = area.y; y < area.y + area.height; ++y)
+    {
+        const auto* depthRow = depth.Row(y);
+        const auto* validRow = depthValid.Row(y);
+        const auto* intensityRow = intensity.Row(y);
+        const auto rayY = pinhole.RayY(y);
+
+        for (size_t x = area.x; x < area.x + area.width; ++x)
+        {
+            if (validRow[x] == 0)
+            {
+                continue;
+            }
+
+            const auto z = MetricDepth(depthRow[x], scaleFactor);
+            points.push_back({ pinhole.RayX(x) * z, rayY * z, z, static_cast<float>(intensityRow[x]) });
+        }
+    }
+
+    pointCloud.width = points.size();
+    pointCloud.height = 1;
+}
+
+template <typename T>
+void CreateOrganizedPointCloud(PlaneView<const T> depth, float scaleFactor, PlaneView<const uint8_t> depthValid,
+    PlaneView<const uint16_t> intensity, const LensModel& model, float invalidValue, PointCloud& pointCloud,
+    const PixelRegion& region)
+{
+    const auto area = RegionOrImage(region, depth);
+    pointCloud.width = area.width;
+    pointCloud.height = area.height;
+    pointCloud.points.resize(area.width * area.height);
+
+    const PinholeModel pinhole(model);
+    const PointXYZI invalidPoint{ invalidValue, invalidValue, invalidValue, invalidValue };
+
+    for (size_t y = area.y; y < area.y + area.height; ++y)
+    {
+        const auto* depthRow = depth.Row(y);
+        const auto* validRow = depthValid.Row(y);
+        const auto* intensityRow = intensity.Row(y);
+        auto* pointRow = pointCloud.points.data() + (y - area.y) * area.width;
+        const auto rayY = pinhole.RayY(y);
+
+        for (size_t x = area.x; x < area.x + area.width; ++x)
+        {
+            const auto z = MetricDepth(depthRow[x], scaleFactor);
+            pointRow[x - area.x] = validRow[x] != 0
+                ? PointXYZI{ pinhole.RayX(x) * z, rayY * z, z, static_cast<float>(intensityRow[x]) }
+                : invalidPoint;
+        }
+    }
+}
+
+} // namespace
+
+void CreatePointCloud(DepthMapView depth, PlaneView<const uint8_t> depthValid, PlaneView<const uint16_t> intensity,
+    const LensModel& model, PointCloud& pointCloud, const PixelRegion& region)
+{
+    if (depth.raw.data)
+    {
+        CreateUnorganizedPointCloud(depth.raw, depth.scaleFactor, depthValid, intensity, model, pointCloud, region);
+    }
+    else
+    {
+        CreateUnorganizedPointCloud(depth.metric, 1.0F, depthValid, intensity, model, pointCloud, region);
+    }
+}
+
+void CreateOrganizedPointCloud(DepthMapView depth, PlaneView<const uint8_t> depthValid,
+    PlaneView<const uint16_t> intensity, const LensModel& model, float invalidValue, PointCloud& pointCloud,
+    const PixelRegion& region)
+{
+    if (depth.raw.data)
+    {
+        CreateOrganizedPointCloud(
+            depth.raw, depth.scaleFactor, depthValid, intensity, model, invalidValue, pointCloud, region);
+    }
+    else
+    {
+        CreateOrganizedPointCloud(depth.metric, 1.0F, depthValid, intensity, model, invalidValue, pointCloud, region);
+    }
+}
+
+} // namespace nion
@@ -0,0 +1,81 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdint>
+#include <vector>
+
+// Project headers
+#include "image_plane.hpp"
+#include "lens_model.hpp"
+
+namespace nion
+{
+
+// 3D point in millimeters with the intensity of its pixel
+struct PointXYZI
+{
+    float x;
+    float y;
+    float z;
+    float intensity;
+};
+
+// Points in row-major order, with the same layout as PCL point clouds: Organized clouds contain one point
+// per pixel and have the size of the image. Unorganized clouds only contain valid points and a height of 1.
+struct PointCloud
+{
+    std::vector<PointXYZI> points;
+    size_t width{};
+    size_t height{};
+};
+
+// Undistorted depth map, either in metric values or in raw values that are converted while the points are created.
+// Empty if neither is set.
+struct DepthMapView
+{
+    DepthMapView() = default;
+
+    DepthMapView(PlaneView<const float> metricDepth)
+        : metric(metricDepth)
+    {}
+
+    DepthMapView(PlaneView<const uint16_t> rawDepth, float rawScaleFactor)
+        : raw(rawDepth)
+        , scaleFactor(rawScaleFactor)
+    {}
+
+    PlaneView<const float> metric{};
+    PlaneView<const uint16_t> raw{};
+    float scaleFactor{};
+};
+
+// Back-project all valid pixels of an undistorted depth map into an unorganized point cloud. The
+// points vector of the point cloud is reused and only allocates if its capacity is exceeded.
+// Only the pixels of the region are read, or all pixels if it is empty.
+void CreatePointCloud(DepthMapView depth, PlaneView<const uint8_t> depthValid, PlaneView<const uint16_t> intensity,
+    const LensModel& model, PointCloud& pointCloud, const PixelRegion& region = {});
+
+// Back-project all pixels of an undistorted depth map into an organized point cloud. All coordinates and
+// the intensity of invalid pixels are set to invalidValue, e.g. NaN. The point cloud only allocates when
+// the image size changes, so the points keep their address and stride from frame to frame. With a region,
+// the point cloud has the size of the region and only contains its pixels.
+void CreateOrganizedPointCloud(DepthMapView depth, PlaneView<const uint8_t> depthValid,
+    PlaneView<const uint16_t> intensity, const LensModel& model, float invalidValue, PointCloud& pointCloud,
+    const PixelRegion& region = {});
+
+} // namespace nion
@@ -0,0 +1,180 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "point_cloud_encoding.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace nion
+{
+namespace
+{
+
+static_assert(sizeof(PointXYZI) == 4 * sizeof(float), "PointXYZI must consist of four consecutive floats.");
+static_assert(sizeof(XyziHeader) == 16, "XyziHeader must not contain padding.");
+
+// All formats store multi-byte values in little-endian order, which is the native
+// order of the supported platforms, so values are copied as they are.
+template <typename T>
+uint8_t* Append(uint8_t* data, T value)
+{
+    std::memcpy(data, &value, sizeof(T));
+    return data + sizeof(T);
+}
+
+void AppendText(const std::string& text, std::vector<uint8_t>& data)
+{
+    data.insert(data.end(), text.begin(), text.end());
+}
+
+template <typename T>
+T Quantize(float value, float step)
+{
+    if (!std::isfinite(value))
+    {
+        return 0;
+    }
+
+    const auto quantized = std::round(value / step);
+    const auto minimum = static_cast<float>(std::numeric_limits<T>::min());
+    const auto maximum = static_cast<float>(std::numeric_limits<T>::max());
+    return static_cast<T>(std::min(std::max(quantized, minimum), maximum));
+}
+
+void AppendOrganizedSize(const PointCloud& pointCloud, std::ostringstream& header)
+{
+    if (pointCloud.height > 1)
+    {
+        header << "comment width " << pointCloud.width << "\n"
+               << "comment height " << pointCloud.height << "\n";
+    }
+}
+
+void EncodeBinaryPly(const PointCloud& pointCloud, std::vector<uint8_t>& data)
+{
+    const auto& points = pointCloud.points;
+
+    std::ostringstream header;
+    header << "ply\n"
+           << "format binary_little_endian 1.0\n";
+    AppendOrganizedSize(pointCloud, header);
+    header << "element vertex " << points.size() << "\n"
+           << "property float x\n"
+           << "property float y\n"
+           << "property float z\n"
+           << "property float intensity\n"
+           << "end_header\n";
+    AppendText(header.str(), data);
+
+    const auto* pointData = reinterpret_cast<const uint8_t*>(points.data());
+    data.insert(data.end(), pointData, pointData + points.size() * sizeof(PointXYZI));
+}
+
+void EncodeQuantizedPly(
+    const PointCloud& pointCloud, const PointCloudFormatSettings& settings, std::vector<uint8_t>& data)
+{
+    const auto& points = pointCloud.points;
+
+    if (settings.coordinateStepMm <= 0.0F || (settings.intensityAs8Bit && settings.intensityStep <= 0.0F))
+    {
+        throw std::invalid_argument("Quantization steps must be positive.");
+    }
+
+    // Readers restore the metric values by multiplying with the steps given in the comments
+    std::ostringstream header;
+    header << "ply\n"
+           << "format binary_little_endian 1.0\n"
+           << "comment coordinate_step_mm " << settings.coordinateStepMm << "\n";
+    if (settings.intensityAs8Bit)
+    {
+        header << "comment intensity_step " << settings.intensityStep << "\n";
+    }
+    AppendOrganizedSize(pointCloud, header);
+    header << "element vertex " << points.size() << "\n"
+           << "property short x\n"
+           << "property short y\n"
+           << "property short z\n"
+           << (settings.intensityAs8Bit ? "property uchar intensity\n" : "property ushort intensity\n")
+           << "end_header\n";
+    AppendText(header.str(), data);
+
+    const auto pointSize = 3 * sizeof(int16_t) + (settings.intensityAs8Bit ? sizeof(uint8_t) : sizeof(uint16_t));
+    const auto headerSize = data.size();
+    data.resize(headerSize + points.size() * pointSize);
+
+    auto* output = data.data() + headerSize;
+    for (const auto& point : points)
+    {
+        output = Append(output, Quantize<int16_t>(point.x, settings.coordinateStepMm));
+        output = Append(output, Quantize<int16_t>(point.y, settings.coordinateStepMm));
+        output = Append(output, Quantize<int16_t>(point.z, settings.coordinateStepMm));
+        output = settings.intensityAs8Bit ? Append(output, Quantize<uint8_t>(point.intensity, settings.intensityStep))
+                                          : Append(output, Quantize<uint16_t>(point.intensity, 1.0F));
+    }
+}
+
+void EncodeXyzi(const PointCloud& pointCloud, std::vector<uint8_t>& data)
+{
+    const auto& points = pointCloud.points;
+    if (pointCloud.width * pointCloud.height != points.size() || points.size() > UINT32_MAX)
+    {
+        throw std::invalid_argument("The point cloud size does not match its number of points.");
+    }
+
+    const XyziHeader header{ { 'X', 'Y', 'Z', 'I' }, 2, static_cast<uint32_t>(pointCloud.width),
+        static_cast<uint32_t>(pointCloud.height) };
+
+    data.resize(sizeof(header) + points.size() * sizeof(PointXYZI));
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), points.data(), points.size() * sizeof(PointXYZI));
+}
+
+} // namespace
+
+void EncodePointCloud(
+    const PointCloud& pointCloud, const PointCloudFormatSettings& settings, std::vector<uint8_t>& data)
+{
+    data.clear();
+
+    switch (settings.format)
+    {
+    case PointCloudFormat::BinaryPly:
+        EncodeBinaryPly(pointCloud, data);
+        return;
+    case PointCloudFormat::QuantizedPly:
+        EncodeQuantizedPly(pointCloud, settings, data);
+        return;
+    case PointCloudFormat::Xyzi:
+        EncodeXyzi(pointCloud, data);
+        return;
+    case PointCloudFormat::PointCloudWriter:
+        throw std::invalid_argument("Point clouds in the PointCloudWriter format can only be written by peak ICV.");
+    }
+
+    throw std::invalid_argument("Unknown point cloud format.");
+}
+
+std::string PointCloudFileExtension(PointCloudFormat format)
+{
+    return format == PointCloudFormat::Xyzi ? ".xyzi" : ".ply";
+}
+
+} // namespace nion
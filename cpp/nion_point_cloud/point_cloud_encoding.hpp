@@ -0,0 +1,73 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Project headers
+#include "point_cloud.hpp"
+
+namespace nion
+{
+
+enum class PointCloudFormat
+{
+    // PLY written by the PointCloudWriter of peak ICV, as by the Icv backend. Not supported by the encoders below.
+    PointCloudWriter,
+    // Binary little-endian PLY with float coordinates and intensity (16 bytes per point)
+    BinaryPly,
+    // Binary little-endian PLY with int16 coordinates and uint16 or uint8 intensity (7 or 8 bytes per point)
+    QuantizedPly,
+    // Interleaved float x, y, z and intensity after a 16 byte XyziHeader (16 bytes per point)
+    Xyzi
+};
+
+struct PointCloudFormatSettings
+{
+    PointCloudFormat format{ PointCloudFormat::BinaryPly };
+
+    // QuantizedPly: coordinates are stored as multiples of this step. With 1 mm, coordinates
+    // up to +-32.7 m can be stored, larger values are clamped. Invalid (NaN) values are stored as 0.
+    float coordinateStepMm{ 1.0F };
+
+    // QuantizedPly: store the intensity as uint8, divided by intensityStep, instead of uint16
+    bool intensityAs8Bit{ false };
+    float intensityStep{ 16.0F };
+};
+
+// Header of the Xyzi format, followed by width * height times four little-endian floats.
+// The size is stored like in PointCloud, so unorganized clouds have a height of 1.
+struct XyziHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+};
+
+// Encode the point cloud in the given format. The data is written into the given vector, which
+// only allocates if its capacity is exceeded. For organized clouds, the PLY formats store the size
+// in "comment width" and "comment height" header lines.
+void EncodePointCloud(
+    const PointCloud& pointCloud, const PointCloudFormatSettings& settings, std::vector<uint8_t>& data);
+
+// File extension including the dot, e.g. ".ply"
+std::string PointCloudFileExtension(PointCloudFormat format);
+
+} // namespace nion
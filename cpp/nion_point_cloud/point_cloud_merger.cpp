@@ -0,0 +1,289 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "point_cloud_merger.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Project headers
+#include "file_output.hpp"
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+
+void TransformPoints(
+    const PointXYZI* source, size_t numPoints, const RigidTransform& transform, PointXYZI* destination)
+{
+    const auto& r = transform.rotation;
+    const auto& t = transform.translation;
+
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+        const auto& p = source[i];
+        auto& q = destination[i];
+        q.x = r[0] * p.x + r[1] * p.y + r[2] * p.z + t[0];
+        q.y = r[3] * p.x + r[4] * p.y + r[5] * p.z + t[1];
+        q.z = r[6] * p.x + r[7] * p.y + r[8] * p.z + t[2];
+        q.intensity = p.intensity;
+    }
+}
+
+PointCloudMerger::PointCloudMerger(std::vector<RigidTransform> cameraTransforms, size_t maxNumPoints,
+    const PointCloudMergerSettings& settings, WorkerPool& workerPool, FileWriter& fileWriter,
+    const PointCloudFormatSettings& pointCloudFormat)
+    : m_cameraTransforms(std::move(cameraTransforms))
+    , m_pointCloudFormat(pointCloudFormat)
+    , m_workerPool(workerPool)
+    , m_workerClient(workerPool.AddClient())
+    , m_fileWriter(fileWriter)
+    , m_synchronizer(m_cameraTransforms.size(), settings.toleranceNs, settings.maxPendingFrames)
+{
+    if (m_cameraTransforms.empty())
+    {
+        throw std::invalid_argument("No cameras to merge.");
+    }
+
+    for (size_t i = 0; i < std::max<size_t>(settings.numPointClouds, 1); ++i)
+    {
+        m_pointClouds.push_back(std::make_unique<PointCloud>());
+        m_pointClouds.back()->points.reserve(maxNumPoints);
+        m_freePointClouds.push_back(m_pointClouds.back().get());
+    }
+}
+
+PointCloudMerger::~PointCloudMerger()
+{
+    auto frames = m_synchronizer.Flush();
+    Release(frames);
+    m_workerPool.RemoveClient(m_workerClient);
+}
+
+void PointCloudMerger::Add(
+    size_t camera, uint64_t deviceTimestampNs, const PointCloud& pointCloud, std::function<void()> release)
+{
+    SynchronizedFrame frame;
+    frame.camera = camera;
+    frame.timestampNs = deviceTimestampNs;
+    frame.pointCloud = &pointCloud;
+    frame.release = std::move(release);
+
+    FrameSynchronizer::Output output;
+    PointCloud* mergedPointCloud = nullptr;
+    size_t slotIndex = 0;
+
+    try
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        output = m_synchronizer.Add(std::move(frame));
+
+        if (!output.slot.empty())
+        {
+            slotIndex = m_numSlots++;
+            if (m_freePointClouds.empty())
+            {
+                ++m_numDroppedSlots;
+                std::move(output.slot.begin(), output.slot.end(), std::back_inserter(output.unmatchedFrames));
+                output.slot.clear();
+            }
+            else
+            {
+                mergedPointCloud = m_freePointClouds.back();
+                m_freePointClouds.pop_back();
+            }
+        }
+    }
+    catch (...)
+    {
+        SetError(std::current_exception());
+    }
+
+    Release(output.unmatchedFrames);
+
+    if (mergedPointCloud)
+    {
+        StartMerge(std::move(output.slot), mergedPointCloud, slotIndex);
+    }
+}
+
+void PointCloudMerger::Finish()
+{
+    std::vector<SynchronizedFrame> frames;
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        frames = m_synchronizer.Flush();
+    }
+    Release(frames);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_mergeFinished.wait(lock, [this] {
+        return m_freePointClouds.size() == m_pointClouds.size();
+    });
+
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+size_t PointCloudMerger::NumMergedPointClouds() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numMergedPointClouds;
+}
+
+size_t PointCloudMerger::NumUnmatchedFrames() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_synchronizer.NumUnmatchedFrames();
+}
+
+size_t PointCloudMerger::NumDroppedSlots() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numDroppedSlots;
+}
+
+void PointCloudMerger::StartMerge(std::vector<SynchronizedFrame> slot, PointCloud* pointCloud, size_t slotIndex)
+{
+    auto merge = std::make_shared<Merge>();
+    merge->slotIndex = slotIndex;
+    merge->pointCloud = pointCloud;
+    merge->frames = std::move(slot);
+    merge->numPendingFrames = merge->frames.size();
+
+    // Every point cloud gets its own range of the merged point cloud, so they can be copied in parallel
+    size_t numPoints = 0;
+    for (const auto& frame : merge->frames)
+    {
+        merge->offsets.push_back(numPoints);
+        numPoints += frame.pointCloud->points.size();
+    }
+
+    try
+    {
+        pointCloud->points.resize(numPoints);
+        pointCloud->width = numPoints;
+        pointCloud->height = 1;
+    }
+    catch (...)
+    {
+        SetError(std::current_exception());
+        Release(merge->frames);
+        FinishMerge(pointCloud);
+        return;
+    }
+
+    for (size_t i = 0; i < merge->frames.size(); ++i)
+    {
+        m_workerPool.Submit(m_workerClient, [this, merge, i] {
+            CopyFrame(merge, i);
+        });
+    }
+}
+
+void PointCloudMerger::CopyFrame(const std::shared_ptr<Merge>& merge, size_t i)
+{
+    auto& frame = merge->frames[i];
+
+    {
+        const ScopedLatency latency(LatencyStage::PointCloudMerge);
+        const auto& points = frame.pointCloud->points;
+        TransformPoints(points.data(), points.size(), m_cameraTransforms.at(frame.camera),
+            merge->pointCloud->points.data() + merge->offsets[i]);
+    }
+
+    // The point cloud of the camera is no longer used, so its frame can be finished right away
+    frame.release();
+    frame.release = nullptr;
+
+    if (--merge->numPendingFrames == 0)
+    {
+        WriteMerge(merge);
+    }
+}
+
+void PointCloudMerger::WriteMerge(const std::shared_ptr<Merge>& merge)
+{
+    auto* pointCloud = merge->pointCloud;
+    auto isSubmitted = false;
+
+    try
+    {
+        const auto fileSuffix = "_merged_" + std::to_string(merge->slotIndex);
+
+        FileWriteJob job;
+        job.writes.emplace_back([this, pointCloud, fileSuffix] {
+            WritePointCloudToFile(*pointCloud, fileSuffix, m_pointCloudFormat);
+        });
+        job.onFinished = [this, pointCloud] {
+            FinishMerge(pointCloud);
+        };
+
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_numMergedPointClouds;
+        }
+
+        // onFinished is called in any case
+        isSubmitted = true;
+        m_fileWriter.Submit(std::move(job));
+    }
+    catch (...)
+    {
+        SetError(std::current_exception());
+
+        if (!isSubmitted)
+        {
+            FinishMerge(pointCloud);
+        }
+    }
+}
+
+void PointCloudMerger::FinishMerge(PointCloud* pointCloud)
+{
+    // Notified with the lock held, as Finish() may return as soon as the last point cloud is free
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_freePointClouds.push_back(pointCloud);
+    m_mergeFinished.notify_all();
+}
+
+void PointCloudMerger::Release(std::vector<SynchronizedFrame>& frames)
+{
+    for (auto& frame : frames)
+    {
+        if (frame.release)
+        {
+            frame.release();
+            frame.release = nullptr;
+        }
+    }
+}
+
+void PointCloudMerger::SetError(std::exception_ptr error)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_error)
+    {
+        m_error = std::move(error);
+    }
+}
+
+} // namespace nion
@@ -0,0 +1,142 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Project headers
+#include "file_writer.hpp"
+#include "frame_synchronizer.hpp"
+#include "point_cloud.hpp"
+#include "point_cloud_encoding.hpp"
+#include "worker_pool.hpp"
+
+namespace nion
+{
+
+// Rigid transform from camera coordinates into a common coordinate system: p' = rotation * p + translation.
+// The rotation matrix is stored row by row, the translation is in millimeters.
+struct RigidTransform
+{
+    std::array<float, 9> rotation{ 1.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F };
+    std::array<float, 3> translation{ 0.0F, 0.0F, 0.0F };
+};
+
+// Extrinsic pose of the camera with the given serial number
+struct CameraPose
+{
+    std::string serialNumber;
+    RigidTransform transform;
+};
+
+// Transform all points and write them to the destination, which must have the same size as the source.
+// Invalid points with NaN coordinates stay NaN, the intensity is copied.
+void TransformPoints(
+    const PointXYZI* source, size_t numPoints, const RigidTransform& transform, PointXYZI* destination);
+
+struct PointCloudMergerSettings
+{
+    // Maximum difference between the device timestamps of the frames of one slot
+    uint64_t toleranceNs{ 1000000 };
+
+    // Frames of a camera waiting for the frames of the other cameras. Each of them holds the results of a frame
+    // in the pipeline of its camera, so this has to be smaller than the number of frames in flight.
+    size_t maxPendingFrames{ 2 };
+
+    // Merged point clouds that are filled or written at the same time. Slots beyond that are dropped.
+    size_t numPointClouds{ 4 };
+};
+
+// Merges the point clouds of several cameras into one unorganized point cloud per time slot, see FrameSynchronizer.
+// Every point cloud is transformed by the pose of its camera directly into its part of the merged point cloud, so
+// its points are copied only once, and the point clouds of a slot are copied in parallel on the worker pool. The
+// merged point clouds are preallocated and written by the file writer as point_cloud_xyzi_merged_<slot>.
+class PointCloudMerger
+{
+public:
+    // One transform per camera. maxNumPoints is the total number of points of all cameras, e.g. the sum of their
+    // image sizes. The worker pool and the file writer must outlive the merger.
+    PointCloudMerger(std::vector<RigidTransform> cameraTransforms, size_t maxNumPoints,
+        const PointCloudMergerSettings& settings, WorkerPool& workerPool, FileWriter& fileWriter,
+        const PointCloudFormatSettings& pointCloudFormat);
+
+    // Releases all frames that are still waiting and removes the merger from the worker pool
+    ~PointCloudMerger();
+
+    PointCloudMerger(const PointCloudMerger&) = delete;
+    PointCloudMerger& operator=(const PointCloudMerger&) = delete;
+    PointCloudMerger(PointCloudMerger&&) = delete;
+    PointCloudMerger& operator=(PointCloudMerger&&) = delete;
+
+    // Hand over the point cloud of a camera. release is called exactly once, as soon as the point cloud is no
+    // longer used. Can be called from any thread and does not throw, errors are rethrown by Finish().
+    void Add(size_t camera, uint64_t deviceTimestampNs, const PointCloud& pointCloud, std::function<void()> release);
+
+    // Release the frames that are still waiting for other cameras and wait until all merged point clouds are
+    // written or dropped. No frames must be added anymore. Rethrows the first error that occurred while merging.
+    void Finish();
+
+    size_t NumMergedPointClouds() const;
+    size_t NumUnmatchedFrames() const;
+    size_t NumDroppedSlots() const;
+
+private:
+    struct Merge
+    {
+        size_t slotIndex{};
+        PointCloud* pointCloud{};
+        std::vector<SynchronizedFrame> frames{};
+        std::vector<size_t> offsets{};
+        std::atomic<size_t> numPendingFrames{ 0 };
+    };
+
+    void StartMerge(std::vector<SynchronizedFrame> slot, PointCloud* pointCloud, size_t slotIndex);
+    void CopyFrame(const std::shared_ptr<Merge>& merge, size_t i);
+    void WriteMerge(const std::shared_ptr<Merge>& merge);
+    void FinishMerge(PointCloud* pointCloud);
+    void Release(std::vector<SynchronizedFrame>& frames);
+    void SetError(std::exception_ptr error);
+
+    std::vector<RigidTransform> m_cameraTransforms;
+    PointCloudFormatSettings m_pointCloudFormat;
+
+    WorkerPool& m_workerPool;
+    size_t m_workerClient;
+    FileWriter& m_fileWriter;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_mergeFinished;
+    FrameSynchronizer m_synchronizer;
+    std::vector<std::unique_ptr<PointCloud>> m_pointClouds;
+    std::vector<PointCloud*> m_freePointClouds;
+    size_t m_numSlots{};
+    size_t m_numMergedPointClouds{};
+    size_t m_numDroppedSlots{};
+    std::exception_ptr m_error{};
+};
+
+} // namespace nion
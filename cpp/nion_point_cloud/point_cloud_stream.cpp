@@ -0,0 +1,356 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "point_cloud_stream.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#    include <winsock2.h>
+#    include <ws2tcpip.h>
+#else
+#    include <cerrno>
+#    include <netinet/in.h>
+#    include <netinet/tcp.h>
+#    include <poll.h>
+#    include <sys/socket.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+static_assert(sizeof(PointCloudStreamHeader) == 48, "PointCloudStreamHeader must not contain padding.");
+
+// How often the accept thread checks whether the stream is closed
+constexpr int acceptPollIntervalMs = 100;
+
+// Memory sent as one piece of a frame
+struct SendBuffer
+{
+    const void* data;
+    size_t size;
+};
+
+#ifdef _WIN32
+constexpr NativeSocket invalidSocket = INVALID_SOCKET;
+
+void CloseSocket(NativeSocket socket)
+{
+    closesocket(socket);
+}
+
+bool WaitUntilReadable(NativeSocket socket, int timeoutMs)
+{
+    WSAPOLLFD pollFd{ socket, POLLRDNORM, 0 };
+    return WSAPoll(&pollFd, 1, timeoutMs) > 0;
+}
+
+void SetSendTimeout(NativeSocket socket, uint32_t timeoutMs)
+{
+    const DWORD timeout = timeoutMs;
+    setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+}
+
+// A blocking WSASend returns once all buffers are sent or an error occurred
+bool SendAll(NativeSocket socket, const SendBuffer* buffers, size_t numBuffers)
+{
+    WSABUF wsaBuffers[3];
+    size_t totalSize = 0;
+    for (size_t i = 0; i < numBuffers; ++i)
+    {
+        wsaBuffers[i].buf = static_cast<char*>(const_cast<void*>(buffers[i].data));
+        wsaBuffers[i].len = static_cast<ULONG>(buffers[i].size);
+        totalSize += buffers[i].size;
+    }
+
+    DWORD numSent = 0;
+    return WSASend(socket, wsaBuffers, static_cast<DWORD>(numBuffers), &numSent, 0, nullptr, nullptr) == 0
+        && numSent == totalSize;
+}
+#else
+constexpr NativeSocket invalidSocket = -1;
+
+void CloseSocket(NativeSocket socket)
+{
+    close(socket);
+}
+
+bool WaitUntilReadable(NativeSocket socket, int timeoutMs)
+{
+    pollfd pollFd{ socket, POLLIN, 0 };
+    return poll(&pollFd, 1, timeoutMs) > 0;
+}
+
+void SetSendTimeout(NativeSocket socket, uint32_t timeoutMs)
+{
+    timeval timeout{};
+    timeout.tv_sec = static_cast<time_t>(timeoutMs / 1000);
+    timeout.tv_usec = static_cast<suseconds_t>((timeoutMs % 1000) * 1000);
+    setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+// sendmsg may send only a part of the buffers, in which case the rest is sent by further calls
+bool SendAll(NativeSocket socket, const SendBuffer* buffers, size_t numBuffers)
+{
+    iovec vectors[3];
+    for (size_t i = 0; i < numBuffers; ++i)
+    {
+        vectors[i].iov_base = const_cast<void*>(buffers[i].data);
+        vectors[i].iov_len = buffers[i].size;
+    }
+
+    auto* remaining = vectors;
+    auto numRemaining = numBuffers;
+    while (numRemaining > 0)
+    {
+        msghdr message{};
+        message.msg_iov = remaining;
+        message.msg_iovlen = numRemaining;
+
+        // MSG_NOSIGNAL: A closed connection is reported as an error instead of raising SIGPIPE
+        const auto numSent = sendmsg(socket, &message, MSG_NOSIGNAL);
+        if (numSent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        auto numBytes = static_cast<size_t>(numSent);
+        while (numRemaining > 0 && numBytes >= remaining->iov_len)
+        {
+            numBytes -= remaining->iov_len;
+            ++remaining;
+            --numRemaining;
+        }
+
+        if (numRemaining > 0)
+        {
+            remaining->iov_base = static_cast<uint8_t*>(remaining->iov_base) + numBytes;
+            remaining->iov_len -= numBytes;
+        }
+    }
+
+    return true;
+}
+#endif
+
+} // namespace
+
+PointCloudStream::PointCloudStream(const PointCloudStreamSettings& settings)
+    : m_settings(settings)
+{
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        throw std::runtime_error("Failed to initialize Windows Sockets.");
+    }
+#endif
+
+    m_listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (m_listenSocket == invalidSocket)
+    {
+        throw std::runtime_error("Failed to create the point cloud stream socket.");
+    }
+
+    const int reuseAddress = 1;
+    setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuseAddress),
+        sizeof(reuseAddress));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(settings.port);
+
+    if (bind(m_listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || listen(m_listenSocket, static_cast<int>(settings.maxClients)) != 0)
+    {
+        CloseSocket(m_listenSocket);
+        throw std::runtime_error(
+            "Failed to open port " + std::to_string(settings.port) + " for the point cloud stream.");
+    }
+
+    m_acceptThread = std::thread(&PointCloudStream::AcceptClients, this);
+}
+
+PointCloudStream::~PointCloudStream()
+{
+    m_isRunning = false;
+    m_acceptThread.join();
+
+    CloseSocket(m_listenSocket);
+    for (const auto client : m_clients)
+    {
+        CloseSocket(client);
+    }
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void PointCloudStream::Send(
+    uint64_t frameId, uint64_t timestampNs, const PointCloud& pointCloud, PlaneView<const uint8_t> depthValid)
+{
+    const ScopedLatency latency(LatencyStage::SendPointCloud);
+
+    const auto numPoints = pointCloud.points.size();
+    if (numPoints > UINT32_MAX / sizeof(PointXYZI))
+    {
+        throw std::invalid_argument("The point cloud is too large to be streamed.");
+    }
+
+    // The clients are sent to without m_mutex, so a slow client does not block the accept thread for up to the send
+    // timeout. Clients accepted in the meantime start with the next frame.
+    const std::lock_guard<std::mutex> sendLock(m_sendMutex);
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_sendClients = m_clients;
+    }
+    if (m_sendClients.empty())
+    {
+        return;
+    }
+
+    // The pixels of an organized point cloud are its points
+    const auto isOrganized = pointCloud.height > 1 && depthValid.width == pointCloud.width
+        && depthValid.height == pointCloud.height && numPoints == pointCloud.width * pointCloud.height;
+    const auto hasValidityMask = m_settings.validityMask && isOrganized;
+
+    if (hasValidityMask)
+    {
+        m_validityMask.assign((numPoints + 7) / 8, 0);
+        size_t i = 0;
+        for (size_t y = 0; y < depthValid.height; ++y)
+        {
+            const auto* validRow = depthValid.Row(y);
+            for (size_t x = 0; x < depthValid.width; ++x, ++i)
+            {
+                m_validityMask[i / 8] |= static_cast<uint8_t>((validRow[x] != 0 ? 1 : 0) << (i % 8));
+            }
+        }
+    }
+
+    PointCloudStreamHeader header{};
+    std::memcpy(header.magic, "NPCS", sizeof(header.magic));
+    header.version = 1;
+    header.headerSize = sizeof(PointCloudStreamHeader);
+    header.frameId = frameId;
+    header.timestampNs = timestampNs;
+    header.width = static_cast<uint32_t>(pointCloud.width);
+    header.height = static_cast<uint32_t>(pointCloud.height);
+    header.numPoints = static_cast<uint32_t>(numPoints);
+    header.pointLayout = static_cast<uint16_t>(StreamPointLayout::XyziFloat32);
+    header.flags = hasValidityMask ? StreamFrameHasValidityMask : 0;
+    header.pointDataSize = static_cast<uint32_t>(numPoints * sizeof(PointXYZI));
+    header.validityMaskSize = hasValidityMask ? static_cast<uint32_t>(m_validityMask.size()) : 0;
+
+    const SendBuffer buffers[]{ { &header, sizeof(header) }, { pointCloud.points.data(), header.pointDataSize },
+        { m_validityMask.data(), header.validityMaskSize } };
+    const size_t numBuffers = hasValidityMask ? 3 : 2;
+
+    m_failedClients.clear();
+    for (const auto client : m_sendClients)
+    {
+        if (!SendAll(client, buffers, numBuffers))
+        {
+            m_failedClients.push_back(client);
+        }
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        const auto failedClients = std::remove_if(m_clients.begin(), m_clients.end(), [&](NativeSocket client) {
+            return std::find(m_failedClients.begin(), m_failedClients.end(), client) != m_failedClients.end();
+        });
+        m_clients.erase(failedClients, m_clients.end());
+        m_numDisconnectedClients += m_failedClients.size();
+        ++m_numSentFrames;
+    }
+
+    // Closed after they are removed, so the accept thread cannot get the same socket for a new client before
+    for (const auto client : m_failedClients)
+    {
+        CloseSocket(client);
+    }
+}
+
+size_t PointCloudStream::NumClients() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_clients.size();
+}
+
+uint64_t PointCloudStream::NumSentFrames() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numSentFrames;
+}
+
+uint64_t PointCloudStream::NumDisconnectedClients() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numDisconnectedClients;
+}
+
+void PointCloudStream::AcceptClients()
+{
+    while (m_isRunning)
+    {
+        if (!WaitUntilReadable(m_listenSocket, acceptPollIntervalMs))
+        {
+            continue;
+        }
+
+        const auto client = accept(m_listenSocket, nullptr, nullptr);
+        if (client == invalidSocket)
+        {
+            continue;
+        }
+
+        // Frames are sent as soon as they are complete instead of being coalesced
+        const int noDelay = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        SetSendTimeout(client, m_settings.sendTimeoutMs);
+
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_clients.size() >= m_settings.maxClients)
+        {
+            CloseSocket(client);
+            continue;
+        }
+
+        m_clients.push_back(client);
+        std::cout << ("Point cloud stream client connected (" + std::to_string(m_clients.size()) + ").\n");
+    }
+}
+
+} // namespace nion
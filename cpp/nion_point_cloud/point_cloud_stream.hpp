@@ -0,0 +1,134 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "image_plane.hpp"
+#include "point_cloud.hpp"
+
+namespace nion
+{
+
+#ifdef _WIN32
+using NativeSocket = uintptr_t;
+#else
+using NativeSocket = int;
+#endif
+
+// Layout of the points that follow the header
+enum class StreamPointLayout : uint16_t
+{
+    // x, y, z in millimeters and the intensity as float, 16 bytes per point, see PointXYZI
+    XyziFloat32 = 1
+};
+
+enum StreamFrameFlags : uint16_t
+{
+    // A validity bitmask with one bit per point follows the points
+    StreamFrameHasValidityMask = 1
+};
+
+// Header of every frame sent by the PointCloudStream. It is followed by pointDataSize bytes of points and
+// validityMaskSize bytes of the validity bitmask, in which bit i % 8 of byte i / 8 is set if point i is valid.
+// The points are sent from memory as they are, so all values are in the byte order of the host, which is
+// little-endian on all platforms supported by IDS peak. Clients on big-endian hosts have to swap them.
+struct PointCloudStreamHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t headerSize;
+    uint64_t frameId;
+    uint64_t timestampNs;
+    uint32_t width;
+    uint32_t height;
+    uint32_t numPoints;
+    uint16_t pointLayout;
+    uint16_t flags;
+    uint32_t pointDataSize;
+    uint32_t validityMaskSize;
+};
+
+struct PointCloudStreamSettings
+{
+    // TCP port on which the clients connect, on all network interfaces
+    uint16_t port{ 5600 };
+    size_t maxClients{ 4 };
+
+    // Send the validity bitmask with organized point clouds. Unorganized point clouds only contain valid points.
+    bool validityMask{ true };
+
+    // Clients that do not take a frame within this time are disconnected, so they cannot stall the output
+    uint32_t sendTimeoutMs{ 1000 };
+};
+
+// Sends point clouds over TCP to all connected clients, e.g. to a second process that would otherwise read the
+// point cloud files. The points are sent directly from the memory of the point cloud together with the header and
+// the validity bitmask in a single gathering system call, without building a message. Clients are accepted on a
+// background thread and may connect and disconnect at any time.
+class PointCloudStream
+{
+public:
+    // Throws a std::runtime_error if the port cannot be opened
+    explicit PointCloudStream(const PointCloudStreamSettings& settings);
+
+    ~PointCloudStream();
+
+    PointCloudStream(const PointCloudStream&) = delete;
+    PointCloudStream& operator=(const PointCloudStream&) = delete;
+    PointCloudStream(PointCloudStream&&) = delete;
+    PointCloudStream& operator=(PointCloudStream&&) = delete;
+
+    // Send the point cloud to all connected clients, one frame after another. depthValid is the validity of the
+    // pixels of an organized point cloud and ignored otherwise. Clients that fail are disconnected. Thread-safe,
+    // concurrent calls wait for the frame that is being sent, but clients can connect in the meantime.
+    void Send(
+        uint64_t frameId, uint64_t timestampNs, const PointCloud& pointCloud, PlaneView<const uint8_t> depthValid);
+
+    size_t NumClients() const;
+    uint64_t NumSentFrames() const;
+    uint64_t NumDisconnectedClients() const;
+
+private:
+    void AcceptClients();
+
+    PointCloudStreamSettings m_settings;
+    NativeSocket m_listenSocket;
+
+    // Held while a frame is sent, so the frames of concurrent calls are not interleaved
+    std::mutex m_sendMutex;
+    std::vector<NativeSocket> m_sendClients;
+    std::vector<NativeSocket> m_failedClients;
+    std::vector<uint8_t> m_validityMask;
+
+    // Only held to access the clients and the counters, never while sending
+    mutable std::mutex m_mutex;
+    std::vector<NativeSocket> m_clients;
+    uint64_t m_numSentFrames{};
+    uint64_t m_numDisconnectedClients{};
+
+    std::atomic<bool> m_isRunning{ true };
+    std::thread m_acceptThread;
+};
+
+} // namespace nion
@@ -0,0 +1,217 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "processing.hpp"
+
+// Standard headers
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+// Whether the PFNC value of a pixel format describes one channel with 16 bits per pixel, e.g. Coord3D_C16 or Mono12
+// unpacked into 16 bits. Bits 24 to 27 are 1 for single-channel (mono) formats, bits 16 to 23 hold the bits per pixel.
+bool IsSingleChannel16Bit(uint64_t pixelFormat)
+{
+    return ((pixelFormat >> 24) & 0x0F) == 0x01 && ((pixelFormat >> 16) & 0xFF) == 16;
+}
+
+PlaneView<const uint16_t> ViewBufferPart(const peak::core::BufferPart& part, const char* description)
+{
+    const auto pixelFormat = part.PixelFormat();
+    if (!IsSingleChannel16Bit(pixelFormat))
+    {
+        std::ostringstream message;
+        message << description << " has the pixel format 0x" << std::hex << std::uppercase << pixelFormat
+                << " instead of one channel with 16 bits per pixel.";
+        throw std::runtime_error(message.str());
+    }
+
+    const auto width = part.Width();
+    const auto height = part.Height();
+    if (width == 0 || height == 0 || part.Size() < width * height * sizeof(uint16_t))
+    {
+        throw std::runtime_error(std::string(description) + " is smaller than expected for its pixel format.");
+    }
+
+    return { static_cast<const uint16_t*>(part.BasePtr()), width, height, width };
+}
+
+} // namespace
+
+PlaneView<const uint16_t> ViewRawDepthMap(const peak::core::BufferPart& depthMapPart)
+{
+    return ViewBufferPart(depthMapPart, "Depth map buffer part");
+}
+
+PlaneView<const uint16_t> ViewRawIntensity(const peak::core::BufferPart& intensityPart)
+{
+    return ViewBufferPart(intensityPart, "Intensity buffer part");
+}
+
+OutputStages GetOutputStages(OutputProfile profile, ProcessingBackend backend)
+{
+    OutputStages stages;
+
+    switch (profile)
+    {
+    case OutputProfile::Full:
+        stages.processDepthMap = true;
+        stages.processIntensity = true;
+        stages.createPointCloud = true;
+        stages.writeDepthMap = true;
+        stages.writeIntensity = true;
+        stages.writePointCloud = true;
+        break;
+    case OutputProfile::DepthMap:
+        stages.processDepthMap = true;
+        stages.writeDepthMap = true;
+        break;
+    case OutputProfile::PointCloud:
+        stages.processDepthMap = true;
+        stages.processIntensity = (backend == ProcessingBackend::Icv);
+        stages.createPointCloud = true;
+        stages.writePointCloud = true;
+        break;
+    case OutputProfile::Intensity:
+        stages.processIntensity = true;
+        stages.writeIntensity = true;
+        break;
+    }
+
+    return stages;
+}
+
+OutputStages GetOutputStages(const ProcessingParameters& parameters)
+{
+    auto stages = GetOutputStages(parameters.outputProfile, parameters.backend);
+    if (!parameters.writeFrameFiles)
+    {
+        stages.writeDepthMap = false;
+        stages.writeIntensity = false;
+        stages.writePointCloud = false;
+    }
+
+    return stages;
+}
+
+LensModel CreateLensModel(const peak::icv::CalibrationParameters& calibration, const ImageGeometry& geometry)
+{
+    // The factory calibration refers to the full sensor resolution without binning
+    const auto intrinsics = calibration.IntrinsicParameters();
+
+    const auto binningX = static_cast<double>(geometry.binningHorizontal);
+    const auto binningY = static_cast<double>(geometry.binningVertical);
+
+    LensModel model;
+    model.fx = intrinsics.fx / binningX;
+    model.fy = intrinsics.fy / binningY;
+    model.cx = intrinsics.cx / binningX - static_cast<double>(geometry.offsetX);
+    model.cy = intrinsics.cy / binningY - static_cast<double>(geometry.offsetY);
+    model.k1 = intrinsics.k1;
+    model.k2 = intrinsics.k2;
+    model.k3 = intrinsics.k3;
+    model.k4 = intrinsics.k4;
+    model.k5 = intrinsics.k5;
+    model.k6 = intrinsics.k6;
+    model.p1 = intrinsics.p1;
+    model.p2 = intrinsics.p2;
+
+    return model;
+}
+
+peak::common::Metadata CreateImageMetadata(const ImageGeometry& geometry)
+{
+    peak::common::Metadata metadata;
+
+    metadata.SetValueByKey<peak::common::MetadataKey::BinningHorizontal>(
+        static_cast<int64_t>(geometry.binningHorizontal));
+    metadata.SetValueByKey<peak::common::MetadataKey::BinningVertical>(static_cast<int64_t>(geometry.binningVertical));
+
+    peak::common::RectangleU roi{ geometry.offsetX, geometry.offsetY, geometry.width, geometry.height };
+
+    metadata.SetValueByKey<peak::common::MetadataKey::Roi>(roi);
+    return metadata;
+}
+
+peak::icv::Image ProcessDepthMap(const peak::core::BufferPart& depthMapPart, peak::icv::Undistortion& undistortion,
+    const ProcessingParameters& parameters)
+{
+    return ProcessDepthMap(depthMapPart.ToImageView(), undistortion, parameters);
+}
+
+peak::icv::Image ProcessDepthMap(const peak::common::ImageView& rawDepthView, peak::icv::Undistortion& undistortion,
+    const ProcessingParameters& parameters)
+{
+    // Create image from raw depth buffer and attach metadata
+    peak::icv::Image rawDepth(rawDepthView);
+    rawDepth.SetMetadata(parameters.metadata);
+
+    // Convert depth values to floating-point metric coordinates
+    ScopedLatency conversionLatency(LatencyStage::DepthConversion);
+    auto depth = rawDepth.ConvertPixelFormatWithFactor(
+        peak::common::PixelFormat::Coord3D_C32f, parameters.scaleFactor);
+    conversionLatency.Stop();
+
+    // Remove invalid depth pixels and get region of only valid pixels
+    {
+        const ScopedLatency latency(LatencyStage::DepthValidityThreshold);
+        peak::icv::ThresholdF validPixelThreshold{ parameters.validDepthInterval };
+
+        auto validPixelsRegion = validPixelThreshold.Process(depth);
+
+        depth.SetRegion(validPixelsRegion);
+    }
+
+    // Undistort the depth map
+    ScopedLatency undistortionLatency(LatencyStage::DepthUndistortion);
+    auto undistortedDepth = undistortion.Process(depth);
+    undistortionLatency.Stop();
+
+    // Optional distance-based filtering
+    if (parameters.filterDistanceEnabled)
+    {
+        const ScopedLatency latency(LatencyStage::DistanceFilter);
+        peak::icv::ThresholdF distanceFilter(parameters.filterDistanceIntervalMm);
+        undistortedDepth.SetRegion(distanceFilter.Process(undistortedDepth));
+    }
+
+    return undistortedDepth;
+}
+
+peak::icv::Image ProcessIntensity(const peak::core::BufferPart& intensityPart, peak::icv::Undistortion& undistortion,
+    const ProcessingParameters& parameters)
+{
+    return ProcessIntensity(intensityPart.ToImageView(), undistortion, parameters);
+}
+
+peak::icv::Image ProcessIntensity(const peak::common::ImageView& rawIntensity, peak::icv::Undistortion& undistortion,
+    const ProcessingParameters& parameters)
+{
+    peak::icv::Image intensity(rawIntensity);
+    intensity.SetMetadata(parameters.metadata);
+
+    const ScopedLatency latency(LatencyStage::IntensityUndistortion);
+    return undistortion.Process(intensity);
+}
+
+} // namespace nion
@@ -0,0 +1,147 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <limits>
+
+// IDS peak headers
+#include <peak/peak.hpp>
+#include <peak_icv/peak_icv.hpp>
+
+// Project headers
+#include "image_plane.hpp"
+#include "lens_model.hpp"
+#include "temporal_filter.hpp"
+
+namespace nion
+{
+
+// Implementation used to process the frames
+enum class ProcessingBackend
+{
+    // peak ICV functions, every processing step creates a new image
+    Icv,
+    // Reads the buffer data in place and writes into preallocated images, without heap allocations per frame
+    Direct
+};
+
+// Results of a frame that are written to file. Processing steps, buffer parts and device components that are not
+// required for them are skipped.
+enum class OutputProfile
+{
+    // Depth map, intensity image and point cloud
+    Full,
+    // Only the metric depth map
+    DepthMap,
+    // Only the point cloud. The direct backend skips the intensity image, all points have intensity 0.
+    PointCloud,
+    // Only the undistorted intensity image
+    Intensity
+};
+
+// Processing steps and files of an output profile
+struct OutputStages
+{
+    bool processDepthMap{};
+    bool processIntensity{};
+    bool createPointCloud{};
+    bool writeDepthMap{};
+    bool writeIntensity{};
+    bool writePointCloud{};
+};
+
+// The ICV backend always requires the intensity image to create a point cloud
+OutputStages GetOutputStages(OutputProfile profile, ProcessingBackend backend);
+
+// OpenCL device that processes the frames of the direct backend, see OpenClProcessor
+struct OpenClSettings
+{
+    bool enabled{};
+
+    // Index of the platform and of the device within the platform, in the order reported by the OpenCL runtime
+    size_t platformIndex{};
+    size_t deviceIndex{};
+};
+
+// Settings and values read from the device once before the acquisition, required to process every frame
+struct ProcessingParameters
+{
+    ProcessingBackend backend{ ProcessingBackend::Icv };
+    OutputProfile outputProfile{ OutputProfile::Full };
+    float scaleFactor{};
+    peak::common::IntervalF validDepthInterval{};
+    bool filterDistanceEnabled{};
+    peak::common::IntervalF filterDistanceIntervalMm{};
+    peak::common::Metadata metadata{};
+    ImageGeometry geometry{};
+
+    // Write the results of every frame into separate files. Disabled e.g. if they are only streamed or written into
+    // a sequence file.
+    bool writeFrameFiles{ true };
+
+    // Direct backend: copy the raw images out of the buffer, so it can be queued before the frame is processed
+    bool copyRawFrames{};
+
+    // Direct backend: create organized point clouds with invalidPointValue for invalid pixels
+    bool organizedPointCloud{};
+    float invalidPointValue{ std::numeric_limits<float>::quiet_NaN() };
+
+    // Direct backend: average the points on a voxel grid with this leaf size in millimeters, 0 to disable.
+    // Downsampled point clouds are always unorganized.
+    float voxelLeafSizeMm{};
+
+    // Direct backend: average every depth map with the previous ones of the camera
+    TemporalFilterSettings temporalFilter{};
+
+    // Direct backend: only process the pixels of this region of the undistorted images, empty for all pixels.
+    // Pixels outside of it are invalid.
+    PixelRegion workArea{};
+
+    // Direct backend: process the frames on an OpenCL device instead of the CPU. Not supported with the temporal
+    // filter.
+    OpenClSettings openCl{};
+};
+
+// Output stages of the output profile of the parameters, without files if they are disabled
+OutputStages GetOutputStages(const ProcessingParameters& parameters);
+
+// Create the lens model from the factory calibration, adapted to the binning and ROI of the images
+LensModel CreateLensModel(const peak::icv::CalibrationParameters& calibration, const ImageGeometry& geometry);
+
+// Create a metadata object containing binning and ROI information.
+// The metadata is required for correct undistortion of images.
+peak::common::Metadata CreateImageMetadata(const ImageGeometry& geometry);
+
+// View the raw depth map or intensity image of a buffer part in place, without copying it. Throws unless the pixel
+// format of the part has one channel with 16 bits per pixel, or if the part has less data than its size requires.
+PlaneView<const uint16_t> ViewRawDepthMap(const peak::core::BufferPart& depthMapPart);
+PlaneView<const uint16_t> ViewRawIntensity(const peak::core::BufferPart& intensityPart);
+
+// Convert the raw depth map into an undistorted, metric and filtered depth map
+peak::icv::Image ProcessDepthMap(const peak::core::BufferPart& depthMapPart, peak::icv::Undistortion& undistortion,
+    const ProcessingParameters& parameters);
+peak::icv::Image ProcessDepthMap(const peak::common::ImageView& rawDepth, peak::icv::Undistortion& undistortion,
+    const ProcessingParameters& parameters);
+
+// Undistort the intensity image
+peak::icv::Image ProcessIntensity(const peak::core::BufferPart& intensityPart, peak::icv::Undistortion& undistortion,
+    const ProcessingParameters& parameters);
+peak::icv::Image ProcessIntensity(const peak::common::ImageView& rawIntensity, peak::icv::Undistortion& undistortion,
+    const ProcessingParameters& parameters);
+
+} // namespace nion
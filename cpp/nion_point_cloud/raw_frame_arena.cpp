@@ -0,0 +1,113 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "raw_frame_arena.hpp"
+
+// Standard headers
+#include <cstring>
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+// Every plane starts on its own cache line
+constexpr size_t planeAlignment = 64 / sizeof(uint16_t);
+
+size_t AlignedPlaneSize(size_t width, size_t height)
+{
+    return (width * height + planeAlignment - 1) / planeAlignment * planeAlignment;
+}
+
+void CopyPlane(PlaneView<const uint16_t> source, PlaneView<uint16_t> destination)
+{
+    if (source.stride == source.width)
+    {
+        std::memcpy(destination.data, source.data, source.NumPixels() * sizeof(uint16_t));
+        return;
+    }
+
+    for (size_t y = 0; y < source.height; ++y)
+    {
+        std::memcpy(destination.Row(y), source.Row(y), source.width * sizeof(uint16_t));
+    }
+}
+
+} // namespace
+
+RawFrameArena::RawFrameArena(size_t numFrames, size_t width, size_t height)
+    : m_width(width)
+    , m_height(height)
+    , m_slab(2 * numFrames * AlignedPlaneSize(width, height) + planeAlignment)
+    , m_frames(numFrames)
+    , m_freeFrames(numFrames)
+{
+    const auto planeSize = AlignedPlaneSize(width, height);
+
+    // The vector only guarantees the alignment of its element type
+    auto* base = m_slab.data();
+    while (reinterpret_cast<uintptr_t>(base) % (planeAlignment * sizeof(uint16_t)) != 0)
+    {
+        ++base;
+    }
+
+    for (size_t i = 0; i < numFrames; ++i)
+    {
+        m_frames[i].depth = { base + 2 * i * planeSize, width, height, width };
+        m_frames[i].intensity = { base + (2 * i + 1) * planeSize, width, height, width };
+        m_freeFrames.TryPush(&m_frames[i]);
+    }
+}
+
+RawFrame* RawFrameArena::TryCopy(PlaneView<const uint16_t> depth, PlaneView<const uint16_t> intensity)
+{
+    const auto hasArenaSize = [this](PlaneView<const uint16_t> plane) {
+        return !plane.data || (plane.width == m_width && plane.height == m_height);
+    };
+
+    if (!hasArenaSize(depth) || !hasArenaSize(intensity))
+    {
+        return nullptr;
+    }
+
+    RawFrame* frame = nullptr;
+    if (!m_freeFrames.TryPop(frame))
+    {
+        return nullptr;
+    }
+
+    const ScopedLatency latency(LatencyStage::RawFrameCopy);
+    if (depth.data)
+    {
+        CopyPlane(depth, frame->depth);
+    }
+
+    if (intensity.data)
+    {
+        CopyPlane(intensity, frame->intensity);
+    }
+
+    return frame;
+}
+
+void RawFrameArena::Release(RawFrame* frame)
+{
+    m_freeFrames.TryPush(frame);
+}
+
+} // namespace nion
@@ -0,0 +1,65 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project headers
+#include "image_plane.hpp"
+#include "lock_free_queue.hpp"
+
+namespace nion
+{
+
+// Copy of the raw depth map and intensity image of a buffer
+struct RawFrame
+{
+    PlaneView<uint16_t> depth{};
+    PlaneView<uint16_t> intensity{};
+};
+
+// Fixed set of raw frames in a single memory slab, allocated on construction. Copying the raw images of a buffer
+// into the arena allows queuing the buffer right away, before it is processed, so the buffers of the data stream
+// turn over as fast as possible even with the minimum buffer count. Frames can be released from any thread.
+class RawFrameArena
+{
+public:
+    RawFrameArena(size_t numFrames, size_t width, size_t height);
+
+    RawFrameArena(const RawFrameArena&) = delete;
+    RawFrameArena& operator=(const RawFrameArena&) = delete;
+    RawFrameArena(RawFrameArena&&) = delete;
+    RawFrameArena& operator=(RawFrameArena&&) = delete;
+
+    // Copy the raw images into a free frame. Returns nullptr if all frames are in use or the images do not have
+    // the size of the arena, in which case they have to be processed in place. Empty images are not copied, e.g.
+    // the intensity image if the output profile does not use it.
+    RawFrame* TryCopy(PlaneView<const uint16_t> depth, PlaneView<const uint16_t> intensity);
+
+    void Release(RawFrame* frame);
+
+private:
+    size_t m_width;
+    size_t m_height;
+    std::vector<uint16_t> m_slab;
+    std::vector<RawFrame> m_frames;
+    LockFreeQueue<RawFrame*> m_freeFrames;
+};
+
+} // namespace nion
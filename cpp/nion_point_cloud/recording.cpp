@@ -0,0 +1,265 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "recording.hpp"
+
+// Standard headers
+#include <cstring>
+#include <stdexcept>
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+constexpr char recordingMagic[8] = { 'N', 'I', 'O', 'N', 'R', 'E', 'C', '\0' };
+constexpr uint32_t recordingVersion = 1;
+constexpr uint32_t compressedRecordingVersion = 2;
+
+static_assert(sizeof(RecordingHeader) == 52, "RecordingHeader must not contain padding.");
+static_assert(sizeof(RecordedFrameHeader) == 16, "RecordedFrameHeader must not contain padding.");
+
+template <typename T>
+void WriteValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(std::ifstream& file, T& value)
+{
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void CheckPlaneSize(PlaneView<const uint16_t> plane, const ImageGeometry& geometry)
+{
+    if (plane.width != geometry.width || plane.height != geometry.height)
+    {
+        throw std::invalid_argument("Image size does not match the size of the recording.");
+    }
+}
+
+} // namespace
+
+RecordingWriter::RecordingWriter(
+    const std::string& filePath, const RecordingInfo& info, const PlaneCompressionSettings& compressionSettings)
+    : m_filePath(filePath)
+    , m_file(filePath, std::ios::binary)
+    , m_geometry(info.geometry)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    if (info.isCompressed)
+    {
+        m_compressor = std::make_unique<PlaneCompressor>(compressionSettings);
+    }
+
+    RecordingHeader header{};
+    std::memcpy(header.magic, recordingMagic, sizeof(header.magic));
+    header.version = info.isCompressed ? compressedRecordingVersion : recordingVersion;
+    header.calibrationSize = static_cast<uint32_t>(info.calibrationData.size());
+    header.scaleFactor = info.scaleFactor;
+    header.validDepthMin = info.validDepthMin;
+    header.validDepthMax = info.validDepthMax;
+    header.binningHorizontal = info.geometry.binningHorizontal;
+    header.binningVertical = info.geometry.binningVertical;
+    header.offsetX = info.geometry.offsetX;
+    header.offsetY = info.geometry.offsetY;
+    header.width = info.geometry.width;
+    header.height = info.geometry.height;
+
+    WriteValue(m_file, header);
+    m_file.write(reinterpret_cast<const char*>(info.calibrationData.data()),
+        static_cast<std::streamsize>(info.calibrationData.size()));
+
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to write file: " + filePath);
+    }
+}
+
+void RecordingWriter::WriteFrame(uint64_t frameId, uint64_t timestampNs, PlaneView<const uint16_t> depthMap,
+    PlaneView<const uint16_t> intensity)
+{
+    CheckPlaneSize(depthMap, m_geometry);
+    CheckPlaneSize(intensity, m_geometry);
+
+    WriteValue(m_file, RecordedFrameHeader{ frameId, timestampNs });
+    WritePlane(depthMap);
+    WritePlane(intensity);
+
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to write file: " + m_filePath);
+    }
+
+    ++m_numFrames;
+}
+
+size_t RecordingWriter::NumFrames() const
+{
+    return m_numFrames;
+}
+
+void RecordingWriter::WritePlane(PlaneView<const uint16_t> plane)
+{
+    if (m_compressor)
+    {
+        ScopedLatency latency(LatencyStage::RecordingCompression);
+        m_compressor->Compress(plane, m_compressedData);
+        latency.Stop();
+
+        WriteValue(m_file, static_cast<uint32_t>(m_compressedData.size()));
+        m_file.write(reinterpret_cast<const char*>(m_compressedData.data()),
+            static_cast<std::streamsize>(m_compressedData.size()));
+        return;
+    }
+
+    const auto rowSize = static_cast<std::streamsize>(plane.width * sizeof(uint16_t));
+
+    // Rows of buffer parts may be padded, the recording always stores them without padding
+    if (plane.stride == plane.width)
+    {
+        m_file.write(reinterpret_cast<const char*>(plane.data), rowSize * static_cast<std::streamsize>(plane.height));
+        return;
+    }
+
+    for (size_t y = 0; y < plane.height; ++y)
+    {
+        m_file.write(reinterpret_cast<const char*>(plane.Row(y)), rowSize);
+    }
+}
+
+RecordingReader::RecordingReader(const std::string& filePath, const PlaneCompressionSettings& compressionSettings)
+    : m_filePath(filePath)
+    , m_file(filePath, std::ios::binary)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    RecordingHeader header{};
+    if (!ReadValue(m_file, header) || std::memcmp(header.magic, recordingMagic, sizeof(header.magic)) != 0)
+    {
+        throw std::runtime_error("Not a recording: " + filePath);
+    }
+    if (header.version != recordingVersion && header.version != compressedRecordingVersion)
+    {
+        throw std::runtime_error("Unsupported recording version " + std::to_string(header.version) + ": " + filePath);
+    }
+
+    m_info.isCompressed = (header.version == compressedRecordingVersion);
+    if (m_info.isCompressed)
+    {
+        m_compressor = std::make_unique<PlaneCompressor>(compressionSettings);
+    }
+
+    m_info.calibrationData.resize(header.calibrationSize);
+    m_info.scaleFactor = header.scaleFactor;
+    m_info.validDepthMin = header.validDepthMin;
+    m_info.validDepthMax = header.validDepthMax;
+    m_info.geometry.binningHorizontal = header.binningHorizontal;
+    m_info.geometry.binningVertical = header.binningVertical;
+    m_info.geometry.offsetX = header.offsetX;
+    m_info.geometry.offsetY = header.offsetY;
+    m_info.geometry.width = header.width;
+    m_info.geometry.height = header.height;
+
+    if (!m_file.read(reinterpret_cast<char*>(m_info.calibrationData.data()),
+            static_cast<std::streamsize>(m_info.calibrationData.size())))
+    {
+        throw std::runtime_error("Recording is truncated: " + filePath);
+    }
+}
+
+const RecordingInfo& RecordingReader::Info() const
+{
+    return m_info;
+}
+
+bool RecordingReader::ReadFrame(RecordedFrame& frame)
+{
+    RecordedFrameHeader header{};
+    if (!ReadValue(m_file, header))
+    {
+        return false;
+    }
+
+    const auto width = m_info.geometry.width;
+    const auto height = m_info.geometry.height;
+    if (frame.depthMap.Width() != width || frame.depthMap.Height() != height)
+    {
+        frame.depthMap = Plane<uint16_t>(width, height);
+        frame.intensity = Plane<uint16_t>(width, height);
+    }
+
+    frame.frameId = header.frameId;
+    frame.timestampNs = header.timestampNs;
+
+    ReadPlane(frame.depthMap);
+    ReadPlane(frame.intensity);
+
+    return true;
+}
+
+void RecordingReader::ReadPlane(Plane<uint16_t>& plane)
+{
+    if (!m_compressor)
+    {
+        const auto planeSize = static_cast<std::streamsize>(plane.View().NumPixels() * sizeof(uint16_t));
+        if (!m_file.read(reinterpret_cast<char*>(plane.View().data), planeSize))
+        {
+            throw std::runtime_error("Recording is truncated: " + m_filePath);
+        }
+        return;
+    }
+
+    uint32_t compressedSize = 0;
+    if (!ReadValue(m_file, compressedSize))
+    {
+        throw std::runtime_error("Recording is truncated: " + m_filePath);
+    }
+
+    m_compressedData.resize(compressedSize);
+    if (!m_file.read(reinterpret_cast<char*>(m_compressedData.data()), compressedSize))
+    {
+        throw std::runtime_error("Recording is truncated: " + m_filePath);
+    }
+
+    m_compressor->Decompress(m_compressedData.data(), m_compressedData.size(), plane.View());
+}
+
+std::vector<RecordedFrame> RecordingReader::ReadAllFrames()
+{
+    std::vector<RecordedFrame> frames;
+
+    RecordedFrame frame;
+    while (ReadFrame(frame))
+    {
+        frames.push_back(std::move(frame));
+        frame = RecordedFrame{};
+    }
+
+    return frames;
+}
+
+} // namespace nion
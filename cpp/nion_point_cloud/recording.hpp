@@ -0,0 +1,148 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Project headers
+#include "image_plane.hpp"
+#include "lens_model.hpp"
+#include "plane_compression.hpp"
+
+namespace nion
+{
+
+// Everything required to process the frames of a recording without the camera
+struct RecordingInfo
+{
+    // Content of the LensCalibrationData file of the device
+    std::vector<uint8_t> calibrationData{};
+    float scaleFactor{};
+
+    // Range of valid raw depth values after scaling, read from the device
+    float validDepthMin{};
+    float validDepthMax{};
+    ImageGeometry geometry{};
+
+    // The images are stored compressed, see PlaneCompressor
+    bool isCompressed{};
+};
+
+// Raw images of one recorded buffer
+struct RecordedFrame
+{
+    uint64_t frameId{};
+    uint64_t timestampNs{};
+    Plane<uint16_t> depthMap{};
+    Plane<uint16_t> intensity{};
+};
+
+// Layout of a recording file. All values are stored in the byte order of the host that wrote it, which is
+// little-endian on all platforms supported by IDS peak, so recordings can be exchanged between them:
+//
+//   RecordingHeader
+//   calibration data (calibrationSize bytes)
+//   for every frame:
+//     RecordedFrameHeader
+//     raw depth map (width * height uint16, row-major)
+//     raw intensity image (width * height uint16, row-major)
+//
+// Version 2 recordings store the images compressed instead, each one as its size in bytes (uint32) followed by the
+// compressed plane, see CompressedPlaneHeader.
+struct RecordingHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t calibrationSize;
+    float scaleFactor;
+    float validDepthMin;
+    float validDepthMax;
+    uint32_t binningHorizontal;
+    uint32_t binningVertical;
+    uint32_t offsetX;
+    uint32_t offsetY;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct RecordedFrameHeader
+{
+    uint64_t frameId;
+    uint64_t timestampNs;
+};
+
+// Records the raw multipart buffers of an acquisition, so they can be replayed later with RecordingReader
+class RecordingWriter
+{
+public:
+    // With isCompressed of the info, the images are compressed with the given settings, in the calling thread and the
+    // helper threads of the compressor
+    RecordingWriter(const std::string& filePath, const RecordingInfo& info,
+        const PlaneCompressionSettings& compressionSettings = {});
+
+    // The images must have the size of the recording geometry
+    void WriteFrame(uint64_t frameId, uint64_t timestampNs, PlaneView<const uint16_t> depthMap,
+        PlaneView<const uint16_t> intensity);
+
+    size_t NumFrames() const;
+
+private:
+    void WritePlane(PlaneView<const uint16_t> plane);
+
+    std::string m_filePath;
+    std::ofstream m_file;
+    ImageGeometry m_geometry;
+    size_t m_numFrames{};
+
+    std::unique_ptr<PlaneCompressor> m_compressor;
+    std::vector<uint8_t> m_compressedData;
+};
+
+// Reads a recording frame by frame
+class RecordingReader
+{
+public:
+    // Compressed recordings are decompressed with the given settings
+    explicit RecordingReader(
+        const std::string& filePath, const PlaneCompressionSettings& compressionSettings = {});
+
+    const RecordingInfo& Info() const;
+
+    // Read the next frame. The planes of the frame are only allocated if their size does not
+    // match, so the same frame can be reused. Returns false at the end of the recording.
+    bool ReadFrame(RecordedFrame& frame);
+
+    // Read all remaining frames into memory, so they can be replayed without waiting for the disk
+    std::vector<RecordedFrame> ReadAllFrames();
+
+private:
+    void ReadPlane(Plane<uint16_t>& plane);
+
+    std::string m_filePath;
+    std::ifstream m_file;
+    RecordingInfo m_info;
+
+    // Created for compressed recordings only
+    std::unique_ptr<PlaneCompressor> m_compressor;
+    std::vector<uint8_t> m_compressedData;
+};
+
+} // namespace nion
@@ -0,0 +1,367 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "sequence_file.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+constexpr char sequenceMagic[8] = { 'N', 'I', 'O', 'N', 'S', 'E', 'Q', '\0' };
+constexpr uint32_t sequenceVersion = 2;
+
+static_assert(sizeof(SequenceHeader) == 64, "SequenceHeader must not contain padding.");
+static_assert(sizeof(SequenceIndexEntry) == 48, "SequenceIndexEntry must not contain padding.");
+
+// Alignment of the parts of a record
+constexpr uint64_t recordAlignment = 64;
+
+// Alignment of the chunks, a multiple of the mapping alignment of all platforms
+constexpr uint64_t chunkAlignment = 1024 * 1024;
+
+uint64_t AlignUp(uint64_t size, uint64_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// Offsets of the parts of a record relative to its start
+struct RecordLayout
+{
+    uint64_t depthOffset{};
+    uint64_t intensityOffset{};
+    uint64_t pointsOffset{};
+    uint64_t size{};
+};
+
+RecordLayout ComputeRecordLayout(uint32_t flags, size_t width, size_t height, size_t numPoints)
+{
+    const auto numPixels = static_cast<uint64_t>(width) * height;
+
+    RecordLayout layout;
+    layout.depthOffset = layout.size;
+    if (flags & SequenceRecordHasDepthMap)
+    {
+        const auto valueSize = (flags & SequenceRecordHasRawDepthMap) ? sizeof(uint16_t) : sizeof(float);
+        layout.size += AlignUp(numPixels * valueSize, recordAlignment);
+    }
+
+    layout.intensityOffset = layout.size;
+    if (flags & SequenceRecordHasIntensity)
+    {
+        layout.size += AlignUp(numPixels * sizeof(uint16_t), recordAlignment);
+    }
+
+    layout.pointsOffset = layout.size;
+    if (flags & SequenceRecordHasPointCloud)
+    {
+        layout.size += AlignUp(numPoints * sizeof(PointXYZI), recordAlignment);
+    }
+
+    return layout;
+}
+
+template <typename T>
+void CopyPlane(PlaneView<const T> source, uint8_t* destination)
+{
+    auto* output = reinterpret_cast<T*>(destination);
+    for (size_t y = 0; y < source.height; ++y)
+    {
+        std::memcpy(output + y * source.width, source.Row(y), source.width * sizeof(T));
+    }
+}
+
+} // namespace
+
+SequenceWriter::SequenceWriter(
+    const std::string& filePath, size_t width, size_t height, const SequenceSettings& settings)
+    : m_filePath(filePath)
+    , m_file(filePath, MappedFile::Mode::Create)
+    , m_width(width)
+    , m_height(height)
+{
+    const auto maxRecordSize = ComputeRecordLayout(
+        SequenceRecordHasDepthMap | SequenceRecordHasIntensity | SequenceRecordHasPointCloud, width, height,
+        width * height)
+                                   .size;
+    m_chunkSize = AlignUp(std::max(settings.chunkSize, maxRecordSize), chunkAlignment);
+
+    const auto indexOffset = AlignUp(sizeof(SequenceHeader), recordAlignment);
+    const auto dataOffset = AlignUp(indexOffset + settings.maxNumFrames * sizeof(SequenceIndexEntry), chunkAlignment);
+
+    m_file.Reserve(dataOffset);
+    m_indexMappingSize = static_cast<size_t>(dataOffset);
+    m_indexMapping = m_file.Map(0, m_indexMappingSize);
+    m_header = reinterpret_cast<SequenceHeader*>(m_indexMapping);
+    m_index = reinterpret_cast<SequenceIndexEntry*>(m_indexMapping + indexOffset);
+
+    std::memcpy(m_header->magic, sequenceMagic, sizeof(m_header->magic));
+    m_header->version = sequenceVersion;
+    m_header->width = static_cast<uint32_t>(width);
+    m_header->height = static_cast<uint32_t>(height);
+    m_header->indexOffset = indexOffset;
+    m_header->indexCapacity = settings.maxNumFrames;
+    m_header->dataOffset = dataOffset;
+    m_header->dataEnd = dataOffset;
+    m_header->numFrames = 0;
+
+    m_writeOffset = dataOffset;
+}
+
+SequenceWriter::~SequenceWriter()
+{
+    try
+    {
+        Close();
+    }
+    catch (...)
+    {
+    }
+}
+
+bool SequenceWriter::WriteFrame(uint64_t frameId, uint64_t timestampNs, DepthMapView depthMap,
+    PlaneView<const uint16_t> intensity, const PointCloud* pointCloud)
+{
+    const ScopedLatency latency(LatencyStage::WriteSequence);
+
+    const auto hasSize = [this](size_t width, size_t height) {
+        return width == m_width && height == m_height;
+    };
+
+    if ((depthMap.metric.data && !hasSize(depthMap.metric.width, depthMap.metric.height))
+        || (depthMap.raw.data && !hasSize(depthMap.raw.width, depthMap.raw.height))
+        || (intensity.data && !hasSize(intensity.width, intensity.height))
+        || (pointCloud && pointCloud->points.size() > m_width * m_height))
+    {
+        throw std::invalid_argument("The frame does not match the size of the sequence file.");
+    }
+
+    uint32_t flags = 0;
+    const auto isDepthRaw = !depthMap.metric.data && depthMap.raw.data;
+    flags |= (depthMap.metric.data || isDepthRaw) ? SequenceRecordHasDepthMap : 0u;
+    flags |= isDepthRaw ? SequenceRecordHasRawDepthMap : 0u;
+    flags |= intensity.data ? SequenceRecordHasIntensity : 0u;
+    flags |= pointCloud ? SequenceRecordHasPointCloud : 0u;
+    const auto numPoints = pointCloud ? pointCloud->points.size() : 0;
+    const auto layout = ComputeRecordLayout(flags, m_width, m_height, numPoints);
+
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_header)
+    {
+        throw std::logic_error("The sequence file is closed: " + m_filePath);
+    }
+
+    const auto frameNumber = m_header->numFrames;
+    if (frameNumber >= m_header->indexCapacity)
+    {
+        ++m_numSkippedFrames;
+        return false;
+    }
+
+    if (!m_chunk || m_writeOffset + layout.size > m_chunkOffset + m_chunkSize)
+    {
+        MapNextChunk();
+    }
+
+    auto* record = m_chunk + (m_writeOffset - m_chunkOffset);
+    if (depthMap.metric.data)
+    {
+        CopyPlane(depthMap.metric, record + layout.depthOffset);
+    }
+    else if (isDepthRaw)
+    {
+        CopyPlane(depthMap.raw, record + layout.depthOffset);
+    }
+
+    if (intensity.data)
+    {
+        CopyPlane(intensity, record + layout.intensityOffset);
+    }
+
+    if (pointCloud)
+    {
+        std::memcpy(record + layout.pointsOffset, pointCloud->points.data(), numPoints * sizeof(PointXYZI));
+    }
+
+    auto& entry = m_index[frameNumber];
+    entry.frameId = frameId;
+    entry.timestampNs = timestampNs;
+    entry.offset = m_writeOffset;
+    entry.flags = flags;
+    entry.numPoints = static_cast<uint32_t>(numPoints);
+    entry.pointCloudWidth = pointCloud ? static_cast<uint32_t>(pointCloud->width) : 0;
+    entry.pointCloudHeight = pointCloud ? static_cast<uint32_t>(pointCloud->height) : 0;
+    entry.depthScaleFactor = isDepthRaw ? depthMap.scaleFactor : 0.0F;
+    entry.reserved = 0;
+
+    // The frame only counts once its record and index entry are complete
+    m_writeOffset += layout.size;
+    m_header->dataEnd = m_writeOffset;
+    m_header->numFrames = frameNumber + 1;
+    m_numFrames = static_cast<size_t>(frameNumber + 1);
+    return true;
+}
+
+void SequenceWriter::Close()
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_header)
+    {
+        return;
+    }
+
+    if (m_chunk)
+    {
+        m_file.Unmap(m_chunk, static_cast<size_t>(m_chunkSize));
+        m_chunk = nullptr;
+    }
+
+    m_file.Unmap(m_indexMapping, m_indexMappingSize);
+    m_header = nullptr;
+    m_index = nullptr;
+
+    m_file.Truncate(m_writeOffset);
+}
+
+size_t SequenceWriter::NumFrames() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numFrames;
+}
+
+size_t SequenceWriter::NumSkippedFrames() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numSkippedFrames;
+}
+
+void SequenceWriter::MapNextChunk()
+{
+    const auto chunkOffset = m_chunk ? m_chunkOffset + m_chunkSize : m_header->dataOffset;
+    if (m_chunk)
+    {
+        m_file.Unmap(m_chunk, static_cast<size_t>(m_chunkSize));
+        m_chunk = nullptr;
+    }
+
+    m_file.Reserve(chunkOffset + m_chunkSize);
+    m_chunk = m_file.Map(chunkOffset, static_cast<size_t>(m_chunkSize));
+    m_chunkOffset = chunkOffset;
+    m_writeOffset = chunkOffset;
+}
+
+SequenceReader::SequenceReader(const std::string& filePath)
+    : m_filePath(filePath)
+    , m_file(filePath, MappedFile::Mode::Read)
+{
+    if (m_file.Size() < sizeof(SequenceHeader))
+    {
+        throw std::runtime_error("Not a sequence file: " + filePath);
+    }
+
+    m_data = m_file.Map(0, static_cast<size_t>(m_file.Size()));
+    m_header = reinterpret_cast<const SequenceHeader*>(m_data);
+
+    if (std::memcmp(m_header->magic, sequenceMagic, sizeof(sequenceMagic)) != 0
+        || m_header->version != sequenceVersion || m_header->numFrames > m_header->indexCapacity
+        || m_header->indexOffset + m_header->indexCapacity * sizeof(SequenceIndexEntry) > m_file.Size()
+        || m_header->dataEnd > m_file.Size())
+    {
+        m_file.Unmap(m_data, static_cast<size_t>(m_file.Size()));
+        throw std::runtime_error("Not a sequence file or unsupported version: " + filePath);
+    }
+
+    m_index = reinterpret_cast<const SequenceIndexEntry*>(m_data + m_header->indexOffset);
+}
+
+SequenceReader::~SequenceReader()
+{
+    m_file.Unmap(m_data, static_cast<size_t>(m_file.Size()));
+}
+
+size_t SequenceReader::NumFrames() const
+{
+    return static_cast<size_t>(m_header->numFrames);
+}
+
+size_t SequenceReader::Width() const
+{
+    return m_header->width;
+}
+
+size_t SequenceReader::Height() const
+{
+    return m_header->height;
+}
+
+SequenceFrame SequenceReader::Frame(size_t i) const
+{
+    if (i >= NumFrames())
+    {
+        throw std::out_of_range("Frame " + std::to_string(i) + " is not part of the sequence file.");
+    }
+
+    const auto& entry = m_index[i];
+    const auto width = Width();
+    const auto height = Height();
+    const auto layout = ComputeRecordLayout(entry.flags, width, height, entry.numPoints);
+    if (entry.offset + layout.size > m_header->dataEnd)
+    {
+        throw std::runtime_error("Frame " + std::to_string(i) + " is outside the sequence file: " + m_filePath);
+    }
+
+    const auto* record = m_data + entry.offset;
+
+    SequenceFrame frame;
+    frame.frameId = entry.frameId;
+    frame.timestampNs = entry.timestampNs;
+    if (entry.flags & SequenceRecordHasRawDepthMap)
+    {
+        const PlaneView<const uint16_t> rawDepth{ reinterpret_cast<const uint16_t*>(record + layout.depthOffset),
+            width, height, width };
+        frame.depthMap = DepthMapView(rawDepth, entry.depthScaleFactor);
+    }
+    else if (entry.flags & SequenceRecordHasDepthMap)
+    {
+        frame.depthMap = PlaneView<const float>{ reinterpret_cast<const float*>(record + layout.depthOffset), width,
+            height, width };
+    }
+
+    if (entry.flags & SequenceRecordHasIntensity)
+    {
+        frame.intensity = { reinterpret_cast<const uint16_t*>(record + layout.intensityOffset), width, height,
+            width };
+    }
+
+    if (entry.flags & SequenceRecordHasPointCloud)
+    {
+        frame.points = reinterpret_cast<const PointXYZI*>(record + layout.pointsOffset);
+        frame.numPoints = entry.numPoints;
+        frame.pointCloudWidth = entry.pointCloudWidth;
+        frame.pointCloudHeight = entry.pointCloudHeight;
+    }
+
+    return frame;
+}
+
+} // namespace nion
@@ -0,0 +1,185 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Project headers
+#include "image_plane.hpp"
+#include "mapped_file.hpp"
+#include "point_cloud.hpp"
+
+namespace nion
+{
+
+// Layout of a sequence file. The records are copied from memory as they are and SequenceReader uses them in place,
+// so all values are in the byte order of the host that wrote the file. This is little-endian on all platforms
+// supported by IDS peak, a reader on a big-endian host has to swap them.
+//
+//   SequenceHeader
+//   index: indexCapacity SequenceIndexEntry, of which the first numFrames are used
+//   records from dataOffset on, in chunks that are allocated one after another:
+//     undistorted depth map (width * height float, row-major), if SequenceRecordHasDepthMap is set, or in raw values
+//     (width * height uint16, row-major) multiplied by depthScaleFactor if SequenceRecordHasRawDepthMap is also set
+//     undistorted intensity image (width * height uint16, row-major), if SequenceRecordHasIntensity is set
+//     points (numPoints PointXYZI), if SequenceRecordHasPointCloud is set
+//
+// The parts of a record start on 64 byte boundaries. Records do not cross chunks.
+struct SequenceHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+    uint64_t indexOffset;
+    uint64_t indexCapacity;
+    uint64_t dataOffset;
+    uint64_t dataEnd;
+    uint64_t numFrames;
+};
+
+enum SequenceRecordFlags : uint32_t
+{
+    SequenceRecordHasDepthMap = 1,
+    SequenceRecordHasIntensity = 2,
+    SequenceRecordHasPointCloud = 4,
+    SequenceRecordHasRawDepthMap = 8
+};
+
+struct SequenceIndexEntry
+{
+    uint64_t frameId;
+    uint64_t timestampNs;
+    uint64_t offset;
+    uint32_t flags;
+    uint32_t numPoints;
+    uint32_t pointCloudWidth;
+    uint32_t pointCloudHeight;
+    float depthScaleFactor;
+    uint32_t reserved;
+};
+
+struct SequenceSettings
+{
+    // Number of entries of the index, which is allocated when the file is created. Further frames are not written.
+    size_t maxNumFrames{ 100000 };
+
+    // The file grows by chunks of this size, whose disk space is allocated at once. At least the size of one record.
+    uint64_t chunkSize{ 256 * 1024 * 1024 };
+};
+
+// Writes the results of all frames of an acquisition into a single append-only file, instead of three files per
+// frame. The records are copied into memory mappings of the file, and the index allows to read any frame directly,
+// see SequenceReader.
+class SequenceWriter
+{
+public:
+    SequenceWriter(const std::string& filePath, size_t width, size_t height, const SequenceSettings& settings);
+
+    // Closes the file, errors are ignored
+    ~SequenceWriter();
+
+    SequenceWriter(const SequenceWriter&) = delete;
+    SequenceWriter& operator=(const SequenceWriter&) = delete;
+    SequenceWriter(SequenceWriter&&) = delete;
+    SequenceWriter& operator=(SequenceWriter&&) = delete;
+
+    // Append the results of a frame. A raw depth map is stored raw together with its scale factor, which halves its
+    // size compared to the metric values. Empty images and a null point cloud are not written. Returns false without
+    // writing the frame if the index is full, so the file ends there while the acquisition goes on, see
+    // NumSkippedFrames. Thread-safe, the frames are written one after another.
+    bool WriteFrame(uint64_t frameId, uint64_t timestampNs, DepthMapView depthMap,
+        PlaneView<const uint16_t> intensity, const PointCloud* pointCloud);
+
+    // Release the unused part of the last chunk. No frames can be written afterwards.
+    void Close();
+
+    size_t NumFrames() const;
+
+    // Frames that were not written as the index was full
+    size_t NumSkippedFrames() const;
+
+private:
+    void MapNextChunk();
+
+    mutable std::mutex m_mutex;
+    std::string m_filePath;
+    MappedFile m_file;
+    size_t m_width;
+    size_t m_height;
+    uint64_t m_chunkSize{};
+
+    // Header and index, mapped as long as the file is open
+    uint8_t* m_indexMapping{};
+    size_t m_indexMappingSize{};
+    SequenceHeader* m_header{};
+    SequenceIndexEntry* m_index{};
+
+    uint8_t* m_chunk{};
+    uint64_t m_chunkOffset{};
+    uint64_t m_writeOffset{};
+    size_t m_numFrames{};
+    size_t m_numSkippedFrames{};
+};
+
+// Results of a frame within the mapped sequence file
+struct SequenceFrame
+{
+    uint64_t frameId{};
+    uint64_t timestampNs{};
+
+    // Raw or metric, as it was written
+    DepthMapView depthMap{};
+    PlaneView<const uint16_t> intensity{};
+    const PointXYZI* points{};
+    size_t numPoints{};
+    size_t pointCloudWidth{};
+    size_t pointCloudHeight{};
+};
+
+// Maps a sequence file and provides the frames in place, in constant time for any frame
+class SequenceReader
+{
+public:
+    explicit SequenceReader(const std::string& filePath);
+    ~SequenceReader();
+
+    SequenceReader(const SequenceReader&) = delete;
+    SequenceReader& operator=(const SequenceReader&) = delete;
+    SequenceReader(SequenceReader&&) = delete;
+    SequenceReader& operator=(SequenceReader&&) = delete;
+
+    size_t NumFrames() const;
+    size_t Width() const;
+    size_t Height() const;
+
+    // The views stay valid as long as the reader exists. Throws a std::out_of_range if there is no frame i.
+    SequenceFrame Frame(size_t i) const;
+
+private:
+    std::string m_filePath;
+    MappedFile m_file;
+    uint8_t* m_data{};
+    const SequenceHeader* m_header{};
+    const SequenceIndexEntry* m_index{};
+};
+
+} // namespace nion
@@ -0,0 +1,414 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "shared_memory_ring.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+constexpr uint32_t ringVersion = 2;
+
+// Slots and the images within them start on cache lines
+constexpr size_t alignment = 64;
+
+size_t AlignUp(size_t size)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+#ifdef _WIN32
+std::string ToPlatformName(const std::string& name)
+{
+    return "Local\\" + name;
+}
+#else
+std::string ToPlatformName(const std::string& name)
+{
+    return "/" + name;
+}
+#endif
+
+// Copy a plane row by row into contiguous memory
+template <typename T>
+void CopyPlane(PlaneView<const T> source, T* destination)
+{
+    for (size_t y = 0; y < source.height; ++y)
+    {
+        std::memcpy(destination + y * source.width, source.Row(y), source.width * sizeof(T));
+    }
+}
+
+} // namespace
+
+#ifdef _WIN32
+SharedMemoryMapping::SharedMemoryMapping(const std::string& name, size_t size)
+    : m_name(ToPlatformName(name))
+    , m_isOwner(true)
+    , m_size(size)
+{
+    const auto size64 = static_cast<uint64_t>(size);
+    m_handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32),
+        static_cast<DWORD>(size64 & 0xFFFFFFFF), m_name.c_str());
+    if (!m_handle)
+    {
+        throw std::runtime_error("Failed to create shared memory: " + name);
+    }
+
+    m_data = static_cast<uint8_t*>(MapViewOfFile(m_handle, FILE_MAP_WRITE, 0, 0, size));
+    if (!m_data)
+    {
+        CloseHandle(m_handle);
+        throw std::runtime_error("Failed to map shared memory: " + name);
+    }
+}
+
+SharedMemoryMapping::SharedMemoryMapping(const std::string& name)
+    : m_name(ToPlatformName(name))
+{
+    m_handle = OpenFileMappingA(FILE_MAP_READ, FALSE, m_name.c_str());
+    if (!m_handle)
+    {
+        throw std::runtime_error("Failed to open shared memory: " + name);
+    }
+
+    m_data = static_cast<uint8_t*>(MapViewOfFile(m_handle, FILE_MAP_READ, 0, 0, 0));
+    MEMORY_BASIC_INFORMATION info{};
+    if (!m_data || VirtualQuery(m_data, &info, sizeof(info)) == 0)
+    {
+        CloseHandle(m_handle);
+        throw std::runtime_error("Failed to map shared memory: " + name);
+    }
+
+    m_size = info.RegionSize;
+}
+
+SharedMemoryMapping::~SharedMemoryMapping()
+{
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_handle);
+}
+#else
+SharedMemoryMapping::SharedMemoryMapping(const std::string& name, size_t size)
+    : m_name(ToPlatformName(name))
+    , m_isOwner(true)
+    , m_size(size)
+{
+    // Readers that still map an earlier ring keep it until they close it
+    shm_unlink(m_name.c_str());
+
+    const auto fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to create shared memory: " + name);
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        close(fd);
+        shm_unlink(m_name.c_str());
+        throw std::runtime_error("Failed to resize shared memory: " + name);
+    }
+
+    auto* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        shm_unlink(m_name.c_str());
+        throw std::runtime_error("Failed to map shared memory: " + name);
+    }
+
+    m_data = static_cast<uint8_t*>(data);
+}
+
+SharedMemoryMapping::SharedMemoryMapping(const std::string& name)
+    : m_name(ToPlatformName(name))
+{
+    const auto fd = shm_open(m_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to open shared memory: " + name);
+    }
+
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || status.st_size <= 0)
+    {
+        close(fd);
+        throw std::runtime_error("Failed to open shared memory: " + name);
+    }
+
+    m_size = static_cast<size_t>(status.st_size);
+    auto* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("Failed to map shared memory: " + name);
+    }
+
+    m_data = static_cast<uint8_t*>(data);
+}
+
+SharedMemoryMapping::~SharedMemoryMapping()
+{
+    munmap(m_data, m_size);
+    if (m_isOwner)
+    {
+        shm_unlink(m_name.c_str());
+    }
+}
+#endif
+
+uint8_t* SharedMemoryMapping::Data() const
+{
+    return m_data;
+}
+
+size_t SharedMemoryMapping::Size() const
+{
+    return m_size;
+}
+
+namespace
+{
+
+struct RingLayout
+{
+    size_t slotsOffset;
+    size_t slotSize;
+    size_t depthOffset;
+    size_t intensityOffset;
+    size_t pointsOffset;
+    size_t totalSize;
+};
+
+RingLayout ComputeLayout(size_t numSlots, size_t width, size_t height)
+{
+    const auto numPixels = width * height;
+
+    RingLayout layout{};
+    layout.slotsOffset = AlignUp(sizeof(SharedRingHeader));
+    layout.depthOffset = AlignUp(sizeof(SharedFrameHeader));
+    layout.intensityOffset = layout.depthOffset + AlignUp(numPixels * sizeof(float));
+    layout.pointsOffset = layout.intensityOffset + AlignUp(numPixels * sizeof(uint16_t));
+    layout.slotSize = layout.pointsOffset + AlignUp(numPixels * sizeof(PointXYZI));
+    layout.totalSize = layout.slotsOffset + numSlots * layout.slotSize;
+    return layout;
+}
+
+} // namespace
+
+SharedMemoryRing::SharedMemoryRing(const std::string& name, size_t numSlots, size_t width, size_t height)
+    : m_mapping(name, ComputeLayout(numSlots, width, height).totalSize)
+{
+    if (numSlots == 0)
+    {
+        throw std::invalid_argument("The shared memory ring requires at least one slot.");
+    }
+
+    const auto layout = ComputeLayout(numSlots, width, height);
+    auto* data = m_mapping.Data();
+
+    for (size_t i = 0; i < numSlots; ++i)
+    {
+        new (data + layout.slotsOffset + i * layout.slotSize) SharedFrameHeader();
+    }
+
+    m_header = new (data) SharedRingHeader();
+    m_header->version = ringVersion;
+    m_header->numSlots = static_cast<uint32_t>(numSlots);
+    m_header->width = static_cast<uint32_t>(width);
+    m_header->height = static_cast<uint32_t>(height);
+    m_header->slotsOffset = layout.slotsOffset;
+    m_header->slotSize = layout.slotSize;
+    m_header->depthOffset = layout.depthOffset;
+    m_header->intensityOffset = layout.intensityOffset;
+    m_header->pointsOffset = layout.pointsOffset;
+
+    // The magic is written last, so readers never see a partially initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_header->magic, "NSHM", sizeof(m_header->magic));
+}
+
+void SharedMemoryRing::Publish(uint64_t frameId, uint64_t timestampNs, DepthMapView depthMap,
+    PlaneView<const uint16_t> intensity, const PointCloud* pointCloud)
+{
+    const ScopedLatency latency(LatencyStage::PublishSharedMemory);
+
+    const auto hasSize = [this](size_t width, size_t height) {
+        return width == m_header->width && height == m_header->height;
+    };
+
+    if ((depthMap.metric.data && !hasSize(depthMap.metric.width, depthMap.metric.height))
+        || (depthMap.raw.data && !hasSize(depthMap.raw.width, depthMap.raw.height))
+        || (intensity.data && !hasSize(intensity.width, intensity.height))
+        || (pointCloud && pointCloud->points.size() > static_cast<size_t>(m_header->width) * m_header->height))
+    {
+        throw std::invalid_argument("The frame does not fit into the slots of the shared memory ring.");
+    }
+
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto frameNumber = m_header->numPublishedFrames.load(std::memory_order_relaxed);
+    auto* slot = m_mapping.Data() + m_header->slotsOffset + (frameNumber % m_header->numSlots) * m_header->slotSize;
+    auto* header = reinterpret_cast<SharedFrameHeader*>(slot);
+
+    // Odd while written: readers that started before see the sequence change and discard what they read
+    const auto sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    header->frameNumber = frameNumber;
+    header->frameId = frameId;
+    header->timestampNs = timestampNs;
+    header->flags = 0;
+    header->pointCloudWidth = 0;
+    header->pointCloudHeight = 0;
+    header->numPoints = 0;
+    header->depthScaleFactor = 0.0F;
+
+    if (depthMap.metric.data)
+    {
+        CopyPlane(depthMap.metric, reinterpret_cast<float*>(slot + m_header->depthOffset));
+        header->flags |= SharedFrameHasDepthMap;
+    }
+    else if (depthMap.raw.data)
+    {
+        CopyPlane(depthMap.raw, reinterpret_cast<uint16_t*>(slot + m_header->depthOffset));
+        header->depthScaleFactor = depthMap.scaleFactor;
+        header->flags |= SharedFrameHasDepthMap | SharedFrameHasRawDepthMap;
+    }
+
+    if (intensity.data)
+    {
+        CopyPlane(intensity, reinterpret_cast<uint16_t*>(slot + m_header->intensityOffset));
+        header->flags |= SharedFrameHasIntensity;
+    }
+
+    if (pointCloud)
+    {
+        std::copy(pointCloud->points.begin(), pointCloud->points.end(),
+            reinterpret_cast<PointXYZI*>(slot + m_header->pointsOffset));
+        header->pointCloudWidth = static_cast<uint32_t>(pointCloud->width);
+        header->pointCloudHeight = static_cast<uint32_t>(pointCloud->height);
+        header->numPoints = static_cast<uint32_t>(pointCloud->points.size());
+        header->flags |= SharedFrameHasPointCloud;
+    }
+
+    header->sequence.store(sequence + 2, std::memory_order_release);
+    m_header->numPublishedFrames.store(frameNumber + 1, std::memory_order_release);
+}
+
+uint64_t SharedMemoryRing::NumPublishedFrames() const
+{
+    return m_header->numPublishedFrames.load(std::memory_order_relaxed);
+}
+
+SharedMemoryRingReader::SharedMemoryRingReader(const std::string& name)
+    : m_mapping(name)
+    , m_header(reinterpret_cast<const SharedRingHeader*>(m_mapping.Data()))
+{
+    if (m_mapping.Size() < sizeof(SharedRingHeader) || std::memcmp(m_header->magic, "NSHM", 4) != 0
+        || m_header->version != ringVersion
+        || m_mapping.Size() < m_header->slotsOffset + m_header->numSlots * m_header->slotSize)
+    {
+        throw std::runtime_error("Shared memory " + name + " does not contain a known ring.");
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+}
+
+uint64_t SharedMemoryRingReader::NumPublishedFrames() const
+{
+    return m_header->numPublishedFrames.load(std::memory_order_acquire);
+}
+
+bool SharedMemoryRingReader::BeginRead(uint64_t frameNumber, Frame& frame) const
+{
+    const auto numPublishedFrames = NumPublishedFrames();
+    if (frameNumber >= numPublishedFrames || numPublishedFrames - frameNumber > m_header->numSlots)
+    {
+        return false;
+    }
+
+    const auto* slot = m_mapping.Data() + m_header->slotsOffset
+        + (frameNumber % m_header->numSlots) * m_header->slotSize;
+    const auto* header = reinterpret_cast<const SharedFrameHeader*>(slot);
+
+    frame.header = header;
+    frame.sequence = header->sequence.load(std::memory_order_acquire);
+    if (frame.sequence % 2 != 0 || header->frameNumber != frameNumber)
+    {
+        return false;
+    }
+
+    const size_t width = m_header->width;
+    const size_t height = m_header->height;
+    frame.depthMap = {};
+    frame.intensity = {};
+    frame.points = nullptr;
+
+    if (header->flags & SharedFrameHasRawDepthMap)
+    {
+        const PlaneView<const uint16_t> rawDepth{ reinterpret_cast<const uint16_t*>(slot + m_header->depthOffset),
+            width, height, width };
+        frame.depthMap = DepthMapView(rawDepth, header->depthScaleFactor);
+    }
+    else if (header->flags & SharedFrameHasDepthMap)
+    {
+        frame.depthMap = PlaneView<const float>{ reinterpret_cast<const float*>(slot + m_header->depthOffset), width,
+            height, width };
+    }
+
+    if (header->flags & SharedFrameHasIntensity)
+    {
+        frame.intensity = { reinterpret_cast<const uint16_t*>(slot + m_header->intensityOffset), width, height,
+            width };
+    }
+
+    if (header->flags & SharedFrameHasPointCloud)
+    {
+        frame.points = reinterpret_cast<const PointXYZI*>(slot + m_header->pointsOffset);
+    }
+
+    return true;
+}
+
+bool SharedMemoryRingReader::EndRead(const Frame& frame) const
+{
+    // Orders all reads of the frame before the check of the sequence
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return frame.header->sequence.load(std::memory_order_relaxed) == frame.sequence;
+}
+
+} // namespace nion
@@ -0,0 +1,171 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Project headers
+#include "image_plane.hpp"
+#include "point_cloud.hpp"
+
+namespace nion
+{
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The shared memory ring requires lock-free 64 bit atomics.");
+
+// Named shared memory, mapped into the address space of the process
+class SharedMemoryMapping
+{
+public:
+    // Create the shared memory with the given size and map it for writing. An existing one is replaced.
+    // The shared memory is removed when the mapping is destroyed.
+    SharedMemoryMapping(const std::string& name, size_t size);
+
+    // Map an existing shared memory for reading
+    explicit SharedMemoryMapping(const std::string& name);
+
+    ~SharedMemoryMapping();
+
+    SharedMemoryMapping(const SharedMemoryMapping&) = delete;
+    SharedMemoryMapping& operator=(const SharedMemoryMapping&) = delete;
+    SharedMemoryMapping(SharedMemoryMapping&&) = delete;
+    SharedMemoryMapping& operator=(SharedMemoryMapping&&) = delete;
+
+    uint8_t* Data() const;
+    size_t Size() const;
+
+private:
+    std::string m_name;
+    bool m_isOwner{};
+    void* m_handle{};
+    uint8_t* m_data{};
+    size_t m_size{};
+};
+
+// Layout of the shared memory, at its start. The slots follow at slotsOffset, each slotSize bytes.
+struct SharedRingHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t numSlots;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+    uint64_t slotsOffset;
+    uint64_t slotSize;
+
+    // Offsets of the depth map (float or raw uint16), intensity image (uint16) and points (PointXYZI) within a slot
+    uint64_t depthOffset;
+    uint64_t intensityOffset;
+    uint64_t pointsOffset;
+
+    // Number of published frames. Frame n is in slot n % numSlots.
+    std::atomic<uint64_t> numPublishedFrames;
+};
+
+enum SharedFrameFlags : uint32_t
+{
+    SharedFrameHasDepthMap = 1,
+    SharedFrameHasIntensity = 2,
+    SharedFrameHasPointCloud = 4,
+
+    // The depth map holds raw uint16 values, which give the metric values when multiplied with depthScaleFactor
+    SharedFrameHasRawDepthMap = 8
+};
+
+// Header of every slot. sequence is odd while the slot is written, see SharedMemoryRingReader.
+struct SharedFrameHeader
+{
+    std::atomic<uint64_t> sequence;
+    uint64_t frameNumber;
+    uint64_t frameId;
+    uint64_t timestampNs;
+    uint32_t flags;
+    uint32_t pointCloudWidth;
+    uint32_t pointCloudHeight;
+    uint32_t numPoints;
+    float depthScaleFactor;
+    uint32_t reserved;
+};
+
+// Publishes the results of every frame into a ring of fixed-size slots in shared memory, so processes on the same
+// host can use them in place instead of reading files. The oldest slot is overwritten by every new frame, the writer
+// never waits for readers. Every slot is protected by a sequence number (seqlock), so readers do not take a lock
+// and cannot block the writer, see SharedMemoryRingReader.
+class SharedMemoryRing
+{
+public:
+    // The slots hold depth map and intensity image of the given size and as many points as pixels
+    SharedMemoryRing(const std::string& name, size_t numSlots, size_t width, size_t height);
+
+    // Copy the results of a frame into the next slot. A raw depth map is published raw together with its scale
+    // factor. Empty images and a null point cloud are not published, e.g. if the output profile skips them.
+    // Thread-safe, the frames are published one after another.
+    void Publish(uint64_t frameId, uint64_t timestampNs, DepthMapView depthMap,
+        PlaneView<const uint16_t> intensity, const PointCloud* pointCloud);
+
+    uint64_t NumPublishedFrames() const;
+
+private:
+    std::mutex m_mutex;
+    SharedMemoryMapping m_mapping;
+    SharedRingHeader* m_header{};
+};
+
+// Reads the frames of a SharedMemoryRing in place, e.g. in another process:
+//
+//   SharedMemoryRingReader::Frame frame;
+//   if (reader.BeginRead(reader.NumPublishedFrames() - 1, frame))
+//   {
+//       ... use frame.depthMap (raw or metric), frame.intensity and frame.points ...
+//       if (!reader.EndRead(frame)) { ... the slot was overwritten meanwhile, discard the results ... }
+//   }
+//
+// The data is not copied, so the reader has to keep up: a slot is overwritten after numSlots further frames.
+class SharedMemoryRingReader
+{
+public:
+    struct Frame
+    {
+        const SharedFrameHeader* header{};
+        uint64_t sequence{};
+        DepthMapView depthMap{};
+        PlaneView<const uint16_t> intensity{};
+        const PointXYZI* points{};
+    };
+
+    // Throws a std::runtime_error if the ring does not exist or has an unknown layout
+    explicit SharedMemoryRingReader(const std::string& name);
+
+    uint64_t NumPublishedFrames() const;
+
+    // Start reading frame n. Returns false if it is not published, being written or already overwritten.
+    bool BeginRead(uint64_t frameNumber, Frame& frame) const;
+
+    // Returns false if the frame was overwritten while it was read, in which case everything read is invalid
+    bool EndRead(const Frame& frame) const;
+
+private:
+    SharedMemoryMapping m_mapping;
+    const SharedRingHeader* m_header;
+};
+
+} // namespace nion
@@ -0,0 +1,137 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "temporal_filter.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+// Project headers
+#include "latency_statistics.hpp"
+
+namespace nion
+{
+namespace
+{
+
+// Fixed-point resolution of the sums of 1/16 mm, which is far below the noise of the depth values. 255 depth maps
+// of up to 500 m fit into the sums.
+constexpr float fixedPointScale = 16.0F;
+constexpr size_t maxFrameCount = std::numeric_limits<uint8_t>::max();
+
+int32_t ToFixedPoint(float depthMm)
+{
+    return static_cast<int32_t>(std::lround(depthMm * fixedPointScale));
+}
+
+} // namespace
+
+TemporalDepthFilter::TemporalDepthFilter(size_t width, size_t height, const TemporalFilterSettings& settings)
+    : m_settings(settings)
+    , m_width(width)
+    , m_height(height)
+    , m_sums(width * height)
+    , m_counts(width * height)
+{
+    if (settings.frameCount < 2 || settings.frameCount > maxFrameCount)
+    {
+        throw std::invalid_argument("The temporal filter averages 2 to 255 depth maps.");
+    }
+
+    for (size_t i = 0; i < settings.frameCount; ++i)
+    {
+        m_depthHistory.emplace_back(width, height);
+        m_validHistory.emplace_back(width, height);
+    }
+}
+
+void TemporalDepthFilter::Apply(PlaneView<float> depth, PlaneView<uint8_t> depthValid)
+{
+    if (depth.width != m_width || depth.height != m_height || depthValid.width != m_width
+        || depthValid.height != m_height)
+    {
+        throw std::invalid_argument("The depth map does not have the size of the temporal filter.");
+    }
+
+    const ScopedLatency latency(LatencyStage::TemporalFiltering);
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    // The oldest depth map leaves the ring, and the new one takes its place
+    const auto isFull = m_numFrames == m_depthHistory.size();
+    const auto history = m_depthHistory[m_nextFrame].View();
+    const auto historyValid = m_validHistory[m_nextFrame].View();
+
+    const auto minValidCount = std::max<size_t>(m_settings.minValidCount, 1);
+    const auto maxDeviation = static_cast<int64_t>(m_settings.maxDeviationMm * fixedPointScale);
+
+    for (size_t y = 0; y < m_height; ++y)
+    {
+        auto* depthRow = depth.Row(y);
+        auto* validRow = depthValid.Row(y);
+        auto* historyRow = history.Row(y);
+        auto* historyValidRow = historyValid.Row(y);
+        auto* sums = m_sums.data() + y * m_width;
+        auto* counts = m_counts.data() + y * m_width;
+
+        for (size_t x = 0; x < m_width; ++x)
+        {
+            if (isFull && historyValidRow[x])
+            {
+                sums[x] -= historyRow[x];
+                --counts[x];
+            }
+
+            const auto isValid = validRow[x] != 0;
+            const auto value = isValid ? ToFixedPoint(depthRow[x]) : 0;
+            historyRow[x] = value;
+            historyValidRow[x] = isValid ? 1 : 0;
+
+            // Compared to the average of the earlier depth maps, before the new value is added
+            const auto isDeviating = isValid && maxDeviation > 0 && counts[x] > 0
+                && std::abs(static_cast<int64_t>(value) * counts[x] - sums[x]) > maxDeviation * counts[x];
+
+            if (isValid)
+            {
+                sums[x] += value;
+                ++counts[x];
+            }
+
+            if (isDeviating)
+            {
+                continue;
+            }
+
+            if (counts[x] >= minValidCount)
+            {
+                depthRow[x] = static_cast<float>(sums[x]) / (static_cast<float>(counts[x]) * fixedPointScale);
+                validRow[x] = 1;
+            }
+            else
+            {
+                depthRow[x] = 0.0F;
+                validRow[x] = 0;
+            }
+        }
+    }
+
+    m_nextFrame = (m_nextFrame + 1) % m_depthHistory.size();
+    m_numFrames = std::min(m_numFrames + 1, m_depthHistory.size());
+}
+
+} // namespace nion
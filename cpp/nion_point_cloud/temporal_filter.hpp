@@ -0,0 +1,75 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Project headers
+#include "image_plane.hpp"
+
+namespace nion
+{
+
+struct TemporalFilterSettings
+{
+    // Number of depth maps averaged, including the current one. 0 or 1 disables the filter. At most 255.
+    size_t frameCount{};
+
+    // Pixels that are valid in fewer of these depth maps are invalid. Pixels that are invalid in the current depth
+    // map but valid often enough in the earlier ones get the average of the earlier ones.
+    size_t minValidCount{ 1 };
+
+    // Pixels whose new depth deviates more than this from the average of the earlier depth maps keep their new
+    // depth, so moving objects are not smeared. 0 filters all pixels.
+    float maxDeviationMm{};
+};
+
+// Running average of the last depth maps of a camera with per-pixel validity. The depth maps are kept in a ring of
+// preallocated frames, together with the sum and count of the valid values of every pixel. Every new depth map
+// replaces the oldest one in the sums, so the cost per frame does not depend on the number of averaged frames.
+// The sums are kept in fixed point, so that adding and removing a depth map leaves no rounding error behind.
+class TemporalDepthFilter
+{
+public:
+    TemporalDepthFilter(size_t width, size_t height, const TemporalFilterSettings& settings);
+
+    // Add the depth map to the history and replace it with the average. Invalid pixels are 0 with a validity of 0.
+    // Can be called from several threads, in which case the depth maps are averaged in the order of the calls.
+    void Apply(PlaneView<float> depth, PlaneView<uint8_t> depthValid);
+
+private:
+    TemporalFilterSettings m_settings;
+    size_t m_width;
+    size_t m_height;
+
+    std::mutex m_mutex;
+
+    // Depth maps in fixed point with their validity, the oldest one at m_nextFrame once the ring is full
+    std::vector<Plane<int32_t>> m_depthHistory;
+    std::vector<Plane<uint8_t>> m_validHistory;
+    size_t m_nextFrame{};
+    size_t m_numFrames{};
+
+    // Sum and number of the valid values of every pixel in the history
+    std::vector<int32_t> m_sums;
+    std::vector<uint8_t> m_counts;
+};
+
+} // namespace nion
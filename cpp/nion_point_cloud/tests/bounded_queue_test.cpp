@@ -0,0 +1,192 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "bounded_queue.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+void TestFifoOrder()
+{
+    nion::BoundedQueue<int> queue(3);
+    NION_CHECK(queue.Push(1));
+    NION_CHECK(queue.TryPush(2));
+    NION_CHECK(queue.Push(3));
+    NION_CHECK(queue.Size() == 3);
+
+    int value{};
+    for (int expected = 1; expected <= 3; ++expected)
+    {
+        NION_CHECK(queue.Pop(value));
+        NION_CHECK(value == expected);
+    }
+    NION_CHECK(queue.Size() == 0);
+}
+
+void TestTryPushOnFullQueue()
+{
+    nion::BoundedQueue<int> queue(2);
+    NION_CHECK(queue.TryPush(1));
+    NION_CHECK(queue.TryPush(2));
+    NION_CHECK(!queue.TryPush(3));
+    NION_CHECK(queue.Size() == 2);
+}
+
+void TestTryPopOnEmptyQueue()
+{
+    nion::BoundedQueue<int> queue(2);
+    int value = 5;
+    NION_CHECK(!queue.TryPop(value));
+    NION_CHECK(value == 5);
+}
+
+void TestPushDropOldest()
+{
+    nion::BoundedQueue<std::unique_ptr<int>> queue(2);
+    std::vector<std::unique_ptr<int>> removed;
+    for (int i = 0; i < 5; ++i)
+    {
+        NION_CHECK(queue.PushDropOldest(std::make_unique<int>(i), removed));
+    }
+
+    NION_CHECK(queue.Size() == 2);
+    NION_CHECK(removed.size() == 3);
+    for (int i = 0; i < 3; ++i)
+    {
+        NION_CHECK(*removed[static_cast<size_t>(i)] == i);
+    }
+
+    std::unique_ptr<int> value;
+    NION_CHECK(queue.Pop(value) && *value == 3);
+    NION_CHECK(queue.Pop(value) && *value == 4);
+}
+
+void TestCloseKeepsRemainingElements()
+{
+    nion::BoundedQueue<int> queue(2);
+    NION_CHECK(queue.Push(1));
+    queue.Close();
+
+    std::vector<int> removed;
+    NION_CHECK(!queue.Push(2));
+    NION_CHECK(!queue.TryPush(2));
+    NION_CHECK(!queue.PushDropOldest(2, removed));
+
+    int value{};
+    NION_CHECK(queue.Pop(value) && value == 1);
+    NION_CHECK(!queue.Pop(value));
+}
+
+void TestCloseWakesWaitingThreads()
+{
+    nion::BoundedQueue<int> emptyQueue(1);
+    nion::BoundedQueue<int> fullQueue(1);
+    NION_CHECK(fullQueue.Push(1));
+
+    std::atomic<bool> hasPopped{ true };
+    std::atomic<bool> hasPushed{ true };
+    std::thread consumer([&] {
+        int value{};
+        hasPopped = emptyQueue.Pop(value);
+    });
+    std::thread producer([&] {
+        hasPushed = fullQueue.Push(2);
+    });
+
+    emptyQueue.Close();
+    fullQueue.Close();
+    consumer.join();
+    producer.join();
+
+    NION_CHECK(!hasPopped);
+    NION_CHECK(!hasPushed);
+}
+
+// Every element pushed by the producers is popped exactly once, and a full queue blocks the producers
+void TestProducersAndConsumers()
+{
+    constexpr int numProducers = 4;
+    constexpr int numConsumers = 3;
+    constexpr int numValuesPerProducer = 10000;
+
+    nion::BoundedQueue<int> queue(8);
+    std::vector<std::atomic<int>> counts(numProducers * numValuesPerProducer);
+    for (auto& count : counts)
+    {
+        count = 0;
+    }
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < numConsumers; ++c)
+    {
+        consumers.emplace_back([&] {
+            int value{};
+            while (queue.Pop(value))
+            {
+                NION_CHECK(queue.Size() <= queue.Capacity());
+                ++counts[static_cast<size_t>(value)];
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; ++p)
+    {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < numValuesPerProducer; ++i)
+            {
+                queue.Push(p * numValuesPerProducer + i);
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    queue.Close();
+    for (auto& consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    for (const auto& count : counts)
+    {
+        NION_CHECK(count == 1);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "FifoOrder", TestFifoOrder },
+        { "TryPushOnFullQueue", TestTryPushOnFullQueue },
+        { "TryPopOnEmptyQueue", TestTryPopOnEmptyQueue },
+        { "PushDropOldest", TestPushDropOldest },
+        { "CloseKeepsRemainingElements", TestCloseKeepsRemainingElements },
+        { "CloseWakesWaitingThreads", TestCloseWakesWaitingThreads },
+        { "ProducersAndConsumers", TestProducersAndConsumers },
+    });
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// Project headers
+#include "depth_conversion.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+constexpr float scaleFactor = 0.1F;
+
+// Raw values whose metric values lie exactly on the bounds of the valid interval, just inside and outside of it, the
+// invalid values 0 and 65535 and everything in between
+std::vector<uint16_t> CreateRawDepth(size_t numPixels)
+{
+    const uint16_t special[] = { 0, 1, 999, 1000, 1001, 39999, 40000, 40001, 65534, 65535 };
+
+    std::vector<uint16_t> rawDepth(numPixels);
+    for (size_t i = 0; i < numPixels; ++i)
+    {
+        rawDepth[i] = (i % 3 == 0) ? special[(i / 3) % 10] : static_cast<uint16_t>((i * 7919) % 65536);
+    }
+    return rawDepth;
+}
+
+// The bounds are the metric values of raw values, so the comparison on the bounds is exact
+float Bound(uint16_t rawValue)
+{
+    return static_cast<float>(rawValue) * scaleFactor;
+}
+
+void TestScalar()
+{
+    const auto implementations = nion::DepthConversionImplementations();
+    NION_CHECK(!implementations.empty() && std::strcmp(implementations.front().name, "Scalar") == 0);
+
+    const std::vector<uint16_t> rawDepth{ 0, 999, 1000, 1001, 40000, 40001, 65535 };
+    std::vector<float> depth(rawDepth.size(), -1.0F);
+    std::vector<uint8_t> valid(rawDepth.size(), 2);
+    implementations.front().convert(
+        rawDepth.data(), rawDepth.size(), scaleFactor, Bound(1000), Bound(40000), depth.data(), valid.data());
+
+    NION_CHECK((valid == std::vector<uint8_t>{ 0, 0, 1, 1, 1, 0, 0 }));
+    NION_CHECK(depth[0] == 0.0F && depth[1] == 0.0F && depth[5] == 0.0F && depth[6] == 0.0F);
+    NION_CHECK(depth[2] == Bound(1000) && depth[3] == Bound(1001) && depth[4] == Bound(40000));
+}
+
+// Every implementation the CPU supports gives bit-identical results, also for lengths that are not multiples of the
+// vector width and for unaligned start addresses
+void TestImplementationsMatchScalar()
+{
+    const auto implementations = nion::DepthConversionImplementations();
+    const auto& scalar = implementations.front();
+
+    const auto rawDepth = CreateRawDepth(1000);
+    const struct
+    {
+        float minimum;
+        float maximum;
+    } intervals[] = { { Bound(1000), Bound(40000) }, { Bound(0), Bound(65535) },
+        { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max() }, { Bound(2), Bound(1) } };
+
+    for (const auto& implementation : implementations)
+    {
+        for (const auto& interval : intervals)
+        {
+            for (size_t offset = 0; offset < 3; ++offset)
+            {
+                for (size_t numPixels = 0; numPixels <= 70; ++numPixels)
+                {
+                    std::vector<float> expectedDepth(numPixels + 1, -1.0F);
+                    std::vector<uint8_t> expectedValid(numPixels + 1, 2);
+                    scalar.convert(rawDepth.data() + offset, numPixels, scaleFactor, interval.minimum,
+                        interval.maximum, expectedDepth.data(), expectedValid.data());
+
+                    std::vector<float> depth(numPixels + 1, -1.0F);
+                    std::vector<uint8_t> valid(numPixels + 1, 2);
+                    implementation.convert(rawDepth.data() + offset, numPixels, scaleFactor, interval.minimum,
+                        interval.maximum, depth.data(), valid.data());
+
+                    // Also checks that nothing is written after the last pixel
+                    NION_CHECK(std::memcmp(depth.data(), expectedDepth.data(), depth.size() * sizeof(float)) == 0);
+                    NION_CHECK(valid == expectedValid);
+                }
+            }
+
+            std::vector<float> expectedDepth(rawDepth.size());
+            std::vector<uint8_t> expectedValid(rawDepth.size());
+            scalar.convert(rawDepth.data(), rawDepth.size(), scaleFactor, interval.minimum, interval.maximum,
+                expectedDepth.data(), expectedValid.data());
+
+            std::vector<float> depth(rawDepth.size());
+            std::vector<uint8_t> valid(rawDepth.size());
+            implementation.convert(rawDepth.data(), rawDepth.size(), scaleFactor, interval.minimum, interval.maximum,
+                depth.data(), valid.data());
+            NION_CHECK(std::memcmp(depth.data(), expectedDepth.data(), depth.size() * sizeof(float)) == 0);
+            NION_CHECK(valid == expectedValid);
+        }
+    }
+}
+
+// ConvertDepth() uses the last, fastest implementation
+void TestSelectedImplementation()
+{
+    const auto implementations = nion::DepthConversionImplementations();
+    NION_CHECK(std::strcmp(nion::DepthConversionInstructionSet(), implementations.back().name) == 0);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "Scalar", TestScalar },
+        { "ImplementationsMatchScalar", TestImplementationsMatchScalar },
+        { "SelectedImplementation", TestSelectedImplementation },
+    });
+}
@@ -0,0 +1,440 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// IDS peak headers
+#include <peak_icv/peak_icv.hpp>
+
+// Project headers
+#include "direct_processing.hpp"
+#include "file_output.hpp"
+#include "processing.hpp"
+#include "recording.hpp"
+#include "test.hpp"
+
+// Compares the results of the direct backend with the ones of the ICV backend, frame by frame, on the first frames of
+// a recording of the example. The recording is given as the first argument or with the environment variable
+// NION_POINT_CLOUD_TEST_RECORDING, see README.md. Without one, the test is skipped.
+
+namespace
+{
+
+constexpr size_t maxNumFrames = 10;
+
+// Interpolation and rounding differ between the backends, so values within the tolerances are equal, and a small
+// share of the pixels, mostly at depth edges, may differ more or be valid in only one of the depth maps
+constexpr float depthToleranceMm = 2.0F;
+constexpr float depthRelativeTolerance = 0.01F;
+constexpr float intensityTolerance = 8.0F;
+constexpr float intensityRelativeTolerance = 0.02F;
+constexpr double maxMismatchShare = 0.01;
+constexpr double maxValidityMismatchShare = 0.02;
+constexpr double maxPointCountDeviation = 0.02;
+constexpr double maxCentroidDeviationMm = 5.0;
+
+std::string recordingFilePath;
+
+template <typename T>
+peak::common::ImageView ToImageView(const nion::Plane<T>& plane, peak::common::PixelFormat pixelFormat)
+{
+    const auto view = plane.View();
+    return peak::common::ImageView(pixelFormat, peak::common::Size{ view.width, view.height },
+        reinterpret_cast<uint8_t*>(const_cast<T*>(view.data)), view.NumPixels() * sizeof(T));
+}
+
+bool IsWithin(float a, float b, float tolerance, float relativeTolerance)
+{
+    return std::abs(a - b) <= std::max(tolerance, relativeTolerance * std::max(std::abs(a), std::abs(b)));
+}
+
+// Points of a PLY file written by the PointCloudWriter, as x, y and z in millimeters
+std::vector<nion::PointXYZI> ReadPlyPoints(const std::string& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    std::string format;
+    size_t numPoints = 0;
+    std::vector<std::string> propertyTypes;
+    std::vector<std::string> propertyNames;
+    auto isVertexElement = false;
+    for (std::string line; std::getline(file, line) && line.compare(0, 10, "end_header") != 0;)
+    {
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+        if (keyword == "format")
+        {
+            words >> format;
+        }
+        else if (keyword == "element")
+        {
+            std::string name;
+            words >> name;
+            isVertexElement = (name == "vertex");
+            if (isVertexElement)
+            {
+                words >> numPoints;
+            }
+        }
+        else if (keyword == "property" && isVertexElement)
+        {
+            std::string type;
+            std::string name;
+            words >> type >> name;
+            propertyTypes.push_back(type);
+            propertyNames.push_back(name);
+        }
+    }
+
+    auto readValue = [&](const std::string& type) {
+        if (format == "ascii")
+        {
+            double value{};
+            file >> value;
+            return value;
+        }
+        if (format != "binary_little_endian")
+        {
+            throw std::runtime_error("Unsupported PLY format: " + format);
+        }
+        if (type == "float" || type == "float32")
+        {
+            float value{};
+            file.read(reinterpret_cast<char*>(&value), sizeof(value));
+            return static_cast<double>(value);
+        }
+        if (type == "double" || type == "float64")
+        {
+            double value{};
+            file.read(reinterpret_cast<char*>(&value), sizeof(value));
+            return value;
+        }
+        if (type == "ushort" || type == "uint16")
+        {
+            uint16_t value{};
+            file.read(reinterpret_cast<char*>(&value), sizeof(value));
+            return static_cast<double>(value);
+        }
+        if (type == "uchar" || type == "uint8")
+        {
+            uint8_t value{};
+            file.read(reinterpret_cast<char*>(&value), sizeof(value));
+            return static_cast<double>(value);
+        }
+        throw std::runtime_error("Unsupported PLY property type: " + type);
+    };
+
+    std::vector<nion::PointXYZI> points(numPoints);
+    for (auto& point : points)
+    {
+        for (size_t p = 0; p < propertyTypes.size(); ++p)
+        {
+            const auto value = static_cast<float>(readValue(propertyTypes[p]));
+            if (propertyNames[p] == "x")
+            {
+                point.x = value;
+            }
+            else if (propertyNames[p] == "y")
+            {
+                point.y = value;
+            }
+            else if (propertyNames[p] == "z")
+            {
+                point.z = value;
+            }
+        }
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to read the points of file: " + filePath);
+    }
+
+    return points;
+}
+
+struct Centroid
+{
+    double x{};
+    double y{};
+    double z{};
+};
+
+// Mean position of the points with a finite depth
+template <typename Points>
+Centroid ComputeCentroid(const Points& points)
+{
+    Centroid centroid;
+    size_t numPoints = 0;
+    for (const auto& point : points)
+    {
+        if (std::isfinite(point.z) && point.z > 0.0F)
+        {
+            centroid.x += point.x;
+            centroid.y += point.y;
+            centroid.z += point.z;
+            ++numPoints;
+        }
+    }
+
+    if (numPoints > 0)
+    {
+        centroid.x /= static_cast<double>(numPoints);
+        centroid.y /= static_cast<double>(numPoints);
+        centroid.z /= static_cast<double>(numPoints);
+    }
+
+    return centroid;
+}
+
+// Processing parameters of the recorded frames
+nion::ProcessingParameters CreateParameters(const nion::RecordingInfo& info)
+{
+    nion::ProcessingParameters parameters;
+    parameters.scaleFactor = info.scaleFactor;
+    parameters.validDepthInterval = { info.validDepthMin, info.validDepthMax };
+    parameters.geometry = info.geometry;
+    parameters.metadata = nion::CreateImageMetadata(info.geometry);
+    return parameters;
+}
+
+void TestBackendsAgree()
+{
+    nion::RecordingReader reader(recordingFilePath);
+    const auto& info = reader.Info();
+    const auto width = info.geometry.width;
+    const auto height = info.geometry.height;
+
+    const peak::icv::CalibrationParameters calibration(info.calibrationData);
+    const auto parameters = CreateParameters(info);
+
+    auto directParameters = parameters;
+    directParameters.backend = nion::ProcessingBackend::Direct;
+    const nion::DirectProcessor directProcessor(calibration, directParameters);
+    nion::FrameWorkspace workspace(width, height);
+
+    peak::icv::Undistortion undistortion(calibration);
+    const auto pointCloudFilePath = nion::GetOutputFilePath() + "direct_processing_test.ply";
+    const peak::icv::PointCloudWriter pointCloudWriter;
+
+    nion::RecordedFrame frame;
+    size_t numFrames = 0;
+    while (numFrames < maxNumFrames && reader.ReadFrame(frame))
+    {
+        ++numFrames;
+
+        const auto icvDepth = nion::ProcessDepthMap(
+            ToImageView(frame.depthMap, peak::common::PixelFormat::Coord3D_C16), undistortion, parameters);
+        const auto icvIntensity = nion::ProcessIntensity(
+            ToImageView(frame.intensity, peak::common::PixelFormat::Mono16), undistortion, parameters);
+        NION_CHECK(icvDepth.Width() == width && icvDepth.Height() == height);
+        NION_CHECK(icvIntensity.Width() == width && icvIntensity.Height() == height);
+
+        directProcessor.ProcessDepthMap(nion::AsConst(frame.depthMap.View()), workspace);
+        directProcessor.UndistortIntensity(nion::AsConst(frame.intensity.View()), workspace);
+        directProcessor.ConvertDepthMap(workspace);
+        directProcessor.CreatePointCloud(workspace);
+
+        const auto* icvDepthValues = reinterpret_cast<const float*>(icvDepth.Data());
+        const auto* icvIntensityValues = reinterpret_cast<const uint16_t*>(icvIntensity.Data());
+        const auto directDepth = workspace.depth.View();
+        const auto directValid = workspace.depthValid.View();
+        const auto directIntensity = workspace.intensity.View();
+
+        size_t numDepthMismatches = 0;
+        size_t numValidityMismatches = 0;
+        size_t numIntensityMismatches = 0;
+        for (size_t y = 0; y < height; ++y)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                const auto icvValue = icvDepthValues[y * width + x];
+                const auto isIcvValid = std::isfinite(icvValue) && icvValue >= info.validDepthMin
+                    && icvValue <= info.validDepthMax && icvValue > 0.0F;
+                const auto isDirectValid = directValid.Row(y)[x] != 0;
+
+                if (isIcvValid != isDirectValid)
+                {
+                    ++numValidityMismatches;
+                }
+                else if (isIcvValid
+                    && !IsWithin(icvValue, directDepth.Row(y)[x], depthToleranceMm, depthRelativeTolerance))
+                {
+                    ++numDepthMismatches;
+                }
+
+                if (!IsWithin(static_cast<float>(icvIntensityValues[y * width + x]),
+                        static_cast<float>(directIntensity.Row(y)[x]), intensityTolerance,
+                        intensityRelativeTolerance))
+                {
+                    ++numIntensityMismatches;
+                }
+            }
+        }
+
+        const auto numPixels = static_cast<double>(width) * static_cast<double>(height);
+        std::cout << "Frame " << frame.frameId << ": " << numDepthMismatches << " depth, " << numValidityMismatches
+                  << " validity and " << numIntensityMismatches << " intensity mismatches of " << numPixels
+                  << " pixels." << std::endl;
+        NION_CHECK(static_cast<double>(numDepthMismatches) <= maxMismatchShare * numPixels);
+        NION_CHECK(static_cast<double>(numValidityMismatches) <= maxValidityMismatchShare * numPixels);
+        NION_CHECK(static_cast<double>(numIntensityMismatches) <= maxMismatchShare * numPixels);
+
+        // The points of the ICV backend are only accessible in the files of the PointCloudWriter
+        pointCloudWriter.Write(pointCloudFilePath, peak::icv::PointCloudXYZI(icvDepth, icvIntensity));
+        const auto icvPoints = ReadPlyPoints(pointCloudFilePath);
+        const auto& directPoints = workspace.pointCloud.points;
+
+        const auto numIcvPoints = static_cast<double>(icvPoints.size());
+        const auto numDirectPoints = static_cast<double>(directPoints.size());
+        NION_CHECK(std::abs(numIcvPoints - numDirectPoints) <= maxPointCountDeviation * numIcvPoints);
+
+        const auto icvCentroid = ComputeCentroid(icvPoints);
+        const auto directCentroid = ComputeCentroid(directPoints);
+        NION_CHECK(std::abs(icvCentroid.x - directCentroid.x) <= maxCentroidDeviationMm);
+        NION_CHECK(std::abs(icvCentroid.y - directCentroid.y) <= maxCentroidDeviationMm);
+        NION_CHECK(std::abs(icvCentroid.z - directCentroid.z) <= maxCentroidDeviationMm);
+    }
+
+    std::remove(pointCloudFilePath.c_str());
+    NION_CHECK(numFrames > 0);
+}
+
+// Only the pixels of the work area are processed, the valid bounds are the bounding box of its valid pixels, and
+// organized point clouds have the size of the work area
+void TestWorkArea()
+{
+    nion::RecordingReader reader(recordingFilePath);
+    const auto& info = reader.Info();
+    const size_t width = info.geometry.width;
+    const size_t height = info.geometry.height;
+    const nion::PixelRegion area{ width / 4, height / 4, width / 2, height / 2 };
+
+    const peak::icv::CalibrationParameters calibration(info.calibrationData);
+    auto parameters = CreateParameters(info);
+    parameters.backend = nion::ProcessingBackend::Direct;
+    parameters.workArea = area;
+    const nion::DirectProcessor unorganizedProcessor(calibration, parameters);
+    parameters.organizedPointCloud = true;
+    const nion::DirectProcessor organizedProcessor(calibration, parameters);
+    const auto& workArea = organizedProcessor.WorkArea();
+    NION_CHECK(workArea.x == area.x && workArea.y == area.y);
+    NION_CHECK(workArea.width == area.width && workArea.height == area.height);
+
+    nion::FrameWorkspace workspace(width, height);
+    nion::RecordedFrame frame;
+    size_t numFrames = 0;
+    while (numFrames < maxNumFrames && reader.ReadFrame(frame))
+    {
+        ++numFrames;
+
+        unorganizedProcessor.ProcessDepthMap(nion::AsConst(frame.depthMap.View()), workspace);
+        unorganizedProcessor.UndistortIntensity(nion::AsConst(frame.intensity.View()), workspace);
+        NION_CHECK(workspace.workArea.x == area.x && workspace.workArea.y == area.y);
+        NION_CHECK(workspace.workArea.width == area.width && workspace.workArea.height == area.height);
+
+        size_t numValid = 0;
+        auto minX = width;
+        size_t maxX = 0;
+        auto minY = height;
+        size_t maxY = 0;
+        const auto valid = workspace.depthValid.View();
+        for (size_t y = 0; y < height; ++y)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                if (valid.Row(y)[x] == 0)
+                {
+                    continue;
+                }
+
+                NION_CHECK(x >= area.x && x < area.x + area.width && y >= area.y && y < area.y + area.height);
+                ++numValid;
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x + 1);
+                minY = std::min(minY, y);
+                maxY = std::max(maxY, y + 1);
+            }
+        }
+
+        const auto& bounds = workspace.validBounds;
+        if (numValid > 0)
+        {
+            NION_CHECK(bounds.x == minX && bounds.y == minY);
+            NION_CHECK(bounds.width == maxX - minX && bounds.height == maxY - minY);
+        }
+        else
+        {
+            NION_CHECK(bounds.IsEmpty());
+        }
+
+        unorganizedProcessor.CreatePointCloud(workspace);
+        NION_CHECK(workspace.pointCloud.points.size() == numValid && workspace.pointCloud.height == 1);
+
+        organizedProcessor.CreatePointCloud(workspace);
+        NION_CHECK(workspace.pointCloud.width == area.width && workspace.pointCloud.height == area.height);
+        NION_CHECK(workspace.pointCloud.points.size() == area.width * area.height);
+        const auto numFinite = std::count_if(workspace.pointCloud.points.begin(), workspace.pointCloud.points.end(),
+            [](const nion::PointXYZI& point) { return std::isfinite(point.z); });
+        NION_CHECK(static_cast<size_t>(numFinite) == numValid);
+    }
+
+    NION_CHECK(numFrames > 0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+    {
+        recordingFilePath = argv[1];
+    }
+    else if (const auto* environmentPath = std::getenv("NION_POINT_CLOUD_TEST_RECORDING"))
+    {
+        recordingFilePath = environmentPath;
+    }
+
+    if (recordingFilePath.empty())
+    {
+        std::cout << "No recording given, skipping the comparison of the backends." << std::endl;
+        return nion::test::skipExitCode;
+    }
+
+    peak::icv::library::Init();
+    const auto result = nion::test::Run({
+        { "BackendsAgree", TestBackendsAgree },
+        { "WorkArea", TestWorkArea },
+    });
+    peak::icv::library::Exit();
+
+    return result;
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "file_writer.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+// Holds the writer thread in the first job until it is opened, so the following jobs queue up
+class Gate
+{
+public:
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isWaiting = true;
+        m_changed.notify_all();
+        m_changed.wait(lock, [this] {
+            return m_isOpen;
+        });
+    }
+
+    void WaitUntilWaiting()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this] {
+            return m_isWaiting;
+        });
+    }
+
+    void Open()
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpen = true;
+        m_changed.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_isWaiting{};
+    bool m_isOpen{};
+};
+
+// Frames written by the file writer, in the order of their writes
+class Frames
+{
+public:
+    nion::FileWriteJob Job(int frame, Gate* gate = nullptr)
+    {
+        nion::FileWriteJob job;
+        job.writes.emplace_back([this, frame, gate] {
+            if (gate)
+            {
+                gate->Wait();
+            }
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_written.push_back(frame);
+        });
+        job.onFinished = [this] {
+            ++m_numFinished;
+        };
+        return job;
+    }
+
+    std::vector<int> Written()
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        return m_written;
+    }
+
+    int NumFinished() const
+    {
+        return m_numFinished;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<int> m_written;
+    std::atomic<int> m_numFinished{ 0 };
+};
+
+nion::FileWriterSettings Settings(nion::WriteQueuePolicy policy)
+{
+    nion::FileWriterSettings settings;
+    settings.numThreads = 1;
+    settings.queueCapacity = 2;
+    settings.policy = policy;
+    return settings;
+}
+
+// Under overload, the newest frames are kept and the oldest queued ones dropped, as with latestFrameWinsEnabled
+void TestDropOldest()
+{
+    Frames frames;
+    Gate gate;
+    nion::FileWriter writer(Settings(nion::WriteQueuePolicy::DropOldest));
+
+    NION_CHECK(writer.Submit(frames.Job(1, &gate)));
+    gate.WaitUntilWaiting();
+    for (int frame = 2; frame <= 5; ++frame)
+    {
+        NION_CHECK(writer.Submit(frames.Job(frame)));
+    }
+
+    // The dropped frames are finished right away
+    NION_CHECK(writer.NumDroppedFiles() == 2);
+    NION_CHECK(frames.NumFinished() == 2);
+
+    gate.Open();
+    writer.Finish();
+    NION_CHECK((frames.Written() == std::vector<int>{ 1, 4, 5 }));
+    NION_CHECK(writer.NumWrittenFiles() == 3);
+    NION_CHECK(frames.NumFinished() == 5);
+}
+
+void TestDropNewest()
+{
+    Frames frames;
+    Gate gate;
+    nion::FileWriter writer(Settings(nion::WriteQueuePolicy::DropNewest));
+
+    NION_CHECK(writer.Submit(frames.Job(1, &gate)));
+    gate.WaitUntilWaiting();
+    NION_CHECK(writer.Submit(frames.Job(2)));
+    NION_CHECK(writer.Submit(frames.Job(3)));
+    NION_CHECK(!writer.Submit(frames.Job(4)));
+    NION_CHECK(!writer.Submit(frames.Job(5)));
+    NION_CHECK(writer.NumDroppedFiles() == 2);
+
+    gate.Open();
+    writer.Finish();
+    NION_CHECK((frames.Written() == std::vector<int>{ 1, 2, 3 }));
+    NION_CHECK(frames.NumFinished() == 5);
+}
+
+// A full queue makes the caller wait, and no frame is lost
+void TestBlock()
+{
+    Frames frames;
+    Gate gate;
+    nion::FileWriter writer(Settings(nion::WriteQueuePolicy::Block));
+
+    NION_CHECK(writer.Submit(frames.Job(1, &gate)));
+    gate.WaitUntilWaiting();
+
+    std::atomic<bool> isSubmitted{ false };
+    std::thread producer([&] {
+        for (int frame = 2; frame <= 5; ++frame)
+        {
+            writer.Submit(frames.Job(frame));
+        }
+        isSubmitted = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    NION_CHECK(!isSubmitted);
+
+    gate.Open();
+    producer.join();
+    writer.Finish();
+    NION_CHECK((frames.Written() == std::vector<int>{ 1, 2, 3, 4, 5 }));
+    NION_CHECK(writer.NumDroppedFiles() == 0);
+    NION_CHECK(frames.NumFinished() == 5);
+}
+
+// The files of a frame are queued separately and may be written on several threads
+void TestFilesOfAFrameInParallel()
+{
+    auto settings = Settings(nion::WriteQueuePolicy::Block);
+    settings.numThreads = 3;
+    settings.groupByFrame = false;
+    nion::FileWriter writer(settings);
+
+    std::atomic<int> numWritten{ 0 };
+    std::atomic<int> numFinished{ 0 };
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        nion::FileWriteJob job;
+        for (int file = 0; file < 3; ++file)
+        {
+            job.writes.emplace_back([&] {
+                ++numWritten;
+            });
+        }
+        job.onFinished = [&] {
+            // All files of the frame are written before it is finished
+            NION_CHECK(numWritten >= 3 * (numFinished + 1));
+            ++numFinished;
+        };
+        writer.Submit(std::move(job));
+    }
+
+    writer.Finish();
+    NION_CHECK(numWritten == 30);
+    NION_CHECK(numFinished == 10);
+    NION_CHECK(writer.NumWrittenFiles() == 30);
+}
+
+void TestWriteError()
+{
+    Frames frames;
+    nion::FileWriter writer(Settings(nion::WriteQueuePolicy::Block));
+
+    nion::FileWriteJob failing = frames.Job(1);
+    failing.writes.emplace_back([] {
+        throw std::runtime_error("Disk full");
+    });
+    writer.Submit(std::move(failing));
+
+    // Later submits rethrow the error once it occurred, and still finish their frame
+    auto hasRethrown = false;
+    for (int i = 0; i < 1000 && !hasRethrown; ++i)
+    {
+        try
+        {
+            writer.Submit(frames.Job(2));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        catch (const std::runtime_error&)
+        {
+            hasRethrown = true;
+        }
+    }
+    NION_CHECK(hasRethrown);
+
+    NION_CHECK_THROWS(writer.Finish(), std::runtime_error);
+    NION_CHECK(frames.NumFinished() == static_cast<int>(frames.Written().size()) + 1);
+}
+
+void TestInvalidSettings()
+{
+    auto settings = Settings(nion::WriteQueuePolicy::Block);
+    settings.numThreads = 0;
+    NION_CHECK_THROWS(nion::FileWriter{ settings }, std::invalid_argument);
+
+    settings.numThreads = 1;
+    settings.queueCapacity = 0;
+    NION_CHECK_THROWS(nion::FileWriter{ settings }, std::invalid_argument);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "DropOldest", TestDropOldest },
+        { "DropNewest", TestDropNewest },
+        { "Block", TestBlock },
+        { "FilesOfAFrameInParallel", TestFilesOfAFrameInParallel },
+        { "WriteError", TestWriteError },
+        { "InvalidSettings", TestInvalidSettings },
+    });
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project headers
+#include "frame_synchronizer.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+constexpr uint64_t toleranceNs = 1000;
+
+nion::SynchronizedFrame Frame(size_t camera, uint64_t timestampNs)
+{
+    nion::SynchronizedFrame frame;
+    frame.camera = camera;
+    frame.timestampNs = timestampNs;
+    return frame;
+}
+
+bool Contains(const std::vector<nion::SynchronizedFrame>& frames, size_t camera, uint64_t timestampNs)
+{
+    for (const auto& frame : frames)
+    {
+        if (frame.camera == camera && frame.timestampNs == timestampNs)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TestSlotInCameraOrder()
+{
+    nion::FrameSynchronizer synchronizer(3, toleranceNs, 2);
+    NION_CHECK(synchronizer.Add(Frame(2, 10000)).slot.empty());
+    NION_CHECK(synchronizer.Add(Frame(0, 10500)).slot.empty());
+
+    const auto output = synchronizer.Add(Frame(1, 9800));
+    NION_CHECK(output.slot.size() == 3);
+    NION_CHECK(output.unmatchedFrames.empty());
+    for (size_t c = 0; c < output.slot.size(); ++c)
+    {
+        NION_CHECK(output.slot[c].camera == c);
+    }
+    NION_CHECK(output.slot[0].timestampNs == 10500);
+    NION_CHECK(synchronizer.Flush().empty());
+}
+
+void TestSingleCamera()
+{
+    nion::FrameSynchronizer synchronizer(1, toleranceNs, 2);
+    for (uint64_t i = 0; i < 5; ++i)
+    {
+        const auto output = synchronizer.Add(Frame(0, i * 100000));
+        NION_CHECK(output.slot.size() == 1);
+        NION_CHECK(output.slot[0].timestampNs == i * 100000);
+    }
+    NION_CHECK(synchronizer.NumUnmatchedFrames() == 0);
+}
+
+void TestTolerance()
+{
+    nion::FrameSynchronizer synchronizer(2, toleranceNs, 4);
+    NION_CHECK(synchronizer.Add(Frame(0, 100000)).slot.empty());
+    NION_CHECK(synchronizer.Add(Frame(1, 100000 + toleranceNs + 1)).slot.empty());
+
+    // Exactly at the tolerance
+    NION_CHECK(synchronizer.Add(Frame(1, 200000)).slot.empty());
+    const auto output = synchronizer.Add(Frame(0, 200000 + toleranceNs));
+    NION_CHECK(output.slot.size() == 2);
+    NION_CHECK(output.slot[0].timestampNs == 200000 + toleranceNs);
+    NION_CHECK(output.slot[1].timestampNs == 200000);
+
+    // The frames of the first period can no longer be part of a slot
+    NION_CHECK(output.unmatchedFrames.size() == 2);
+    NION_CHECK(Contains(output.unmatchedFrames, 0, 100000));
+    NION_CHECK(Contains(output.unmatchedFrames, 1, 100000 + toleranceNs + 1));
+    NION_CHECK(synchronizer.NumUnmatchedFrames() == 2);
+}
+
+// The frames of a camera are processed in parallel, so they may be added out of order
+void TestOutOfOrderFrames()
+{
+    nion::FrameSynchronizer synchronizer(2, toleranceNs, 4);
+    NION_CHECK(synchronizer.Add(Frame(0, 200000)).slot.empty());
+    NION_CHECK(synchronizer.Add(Frame(0, 100000)).slot.empty());
+
+    auto output = synchronizer.Add(Frame(1, 100200));
+    NION_CHECK(output.slot.size() == 2);
+    NION_CHECK(output.slot[0].timestampNs == 100000);
+    NION_CHECK(output.unmatchedFrames.empty());
+
+    output = synchronizer.Add(Frame(1, 199900));
+    NION_CHECK(output.slot.size() == 2);
+    NION_CHECK(output.slot[0].timestampNs == 200000);
+    NION_CHECK(synchronizer.NumUnmatchedFrames() == 0);
+}
+
+void TestLateFrame()
+{
+    nion::FrameSynchronizer synchronizer(2, toleranceNs, 4);
+    synchronizer.Add(Frame(0, 200000));
+    NION_CHECK(synchronizer.Add(Frame(1, 200000)).slot.size() == 2);
+
+    // Older than the last slot
+    const auto output = synchronizer.Add(Frame(1, 100000));
+    NION_CHECK(output.slot.empty());
+    NION_CHECK(output.unmatchedFrames.size() == 1);
+    NION_CHECK(output.unmatchedFrames[0].timestampNs == 100000);
+    NION_CHECK(synchronizer.NumUnmatchedFrames() == 1);
+    NION_CHECK(synchronizer.Flush().empty());
+}
+
+void TestMaxPendingFrames()
+{
+    nion::FrameSynchronizer synchronizer(2, toleranceNs, 2);
+    NION_CHECK(synchronizer.Add(Frame(0, 100000)).unmatchedFrames.empty());
+    NION_CHECK(synchronizer.Add(Frame(0, 200000)).unmatchedFrames.empty());
+
+    // The oldest frame of the camera is given up
+    const auto output = synchronizer.Add(Frame(0, 300000));
+    NION_CHECK(output.slot.empty());
+    NION_CHECK(output.unmatchedFrames.size() == 1);
+    NION_CHECK(output.unmatchedFrames[0].timestampNs == 100000);
+
+    NION_CHECK(synchronizer.Add(Frame(1, 300000)).slot.size() == 2);
+    NION_CHECK(synchronizer.NumUnmatchedFrames() == 2);
+}
+
+void TestFlush()
+{
+    nion::FrameSynchronizer synchronizer(3, toleranceNs, 4);
+    synchronizer.Add(Frame(0, 100000));
+    synchronizer.Add(Frame(2, 100000));
+    synchronizer.Add(Frame(2, 200000));
+
+    const auto frames = synchronizer.Flush();
+    NION_CHECK(frames.size() == 3);
+    NION_CHECK(Contains(frames, 0, 100000));
+    NION_CHECK(Contains(frames, 2, 200000));
+    NION_CHECK(synchronizer.NumUnmatchedFrames() == 3);
+    NION_CHECK(synchronizer.Flush().empty());
+}
+
+// Every frame is returned exactly once, either in a slot or as unmatched
+void TestEveryFrameIsReturned()
+{
+    constexpr size_t numCameras = 3;
+    constexpr uint64_t numPeriods = 200;
+
+    nion::FrameSynchronizer synchronizer(numCameras, toleranceNs, 3);
+    size_t numReturned = 0;
+    size_t numSlots = 0;
+    for (uint64_t period = 0; period < numPeriods; ++period)
+    {
+        for (size_t c = 0; c < numCameras; ++c)
+        {
+            // Camera 2 loses every tenth frame, and camera 1 delivers pairs of frames swapped
+            if (c == 2 && period % 10 == 5)
+            {
+                continue;
+            }
+            const auto swappedPeriod = (c == 1) ? (period ^ 1) : period;
+            const auto output = synchronizer.Add(Frame(c, swappedPeriod * 100000 + c * 100));
+
+            numReturned += output.slot.size() + output.unmatchedFrames.size();
+            numSlots += output.slot.empty() ? 0 : 1;
+        }
+    }
+    numReturned += synchronizer.Flush().size();
+
+    const auto numAdded = numCameras * numPeriods - numPeriods / 10;
+    NION_CHECK(numReturned == numAdded);
+    NION_CHECK(numSlots * numCameras + synchronizer.NumUnmatchedFrames() == numAdded);
+    NION_CHECK(numSlots >= numPeriods - 2 * numPeriods / 10);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "SlotInCameraOrder", TestSlotInCameraOrder },
+        { "SingleCamera", TestSingleCamera },
+        { "Tolerance", TestTolerance },
+        { "OutOfOrderFrames", TestOutOfOrderFrames },
+        { "LateFrame", TestLateFrame },
+        { "MaxPendingFrames", TestMaxPendingFrames },
+        { "Flush", TestFlush },
+        { "EveryFrameIsReturned", TestEveryFrameIsReturned },
+    });
+}
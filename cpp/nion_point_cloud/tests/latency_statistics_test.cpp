@@ -0,0 +1,168 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "latency_statistics.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+void TestEmptyHistogram()
+{
+    nion::LatencyHistogram histogram;
+    NION_CHECK(histogram.Count() == 0);
+    NION_CHECK(histogram.Max() == 0);
+    NION_CHECK(histogram.Percentile(50.0) == 0);
+}
+
+void TestSmallValuesAreExact()
+{
+    nion::LatencyHistogram histogram;
+    for (uint64_t value = 0; value < 16; ++value)
+    {
+        histogram.Record(value);
+    }
+
+    NION_CHECK(histogram.Count() == 16);
+    NION_CHECK(histogram.Max() == 15);
+    NION_CHECK(histogram.Percentile(0.0) == 0);
+    NION_CHECK(histogram.Percentile(50.0) == 7);
+    NION_CHECK(histogram.Percentile(100.0) == 15);
+}
+
+// The percentile is the upper bound of its bucket, which is less than 7 % above the recorded value
+void TestRelativeError()
+{
+    for (uint64_t value = 16; value < (uint64_t{ 1 } << 40); value = value * 3 / 2 + 1)
+    {
+        nion::LatencyHistogram histogram;
+        histogram.Record(value);
+        histogram.Record(value * 4);
+
+        const auto percentile = histogram.Percentile(50.0);
+        NION_CHECK(percentile >= value);
+        NION_CHECK(static_cast<double>(percentile - value) < 0.07 * static_cast<double>(value));
+    }
+
+    nion::LatencyHistogram histogram;
+    histogram.Record(UINT64_MAX);
+    NION_CHECK(histogram.Percentile(50.0) == UINT64_MAX);
+}
+
+void TestPercentiles()
+{
+    nion::LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i)
+    {
+        histogram.Record(1000);
+    }
+    histogram.Record(1000000);
+
+    NION_CHECK(histogram.Count() == 100);
+    NION_CHECK(histogram.Max() == 1000000);
+    NION_CHECK(histogram.Percentile(50.0) >= 1000 && histogram.Percentile(50.0) < 1070);
+    NION_CHECK(histogram.Percentile(99.0) >= 1000 && histogram.Percentile(99.0) < 1070);
+
+    // Limited to the maximum instead of the upper bound of its bucket
+    NION_CHECK(histogram.Percentile(100.0) == 1000000);
+}
+
+void TestConcurrentRecording()
+{
+    constexpr int numThreads = 4;
+    constexpr uint64_t numValuesPerThread = 100000;
+
+    nion::LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&histogram, t] {
+            for (uint64_t i = 0; i < numValuesPerThread; ++i)
+            {
+                histogram.Record(i * numThreads + static_cast<uint64_t>(t));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    NION_CHECK(histogram.Count() == numThreads * numValuesPerThread);
+    NION_CHECK(histogram.Max() == numThreads * numValuesPerThread - 1);
+}
+
+void TestStatistics()
+{
+    auto& latencyStatistics = nion::LatencyStatistics::Instance();
+
+    // Nothing is recorded while disabled
+    latencyStatistics.Record(nion::LatencyStage::WriteSequence, std::chrono::milliseconds(1));
+    {
+        nion::ScopedLatency latency(nion::LatencyStage::WriteSequence);
+    }
+    std::ostringstream disabled;
+    latencyStatistics.Print(disabled);
+    NION_CHECK(disabled.str().find(nion::ToString(nion::LatencyStage::WriteSequence)) == std::string::npos);
+
+    latencyStatistics.SetEnabled(true);
+    latencyStatistics.Record(nion::LatencyStage::WriteSequence, std::chrono::milliseconds(50));
+    {
+        nion::ScopedLatency latency(nion::LatencyStage::WriteSequence);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    latencyStatistics.SetEnabled(false);
+
+    std::ostringstream enabled;
+    latencyStatistics.Print(enabled);
+    const auto text = enabled.str();
+    const std::string stage = nion::ToString(nion::LatencyStage::WriteSequence);
+    const auto line = text.find(stage);
+    NION_CHECK(line != std::string::npos);
+
+    // Count and maximum in microseconds
+    std::istringstream values(text.substr(line + stage.size()));
+    uint64_t count{};
+    double p50{};
+    double p99{};
+    double max{};
+    values >> count >> p50 >> p99 >> max;
+    NION_CHECK(count == 2);
+    NION_CHECK(std::abs(max - 50000.0) < 0.1);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "EmptyHistogram", TestEmptyHistogram },
+        { "SmallValuesAreExact", TestSmallValuesAreExact },
+        { "RelativeError", TestRelativeError },
+        { "Percentiles", TestPercentiles },
+        { "ConcurrentRecording", TestConcurrentRecording },
+        { "Statistics", TestStatistics },
+    });
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "lock_free_queue.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+void TestFifoOrder()
+{
+    nion::LockFreeQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        NION_CHECK(queue.TryPush(i));
+    }
+
+    int value{};
+    for (int expected = 0; expected < 4; ++expected)
+    {
+        NION_CHECK(queue.TryPop(value));
+        NION_CHECK(value == expected);
+    }
+}
+
+void TestCapacity()
+{
+    NION_CHECK_THROWS(nion::LockFreeQueue<int>(0), std::invalid_argument);
+    NION_CHECK(nion::LockFreeQueue<int>(1).Capacity() == 2);
+    NION_CHECK(nion::LockFreeQueue<int>(4).Capacity() == 4);
+    NION_CHECK(nion::LockFreeQueue<int>(5).Capacity() == 8);
+}
+
+void TestFullQueue()
+{
+    nion::LockFreeQueue<int> queue(3);
+    for (size_t i = 0; i < queue.Capacity(); ++i)
+    {
+        NION_CHECK(queue.TryPush(static_cast<int>(i)));
+    }
+    NION_CHECK(!queue.TryPush(100));
+
+    // A popped element makes room for exactly one more
+    int value{};
+    NION_CHECK(queue.TryPop(value) && value == 0);
+    NION_CHECK(queue.TryPush(100));
+    NION_CHECK(!queue.TryPush(101));
+}
+
+// The smallest queue still rejects elements when full
+void TestSingleElementQueue()
+{
+    nion::LockFreeQueue<int> queue(1);
+    NION_CHECK(queue.TryPush(1));
+    NION_CHECK(queue.TryPush(2));
+    NION_CHECK(!queue.TryPush(3));
+
+    int value{};
+    NION_CHECK(queue.TryPop(value) && value == 1);
+    NION_CHECK(queue.TryPop(value) && value == 2);
+    NION_CHECK(!queue.TryPop(value));
+}
+
+void TestEmptyQueue()
+{
+    nion::LockFreeQueue<int> queue(2);
+    int value = 5;
+    NION_CHECK(!queue.TryPop(value));
+    NION_CHECK(value == 5);
+
+    NION_CHECK(queue.TryPush(1));
+    NION_CHECK(queue.TryPop(value) && value == 1);
+    NION_CHECK(!queue.TryPop(value));
+    NION_CHECK(value == 1);
+}
+
+// The positions wrap around the cells many times
+void TestManyRounds()
+{
+    nion::LockFreeQueue<int> queue(4);
+    int value{};
+    for (int i = 0; i < 10000; ++i)
+    {
+        NION_CHECK(queue.TryPush(i));
+        NION_CHECK(queue.TryPush(-i));
+        NION_CHECK(queue.TryPop(value) && value == i);
+        NION_CHECK(queue.TryPop(value) && value == -i);
+    }
+    NION_CHECK(!queue.TryPop(value));
+}
+
+void TestMoveOnlyElements()
+{
+    nion::LockFreeQueue<std::unique_ptr<int>> queue(2);
+    NION_CHECK(queue.TryPush(std::make_unique<int>(7)));
+
+    std::unique_ptr<int> value;
+    NION_CHECK(queue.TryPop(value));
+    NION_CHECK(value && *value == 7);
+}
+
+// Every element is popped exactly once, and the elements of each producer are popped in their order
+void TestMultipleProducersAndConsumers()
+{
+    constexpr int numProducers = 4;
+    constexpr int numConsumers = 4;
+    constexpr int numValuesPerProducer = 100000;
+
+    nion::LockFreeQueue<int> queue(16);
+    std::vector<std::atomic<int>> counts(numProducers * numValuesPerProducer);
+    for (auto& count : counts)
+    {
+        count = 0;
+    }
+
+    std::atomic<int> numPopped{ 0 };
+    std::atomic<bool> isOrdered{ true };
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < numConsumers; ++c)
+    {
+        consumers.emplace_back([&] {
+            std::vector<int> lastValues(numProducers, -1);
+            int value{};
+            while (numPopped < numProducers * numValuesPerProducer)
+            {
+                if (!queue.TryPop(value))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                ++numPopped;
+                ++counts[static_cast<size_t>(value)];
+
+                auto& lastValue = lastValues[static_cast<size_t>(value / numValuesPerProducer)];
+                if (value <= lastValue)
+                {
+                    isOrdered = false;
+                }
+                lastValue = value;
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; ++p)
+    {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < numValuesPerProducer; ++i)
+            {
+                while (!queue.TryPush(p * numValuesPerProducer + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    for (auto& consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    NION_CHECK(isOrdered);
+    for (const auto& count : counts)
+    {
+        NION_CHECK(count == 1);
+    }
+
+    int value{};
+    NION_CHECK(!queue.TryPop(value));
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "FifoOrder", TestFifoOrder },
+        { "Capacity", TestCapacity },
+        { "FullQueue", TestFullQueue },
+        { "SingleElementQueue", TestSingleElementQueue },
+        { "EmptyQueue", TestEmptyQueue },
+        { "ManyRounds", TestManyRounds },
+        { "MoveOnlyElements", TestMoveOnlyElements },
+        { "MultipleProducersAndConsumers", TestMultipleProducersAndConsumers },
+    });
+}
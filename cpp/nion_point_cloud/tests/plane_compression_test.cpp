@@ -0,0 +1,180 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "plane_compression.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+// Odd sizes, so neither the rows nor the chunks divide evenly, and rows padded to a larger stride like buffer parts
+constexpr size_t width = 37;
+constexpr size_t height = 45;
+constexpr size_t stride = 40;
+
+// Smooth surfaces, invalid (zero) pixels, noise and jumps over the full value range
+std::vector<uint16_t> CreatePlane(uint16_t seed)
+{
+    std::vector<uint16_t> plane(stride * height, 0xFFFF);
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            const auto noise = static_cast<uint16_t>((x * 7919 + y * 104729 + seed) % 97);
+            auto value = static_cast<uint16_t>(seed + 30 * y + 3 * x + noise);
+            if (x % 7 == 0)
+            {
+                value = 0;
+            }
+            else if ((x + y) % 11 == 0)
+            {
+                value = 0xFFFF;
+            }
+            plane[y * stride + x] = value;
+        }
+    }
+    return plane;
+}
+
+nion::PlaneView<const uint16_t> View(const std::vector<uint16_t>& plane)
+{
+    return { plane.data(), width, height, stride };
+}
+
+bool IsEqual(nion::PlaneView<const uint16_t> a, nion::PlaneView<const uint16_t> b)
+{
+    for (size_t y = 0; y < a.height; ++y)
+    {
+        for (size_t x = 0; x < a.width; ++x)
+        {
+            if (a.Row(y)[x] != b.Row(y)[x])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+nion::PlaneCompressionSettings Settings(size_t numThreads, size_t chunkRows)
+{
+    nion::PlaneCompressionSettings settings;
+    settings.numThreads = numThreads;
+    settings.chunkRows = chunkRows;
+    return settings;
+}
+
+void TestRoundTrip()
+{
+    const auto plane = CreatePlane(1200);
+    for (const auto& settings : { Settings(1, 1), Settings(1, 64), Settings(3, 7), Settings(4, 32) })
+    {
+        nion::PlaneCompressor compressor(settings);
+        std::vector<uint8_t> data;
+        compressor.Compress(View(plane), data);
+
+        std::vector<uint16_t> decompressed(width * height);
+        compressor.Decompress(data.data(), data.size(), { decompressed.data(), width, height, width });
+        NION_CHECK(IsEqual(View(plane), { decompressed.data(), width, height, width }));
+    }
+}
+
+// The chunk rows are taken from the compressed plane, independent of the settings of the decompressing side
+void TestOtherSettings()
+{
+    const auto plane = CreatePlane(7);
+    std::vector<uint8_t> data;
+    nion::PlaneCompressor(Settings(2, 5)).Compress(View(plane), data);
+
+    std::vector<uint16_t> decompressed(stride * height);
+    const nion::PlaneView<uint16_t> output{ decompressed.data(), width, height, stride };
+    nion::PlaneCompressor(Settings(1, 32)).Decompress(data.data(), data.size(), output);
+    NION_CHECK(IsEqual(View(plane), nion::AsConst(output)));
+}
+
+// A group of equal pixels takes a single byte
+void TestEqualPixels()
+{
+    const std::vector<uint16_t> plane(stride * height, 0);
+    nion::PlaneCompressor compressor(Settings(2, 16));
+    std::vector<uint8_t> data;
+    compressor.Compress(View(plane), data);
+    NION_CHECK(data.size() < width * height * sizeof(uint16_t) / 16);
+}
+
+void TestConcurrentCalls()
+{
+    nion::PlaneCompressor compressor(Settings(3, 4));
+    const auto first = CreatePlane(100);
+    const auto second = CreatePlane(30000);
+
+    auto compressAndCheck = [&compressor](const std::vector<uint16_t>& plane) {
+        std::vector<uint8_t> data;
+        std::vector<uint16_t> decompressed(width * height);
+        for (int i = 0; i < 50; ++i)
+        {
+            compressor.Compress(View(plane), data);
+            compressor.Decompress(data.data(), data.size(), { decompressed.data(), width, height, width });
+            NION_CHECK(IsEqual(View(plane), { decompressed.data(), width, height, width }));
+        }
+    };
+
+    std::thread other([&] {
+        compressAndCheck(second);
+    });
+    compressAndCheck(first);
+    other.join();
+}
+
+void TestInvalidData()
+{
+    nion::PlaneCompressor compressor(Settings(2, 8));
+    const auto plane = CreatePlane(500);
+    std::vector<uint8_t> data;
+    compressor.Compress(View(plane), data);
+
+    std::vector<uint16_t> decompressed(width * height);
+    const nion::PlaneView<uint16_t> output{ decompressed.data(), width, height, width };
+    NION_CHECK_THROWS(compressor.Decompress(data.data(), data.size() - 1, output), std::runtime_error);
+    NION_CHECK_THROWS(compressor.Decompress(data.data(), 10, output), std::runtime_error);
+    NION_CHECK_THROWS(compressor.Decompress(data.data(), data.size(), { decompressed.data(), height, width, height }),
+        std::invalid_argument);
+
+    auto wrongMagic = data;
+    wrongMagic[0] = 'X';
+    NION_CHECK_THROWS(compressor.Decompress(wrongMagic.data(), wrongMagic.size(), output), std::runtime_error);
+
+    NION_CHECK_THROWS(nion::PlaneCompressor{ Settings(1, 0) }, std::invalid_argument);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "RoundTrip", TestRoundTrip },
+        { "OtherSettings", TestOtherSettings },
+        { "EqualPixels", TestEqualPixels },
+        { "ConcurrentCalls", TestConcurrentCalls },
+        { "InvalidData", TestInvalidData },
+    });
+}
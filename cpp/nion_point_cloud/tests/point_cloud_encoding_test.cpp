@@ -0,0 +1,249 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Project headers
+#include "point_cloud_encoding.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+const std::string headerEnd = "end_header\n";
+
+nion::PointCloud CreatePointCloud()
+{
+    nion::PointCloud pointCloud;
+    pointCloud.points = {
+        { 1.0F, -2.0F, 300.0F, 40.0F },
+        { 12.4F, -12.6F, 1000.0F, 4095.0F },
+        { 80000.0F, -80000.0F, std::numeric_limits<float>::quiet_NaN(), 70000.0F },
+    };
+    pointCloud.width = pointCloud.points.size();
+    pointCloud.height = 1;
+    return pointCloud;
+}
+
+nion::PointCloudFormatSettings Settings(nion::PointCloudFormat format)
+{
+    nion::PointCloudFormatSettings settings;
+    settings.format = format;
+    return settings;
+}
+
+std::string Header(const std::vector<uint8_t>& data)
+{
+    const std::string text(data.begin(), data.end());
+    const auto end = text.find(headerEnd);
+    NION_CHECK(end != std::string::npos);
+    return text.substr(0, end + headerEnd.size());
+}
+
+bool Contains(const std::string& text, const std::string& part)
+{
+    return text.find(part) != std::string::npos;
+}
+
+template <typename T>
+T Read(const std::vector<uint8_t>& data, size_t offset)
+{
+    T value{};
+    NION_CHECK(offset + sizeof(T) <= data.size());
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+void TestBinaryPly()
+{
+    const auto pointCloud = CreatePointCloud();
+    std::vector<uint8_t> data;
+    nion::EncodePointCloud(pointCloud, Settings(nion::PointCloudFormat::BinaryPly), data);
+
+    const auto header = Header(data);
+    NION_CHECK(header.compare(0, 4, "ply\n") == 0);
+    NION_CHECK(Contains(header, "format binary_little_endian 1.0\n"));
+    NION_CHECK(Contains(header, "element vertex 3\n"));
+    NION_CHECK(Contains(header, "property float intensity\n"));
+    NION_CHECK(!Contains(header, "comment width"));
+    NION_CHECK(data.size() == header.size() + 3 * sizeof(nion::PointXYZI));
+
+    // The points are stored as they are
+    NION_CHECK(std::memcmp(data.data() + header.size(), pointCloud.points.data(), 2 * sizeof(nion::PointXYZI)) == 0);
+    NION_CHECK(std::isnan(Read<float>(data, header.size() + 2 * sizeof(nion::PointXYZI) + 2 * sizeof(float))));
+}
+
+void TestQuantizedPly()
+{
+    auto settings = Settings(nion::PointCloudFormat::QuantizedPly);
+    settings.coordinateStepMm = 2.0F;
+
+    std::vector<uint8_t> data;
+    nion::EncodePointCloud(CreatePointCloud(), settings, data);
+
+    const auto header = Header(data);
+    NION_CHECK(Contains(header, "comment coordinate_step_mm 2\n"));
+    NION_CHECK(!Contains(header, "comment intensity_step"));
+    NION_CHECK(Contains(header, "property short x\n"));
+    NION_CHECK(Contains(header, "property ushort intensity\n"));
+
+    constexpr size_t pointSize = 4 * sizeof(int16_t);
+    NION_CHECK(data.size() == header.size() + 3 * pointSize);
+
+    // Rounded to multiples of the step
+    const auto first = header.size();
+    NION_CHECK(Read<int16_t>(data, first) == 1);
+    NION_CHECK(Read<int16_t>(data, first + 2) == -1);
+    NION_CHECK(Read<int16_t>(data, first + 4) == 150);
+    NION_CHECK(Read<uint16_t>(data, first + 6) == 40);
+
+    const auto second = first + pointSize;
+    NION_CHECK(Read<int16_t>(data, second) == 6);
+    NION_CHECK(Read<int16_t>(data, second + 2) == -6);
+    NION_CHECK(Read<int16_t>(data, second + 4) == 500);
+    NION_CHECK(Read<uint16_t>(data, second + 6) == 4095);
+
+    // Values out of range are clamped and invalid values are stored as 0
+    const auto third = second + pointSize;
+    NION_CHECK(Read<int16_t>(data, third) == INT16_MAX);
+    NION_CHECK(Read<int16_t>(data, third + 2) == INT16_MIN);
+    NION_CHECK(Read<int16_t>(data, third + 4) == 0);
+    NION_CHECK(Read<uint16_t>(data, third + 6) == UINT16_MAX);
+}
+
+void TestQuantizedPlyWith8BitIntensity()
+{
+    auto settings = Settings(nion::PointCloudFormat::QuantizedPly);
+    settings.intensityAs8Bit = true;
+    settings.intensityStep = 16.0F;
+
+    std::vector<uint8_t> data;
+    nion::EncodePointCloud(CreatePointCloud(), settings, data);
+
+    const auto header = Header(data);
+    NION_CHECK(Contains(header, "comment intensity_step 16\n"));
+    NION_CHECK(Contains(header, "property uchar intensity\n"));
+
+    constexpr size_t pointSize = 3 * sizeof(int16_t) + sizeof(uint8_t);
+    NION_CHECK(data.size() == header.size() + 3 * pointSize);
+    NION_CHECK(Read<uint8_t>(data, header.size() + 6) == 3);
+    NION_CHECK(Read<uint8_t>(data, header.size() + pointSize + 6) == 255);
+}
+
+void TestQuantizedPlyRejectsInvalidSteps()
+{
+    auto settings = Settings(nion::PointCloudFormat::QuantizedPly);
+    settings.coordinateStepMm = 0.0F;
+
+    std::vector<uint8_t> data;
+    NION_CHECK_THROWS(nion::EncodePointCloud(CreatePointCloud(), settings, data), std::invalid_argument);
+
+    settings.coordinateStepMm = 1.0F;
+    settings.intensityAs8Bit = true;
+    settings.intensityStep = -1.0F;
+    NION_CHECK_THROWS(nion::EncodePointCloud(CreatePointCloud(), settings, data), std::invalid_argument);
+}
+
+void TestXyzi()
+{
+    auto pointCloud = CreatePointCloud();
+    pointCloud.points.push_back({});
+    pointCloud.width = 2;
+    pointCloud.height = 2;
+
+    std::vector<uint8_t> data;
+    nion::EncodePointCloud(pointCloud, Settings(nion::PointCloudFormat::Xyzi), data);
+
+    NION_CHECK(data.size() == sizeof(nion::XyziHeader) + 4 * sizeof(nion::PointXYZI));
+    const auto header = Read<nion::XyziHeader>(data, 0);
+    NION_CHECK(std::memcmp(header.magic, "XYZI", 4) == 0);
+    NION_CHECK(header.version == 2);
+    NION_CHECK(header.width == 2);
+    NION_CHECK(header.height == 2);
+    NION_CHECK(Read<float>(data, sizeof(header) + sizeof(nion::PointXYZI) + sizeof(float)) == -12.6F);
+
+    // The size must match the number of points
+    pointCloud.width = 3;
+    NION_CHECK_THROWS(
+        nion::EncodePointCloud(pointCloud, Settings(nion::PointCloudFormat::Xyzi), data), std::invalid_argument);
+}
+
+void TestOrganizedSizeComments()
+{
+    auto pointCloud = CreatePointCloud();
+    pointCloud.points.resize(6);
+    pointCloud.width = 3;
+    pointCloud.height = 2;
+
+    for (const auto format : { nion::PointCloudFormat::BinaryPly, nion::PointCloudFormat::QuantizedPly })
+    {
+        std::vector<uint8_t> data;
+        nion::EncodePointCloud(pointCloud, Settings(format), data);
+
+        const auto header = Header(data);
+        NION_CHECK(Contains(header, "comment width 3\ncomment height 2\n"));
+        NION_CHECK(Contains(header, "element vertex 6\n"));
+    }
+}
+
+void TestReusesData()
+{
+    std::vector<uint8_t> data(100000, 0xFF);
+    const auto* address = data.data();
+    nion::EncodePointCloud(CreatePointCloud(), Settings(nion::PointCloudFormat::Xyzi), data);
+
+    NION_CHECK(data.data() == address);
+    NION_CHECK(data.size() == sizeof(nion::XyziHeader) + 3 * sizeof(nion::PointXYZI));
+}
+
+void TestPointCloudWriterIsRejected()
+{
+    std::vector<uint8_t> data;
+    NION_CHECK_THROWS(nion::EncodePointCloud(CreatePointCloud(), Settings(nion::PointCloudFormat::PointCloudWriter),
+                          data),
+        std::invalid_argument);
+}
+
+void TestFileExtensions()
+{
+    NION_CHECK(nion::PointCloudFileExtension(nion::PointCloudFormat::PointCloudWriter) == ".ply");
+    NION_CHECK(nion::PointCloudFileExtension(nion::PointCloudFormat::BinaryPly) == ".ply");
+    NION_CHECK(nion::PointCloudFileExtension(nion::PointCloudFormat::QuantizedPly) == ".ply");
+    NION_CHECK(nion::PointCloudFileExtension(nion::PointCloudFormat::Xyzi) == ".xyzi");
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "BinaryPly", TestBinaryPly },
+        { "QuantizedPly", TestQuantizedPly },
+        { "QuantizedPlyWith8BitIntensity", TestQuantizedPlyWith8BitIntensity },
+        { "QuantizedPlyRejectsInvalidSteps", TestQuantizedPlyRejectsInvalidSteps },
+        { "Xyzi", TestXyzi },
+        { "OrganizedSizeComments", TestOrganizedSizeComments },
+        { "ReusesData", TestReusesData },
+        { "PointCloudWriterIsRejected", TestPointCloudWriterIsRejected },
+        { "FileExtensions", TestFileExtensions },
+    });
+}
@@ -0,0 +1,258 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#    include <winsock2.h>
+#    include <ws2tcpip.h>
+#else
+#    include <arpa/inet.h>
+#    include <netinet/in.h>
+#    include <sys/socket.h>
+#    include <unistd.h>
+#endif
+
+// Project headers
+#include "point_cloud_stream.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+// Ports tried for the stream, in case one of them is in use
+constexpr uint16_t firstPort = 56300;
+constexpr uint16_t numPorts = 20;
+
+std::unique_ptr<nion::PointCloudStream> OpenStream(nion::PointCloudStreamSettings& settings)
+{
+    for (uint16_t i = 0; i < numPorts; ++i)
+    {
+        settings.port = static_cast<uint16_t>(firstPort + i);
+        try
+        {
+            return std::make_unique<nion::PointCloudStream>(settings);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+
+    throw std::runtime_error("No free port for the point cloud stream.");
+}
+
+// Client of the stream on the loopback interface. The stream initializes Windows Sockets as long as it exists.
+class Client
+{
+public:
+    Client(const nion::PointCloudStream& stream, uint16_t port)
+        : m_socket(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        NION_CHECK(connect(m_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+
+        // Frames are only sent to accepted clients
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (stream.NumClients() == 0 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        NION_CHECK(stream.NumClients() == 1);
+    }
+
+    ~Client()
+    {
+#ifdef _WIN32
+        closesocket(m_socket);
+#else
+        close(m_socket);
+#endif
+    }
+
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+    Client(Client&&) = delete;
+    Client& operator=(Client&&) = delete;
+
+    void Receive(void* data, size_t size)
+    {
+        auto* bytes = static_cast<char*>(data);
+        while (size > 0)
+        {
+            const auto numReceived = recv(m_socket, bytes, static_cast<int>(size), 0);
+            NION_CHECK(numReceived > 0);
+            bytes += numReceived;
+            size -= static_cast<size_t>(numReceived);
+        }
+    }
+
+private:
+    nion::NativeSocket m_socket;
+};
+
+nion::PointCloud CreatePointCloud(size_t width, size_t height)
+{
+    nion::PointCloud pointCloud;
+    pointCloud.width = width;
+    pointCloud.height = height;
+    for (size_t i = 0; i < width * height; ++i)
+    {
+        const auto value = static_cast<float>(i);
+        pointCloud.points.push_back({ value, value + 0.25F, value + 0.5F, value + 0.75F });
+    }
+    return pointCloud;
+}
+
+void CheckHeader(const nion::PointCloudStreamHeader& header, uint64_t frameId, const nion::PointCloud& pointCloud)
+{
+    NION_CHECK(std::memcmp(header.magic, "NPCS", 4) == 0);
+    NION_CHECK(header.version == 1 && header.headerSize == 48);
+    NION_CHECK(header.frameId == frameId && header.timestampNs == frameId * 1000);
+    NION_CHECK(header.width == pointCloud.width && header.height == pointCloud.height);
+    NION_CHECK(header.numPoints == pointCloud.points.size());
+    NION_CHECK(header.pointLayout == static_cast<uint16_t>(nion::StreamPointLayout::XyziFloat32));
+    NION_CHECK(header.pointDataSize == pointCloud.points.size() * sizeof(nion::PointXYZI));
+}
+
+void CheckPoints(Client& client, const nion::PointCloud& pointCloud)
+{
+    std::vector<nion::PointXYZI> points(pointCloud.points.size());
+    client.Receive(points.data(), points.size() * sizeof(nion::PointXYZI));
+    NION_CHECK(std::memcmp(points.data(), pointCloud.points.data(), points.size() * sizeof(nion::PointXYZI)) == 0);
+}
+
+// Organized point clouds are followed by the validity mask, with bit i % 8 of byte i / 8 for point i
+void TestOrganized()
+{
+    nion::PointCloudStreamSettings settings;
+    const auto stream = OpenStream(settings);
+    Client client(*stream, settings.port);
+
+    const auto pointCloud = CreatePointCloud(5, 3);
+    std::vector<uint8_t> depthValid(pointCloud.points.size());
+    for (size_t i = 0; i < depthValid.size(); ++i)
+    {
+        depthValid[i] = i % 3 == 0 || i == 14 ? 1 : 0;
+    }
+    stream->Send(7, 7000, pointCloud, { depthValid.data(), 5, 3, 5 });
+
+    nion::PointCloudStreamHeader header{};
+    client.Receive(&header, sizeof(header));
+    CheckHeader(header, 7, pointCloud);
+    NION_CHECK(header.flags == nion::StreamFrameHasValidityMask);
+    NION_CHECK(header.validityMaskSize == 2);
+    CheckPoints(client, pointCloud);
+
+    uint8_t mask[2]{};
+    client.Receive(mask, sizeof(mask));
+    NION_CHECK(mask[0] == 0x49 && mask[1] == 0x52);
+    NION_CHECK(stream->NumSentFrames() == 1);
+}
+
+// Unorganized point clouds and streams without the mask are sent without it, frame after frame
+void TestWithoutValidityMask()
+{
+    nion::PointCloudStreamSettings settings;
+    settings.validityMask = false;
+    const auto stream = OpenStream(settings);
+    Client client(*stream, settings.port);
+
+    const auto organized = CreatePointCloud(4, 2);
+    const std::vector<uint8_t> depthValid(organized.points.size(), 1);
+    const auto unorganized = CreatePointCloud(6, 1);
+    stream->Send(1, 1000, organized, { depthValid.data(), 4, 2, 4 });
+    stream->Send(2, 2000, unorganized, {});
+
+    nion::PointCloudStreamHeader header{};
+    client.Receive(&header, sizeof(header));
+    CheckHeader(header, 1, organized);
+    NION_CHECK(header.flags == 0 && header.validityMaskSize == 0);
+    CheckPoints(client, organized);
+
+    client.Receive(&header, sizeof(header));
+    CheckHeader(header, 2, unorganized);
+    NION_CHECK(header.flags == 0 && header.validityMaskSize == 0);
+    CheckPoints(client, unorganized);
+    NION_CHECK(stream->NumSentFrames() == 2);
+}
+
+// Frames without clients are not counted, and a client that disconnected is removed by the next frame
+void TestDisconnectedClient()
+{
+    nion::PointCloudStreamSettings settings;
+    const auto stream = OpenStream(settings);
+    const auto pointCloud = CreatePointCloud(8, 1);
+    stream->Send(1, 1000, pointCloud, {});
+    NION_CHECK(stream->NumSentFrames() == 0);
+
+    {
+        Client client(*stream, settings.port);
+    }
+
+    // The first frame may still be accepted by the socket before the connection is reset
+    for (uint64_t frameId = 2; frameId < 100 && stream->NumClients() > 0; ++frameId)
+    {
+        stream->Send(frameId, frameId * 1000, pointCloud, {});
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    NION_CHECK(stream->NumClients() == 0 && stream->NumDisconnectedClients() == 1);
+}
+
+// A client that does not read blocks the sending thread until the send timeout, but not the other calls
+void TestSlowClient()
+{
+    nion::PointCloudStreamSettings settings;
+    settings.sendTimeoutMs = 1000;
+    const auto stream = OpenStream(settings);
+    Client client(*stream, settings.port);
+
+    // Larger than the buffers of the sockets
+    const auto pointCloud = CreatePointCloud(1 << 22, 1);
+    std::thread sender([&] {
+        stream->Send(1, 1000, pointCloud, {});
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto numClients = stream->NumClients();
+    const auto duration = std::chrono::steady_clock::now() - start;
+    sender.join();
+
+    NION_CHECK(numClients == 1 && duration < std::chrono::milliseconds(500));
+    NION_CHECK(stream->NumClients() == 0 && stream->NumDisconnectedClients() == 1);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "Organized", TestOrganized },
+        { "WithoutValidityMask", TestWithoutValidityMask },
+        { "DisconnectedClient", TestDisconnectedClient },
+        { "SlowClient", TestSlowClient },
+    });
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Project headers
+#include "point_cloud.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+constexpr size_t width = 6;
+constexpr size_t height = 4;
+// The rows are padded, like the images of the workspace
+constexpr size_t stride = 8;
+constexpr float scaleFactor = 0.25F;
+
+nion::LensModel PinholeModel()
+{
+    nion::LensModel model;
+    model.fx = 4.0;
+    model.fy = 2.0;
+    model.cx = 2.5;
+    model.cy = 1.5;
+    return model;
+}
+
+// Small synthetic frame with every third pixel invalid, the raw and metric depth maps hold the same values
+struct Frame
+{
+    Frame()
+        : rawDepth(stride * height)
+        , metricDepth(stride * height)
+        , depthValid(stride * height)
+        , intensity(stride * height)
+    {
+        for (size_t y = 0; y < height; ++y)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                const auto i = y * stride + x;
+                rawDepth[i] = static_cast<uint16_t>(4000 + 40 * i);
+                metricDepth[i] = static_cast<float>(rawDepth[i]) * scaleFactor;
+                depthValid[i] = (y * width + x) % 3 == 1 ? 0 : 1;
+                intensity[i] = static_cast<uint16_t>(100 + i);
+            }
+        }
+    }
+
+    nion::DepthMapView Raw() const
+    {
+        return { nion::PlaneView<const uint16_t>{ rawDepth.data(), width, height, stride }, scaleFactor };
+    }
+
+    nion::DepthMapView Metric() const
+    {
+        return { nion::PlaneView<const float>{ metricDepth.data(), width, height, stride } };
+    }
+
+    nion::PlaneView<const uint8_t> DepthValid() const
+    {
+        return { depthValid.data(), width, height, stride };
+    }
+
+    nion::PlaneView<const uint16_t> Intensity() const
+    {
+        return { intensity.data(), width, height, stride };
+    }
+
+    bool IsValid(size_t x, size_t y) const
+    {
+        return depthValid[y * stride + x] != 0;
+    }
+
+    // The point of a valid pixel, back-projected with the pinhole model
+    nion::PointXYZI Point(size_t x, size_t y) const
+    {
+        const auto z = metricDepth[y * stride + x];
+        return { (static_cast<float>(x) - 2.5F) * 0.25F * z, (static_cast<float>(y) - 1.5F) * 0.5F * z, z,
+            static_cast<float>(intensity[y * stride + x]) };
+    }
+
+    std::vector<uint16_t> rawDepth;
+    std::vector<float> metricDepth;
+    std::vector<uint8_t> depthValid;
+    std::vector<uint16_t> intensity;
+};
+
+bool operator==(const nion::PointXYZI& a, const nion::PointXYZI& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.intensity == b.intensity;
+}
+
+bool IsInvalidPoint(const nion::PointXYZI& point, float invalidValue)
+{
+    if (std::isnan(invalidValue))
+    {
+        return std::isnan(point.x) && std::isnan(point.y) && std::isnan(point.z) && std::isnan(point.intensity);
+    }
+    return point == nion::PointXYZI{ invalidValue, invalidValue, invalidValue, invalidValue };
+}
+
+// Only the valid pixels become points, in row-major order
+void CheckUnorganized(const Frame& frame, const nion::PointCloud& pointCloud, const nion::PixelRegion& area)
+{
+    std::vector<nion::PointXYZI> expected;
+    for (size_t y = area.y; y < area.y + area.height; ++y)
+    {
+        for (size_t x = area.x; x < area.x + area.width; ++x)
+        {
+            if (frame.IsValid(x, y))
+            {
+                expected.push_back(frame.Point(x, y));
+            }
+        }
+    }
+
+    NION_CHECK(pointCloud.points.size() == expected.size());
+    NION_CHECK(pointCloud.width == expected.size() && pointCloud.height == 1);
+    for (size_t i = 0; i < expected.size() && i < pointCloud.points.size(); ++i)
+    {
+        NION_CHECK(pointCloud.points[i] == expected[i]);
+    }
+}
+
+// Every pixel of the area becomes a point, invalid ones are set to the invalid value
+void CheckOrganized(
+    const Frame& frame, const nion::PointCloud& pointCloud, const nion::PixelRegion& area, float invalidValue)
+{
+    NION_CHECK(pointCloud.width == area.width && pointCloud.height == area.height);
+    NION_CHECK(pointCloud.points.size() == area.width * area.height);
+    for (size_t y = 0; y < area.height; ++y)
+    {
+        for (size_t x = 0; x < area.width; ++x)
+        {
+            const auto& point = pointCloud.points[y * area.width + x];
+            NION_CHECK(frame.IsValid(area.x + x, area.y + y) ? point == frame.Point(area.x + x, area.y + y)
+                                                             : IsInvalidPoint(point, invalidValue));
+        }
+    }
+}
+
+void TestUnorganized()
+{
+    const Frame frame;
+    const nion::PixelRegion image{ 0, 0, width, height };
+
+    nion::PointCloud metric;
+    nion::CreatePointCloud(frame.Metric(), frame.DepthValid(), frame.Intensity(), PinholeModel(), metric);
+    CheckUnorganized(frame, metric, image);
+    NION_CHECK(metric.points.size() == 16);
+
+    // The raw values are converted with the same rounding as the metric depth map
+    nion::PointCloud raw;
+    nion::CreatePointCloud(frame.Raw(), frame.DepthValid(), frame.Intensity(), PinholeModel(), raw);
+    CheckUnorganized(frame, raw, image);
+}
+
+// Only the pixels of the region are read, e.g. the bounding box of the valid pixels
+void TestUnorganizedRegion()
+{
+    const Frame frame;
+    const nion::PixelRegion region{ 1, 1, 4, 2 };
+
+    nion::PointCloud pointCloud;
+    nion::CreatePointCloud(frame.Raw(), frame.DepthValid(), frame.Intensity(), PinholeModel(), pointCloud, region);
+    CheckUnorganized(frame, pointCloud, region);
+    NION_CHECK(pointCloud.points.size() == 4);
+
+    // The previous points are discarded
+    nion::CreatePointCloud(frame.Metric(), frame.DepthValid(), frame.Intensity(), PinholeModel(), pointCloud);
+    CheckUnorganized(frame, pointCloud, { 0, 0, width, height });
+}
+
+void TestOrganized()
+{
+    const Frame frame;
+    const nion::PixelRegion image{ 0, 0, width, height };
+
+    for (const auto invalidValue : { std::nanf(""), -1.0F, 0.0F })
+    {
+        nion::PointCloud metric;
+        nion::CreateOrganizedPointCloud(
+            frame.Metric(), frame.DepthValid(), frame.Intensity(), PinholeModel(), invalidValue, metric);
+        CheckOrganized(frame, metric, image, invalidValue);
+
+        nion::PointCloud raw;
+        nion::CreateOrganizedPointCloud(
+            frame.Raw(), frame.DepthValid(), frame.Intensity(), PinholeModel(), invalidValue, raw);
+        CheckOrganized(frame, raw, image, invalidValue);
+    }
+}
+
+// With a region, e.g. the work area of the processor, the point cloud has its size
+void TestOrganizedRegion()
+{
+    const Frame frame;
+    const nion::PixelRegion region{ 2, 1, 3, 3 };
+
+    nion::PointCloud pointCloud;
+    nion::CreateOrganizedPointCloud(
+        frame.Raw(), frame.DepthValid(), frame.Intensity(), PinholeModel(), NAN, pointCloud, region);
+    CheckOrganized(frame, pointCloud, region, NAN);
+}
+
+// The points keep their address from frame to frame, so consumers can hold on to the buffer
+void TestOrganizedReusesPoints()
+{
+    Frame frame;
+    const nion::PixelRegion image{ 0, 0, width, height };
+
+    nion::PointCloud pointCloud;
+    nion::CreateOrganizedPointCloud(
+        frame.Metric(), frame.DepthValid(), frame.Intensity(), PinholeModel(), NAN, pointCloud);
+    const auto* points = pointCloud.points.data();
+
+    for (auto& valid : frame.depthValid)
+    {
+        valid = valid == 0 ? 1 : 0;
+    }
+    nion::CreateOrganizedPointCloud(
+        frame.Metric(), frame.DepthValid(), frame.Intensity(), PinholeModel(), NAN, pointCloud);
+    NION_CHECK(pointCloud.points.data() == points);
+    CheckOrganized(frame, pointCloud, image, NAN);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "Unorganized", TestUnorganized },
+        { "UnorganizedRegion", TestUnorganizedRegion },
+        { "Organized", TestOrganized },
+        { "OrganizedRegion", TestOrganizedRegion },
+        { "OrganizedReusesPoints", TestOrganizedReusesPoints },
+    });
+}
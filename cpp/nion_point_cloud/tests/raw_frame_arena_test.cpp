@@ -0,0 +1,198 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "raw_frame_arena.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+constexpr size_t width = 13;
+constexpr size_t height = 5;
+
+// Image with rows padded to the stride, like the buffer parts of a camera
+std::vector<uint16_t> CreateImage(uint16_t seed, size_t stride)
+{
+    std::vector<uint16_t> image(stride * height, 0xFFFF);
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            image[y * stride + x] = static_cast<uint16_t>(seed + y * width + x);
+        }
+    }
+    return image;
+}
+
+nion::PlaneView<const uint16_t> View(const std::vector<uint16_t>& image, size_t stride)
+{
+    return { image.data(), width, height, stride };
+}
+
+bool IsCopy(nion::PlaneView<uint16_t> copy, nion::PlaneView<const uint16_t> image)
+{
+    if (copy.width != image.width || copy.height != image.height)
+    {
+        return false;
+    }
+
+    for (size_t y = 0; y < image.height; ++y)
+    {
+        for (size_t x = 0; x < image.width; ++x)
+        {
+            if (copy.Row(y)[x] != image.Row(y)[x])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void TestCopiesPaddedImages()
+{
+    nion::RawFrameArena arena(2, width, height);
+    const auto depth = CreateImage(100, 16);
+    const auto intensity = CreateImage(2000, width);
+
+    auto* frame = arena.TryCopy(View(depth, 16), View(intensity, width));
+    NION_CHECK(frame != nullptr);
+    NION_CHECK(IsCopy(frame->depth, View(depth, 16)));
+    NION_CHECK(IsCopy(frame->intensity, View(intensity, width)));
+
+    // Every plane starts on its own cache line
+    NION_CHECK(reinterpret_cast<uintptr_t>(frame->depth.data) % 64 == 0);
+    NION_CHECK(reinterpret_cast<uintptr_t>(frame->intensity.data) % 64 == 0);
+    arena.Release(frame);
+}
+
+void TestAllFramesInUse()
+{
+    nion::RawFrameArena arena(2, width, height);
+    const auto image = CreateImage(1, width);
+
+    auto* first = arena.TryCopy(View(image, width), View(image, width));
+    auto* second = arena.TryCopy(View(image, width), View(image, width));
+    NION_CHECK(first != nullptr && second != nullptr && first != second);
+
+    // The planes of the frames do not overlap
+    const std::vector<nion::PlaneView<uint16_t>> planes{ first->depth, first->intensity, second->depth,
+        second->intensity };
+    for (size_t i = 0; i < planes.size(); ++i)
+    {
+        for (size_t j = i + 1; j < planes.size(); ++j)
+        {
+            NION_CHECK(planes[i].data + planes[i].NumPixels() <= planes[j].data
+                || planes[j].data + planes[j].NumPixels() <= planes[i].data);
+        }
+    }
+
+    NION_CHECK(arena.TryCopy(View(image, width), View(image, width)) == nullptr);
+
+    arena.Release(first);
+    NION_CHECK(arena.TryCopy(View(image, width), View(image, width)) == first);
+}
+
+void TestWrongSize()
+{
+    nion::RawFrameArena arena(1, width, height);
+    const std::vector<uint16_t> image((width + 1) * height);
+    const nion::PlaneView<const uint16_t> wider{ image.data(), width + 1, height, width + 1 };
+
+    NION_CHECK(arena.TryCopy(wider, {}) == nullptr);
+
+    // The frame was not taken
+    const auto fitting = CreateImage(1, width);
+    NION_CHECK(arena.TryCopy(View(fitting, width), {}) != nullptr);
+}
+
+// Images that the output profile does not use are empty and not copied
+void TestEmptyImages()
+{
+    nion::RawFrameArena arena(1, width, height);
+    const auto first = CreateImage(42, width);
+    arena.Release(arena.TryCopy(View(first, width), View(first, width)));
+
+    const auto second = CreateImage(1000, width);
+    auto* frame = arena.TryCopy(View(second, width), {});
+    NION_CHECK(frame != nullptr);
+    NION_CHECK(IsCopy(frame->depth, View(second, width)));
+    NION_CHECK(IsCopy(frame->intensity, View(first, width)));
+}
+
+// Frames are copied by the acquisition threads and released by the worker threads. A frame is never handed out twice.
+void TestConcurrentUse()
+{
+    constexpr int numThreads = 4;
+    constexpr int numCopiesPerThread = 20000;
+
+    nion::RawFrameArena arena(3, width, height);
+    const auto image = CreateImage(7, width);
+
+    std::atomic<bool> isExclusive{ true };
+    std::atomic<int> numCopies{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            const auto stamp = static_cast<uint16_t>(t + 1);
+            for (int i = 0; i < numCopiesPerThread; ++i)
+            {
+                auto* frame = arena.TryCopy(View(image, width), {});
+                if (!frame)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                ++numCopies;
+                frame->intensity.Row(0)[0] = stamp;
+                std::this_thread::yield();
+                if (frame->intensity.Row(0)[0] != stamp || !IsCopy(frame->depth, View(image, width)))
+                {
+                    isExclusive = false;
+                }
+                arena.Release(frame);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    NION_CHECK(isExclusive);
+    NION_CHECK(numCopies > 0);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "CopiesPaddedImages", TestCopiesPaddedImages },
+        { "AllFramesInUse", TestAllFramesInUse },
+        { "WrongSize", TestWrongSize },
+        { "EmptyImages", TestEmptyImages },
+        { "ConcurrentUse", TestConcurrentUse },
+    });
+}
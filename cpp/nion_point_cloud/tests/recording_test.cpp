@@ -0,0 +1,216 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+// Project headers
+#include "recording.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+nion::RecordingInfo CreateInfo(bool isCompressed)
+{
+    nion::RecordingInfo info;
+    info.calibrationData = { 1, 2, 3, 4, 5 };
+    info.scaleFactor = 0.25F;
+    info.validDepthMin = 100.0F;
+    info.validDepthMax = 5000.0F;
+    info.geometry = { 2, 2, 8, 4, 21, 6 };
+    info.isCompressed = isCompressed;
+    return info;
+}
+
+// Image with the size of the info and rows padded to a stride larger than the width, like buffer parts
+std::vector<uint16_t> CreateImage(const nion::RecordingInfo& info, uint16_t seed, size_t stride)
+{
+    std::vector<uint16_t> image(stride * info.geometry.height, 0xFFFF);
+    for (size_t y = 0; y < info.geometry.height; ++y)
+    {
+        for (size_t x = 0; x < info.geometry.width; ++x)
+        {
+            // Smooth areas, invalid (zero) pixels and noise
+            const auto noise = static_cast<uint16_t>((x * 7919 + y * 104729 + seed) % 61);
+            image[y * stride + x] = (x % 5 == 0) ? 0 : static_cast<uint16_t>(seed + 40 * y + x + noise);
+        }
+    }
+    return image;
+}
+
+nion::PlaneView<const uint16_t> View(const std::vector<uint16_t>& image, const nion::RecordingInfo& info, size_t stride)
+{
+    return { image.data(), info.geometry.width, info.geometry.height, stride };
+}
+
+bool IsEqual(nion::PlaneView<const uint16_t> a, nion::PlaneView<const uint16_t> b)
+{
+    if (a.width != b.width || a.height != b.height)
+    {
+        return false;
+    }
+
+    for (size_t y = 0; y < a.height; ++y)
+    {
+        for (size_t x = 0; x < a.width; ++x)
+        {
+            if (a.Row(y)[x] != b.Row(y)[x])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void CheckRoundTrip(bool isCompressed)
+{
+    constexpr size_t stride = 24;
+    constexpr uint16_t numFrames = 3;
+
+    const nion::test::TemporaryFile file(isCompressed ? "compressed.nionrec" : "uncompressed.nionrec");
+    const auto info = CreateInfo(isCompressed);
+
+    std::vector<std::vector<uint16_t>> images;
+    {
+        nion::RecordingWriter writer(file.Path(), info);
+        for (uint16_t i = 0; i < numFrames; ++i)
+        {
+            images.push_back(CreateImage(info, static_cast<uint16_t>(1000 * i + 500), stride));
+            images.push_back(CreateImage(info, static_cast<uint16_t>(1000 * i + 7), stride));
+            writer.WriteFrame(i + 10, 1000000ULL * i, View(images[2 * i], info, stride),
+                View(images[2 * i + 1], info, stride));
+        }
+        NION_CHECK(writer.NumFrames() == numFrames);
+    }
+
+    nion::RecordingReader reader(file.Path());
+    const auto& readInfo = reader.Info();
+    NION_CHECK(readInfo.calibrationData == info.calibrationData);
+    NION_CHECK(readInfo.scaleFactor == info.scaleFactor);
+    NION_CHECK(readInfo.validDepthMin == info.validDepthMin);
+    NION_CHECK(readInfo.validDepthMax == info.validDepthMax);
+    NION_CHECK(readInfo.geometry == info.geometry);
+    NION_CHECK(readInfo.isCompressed == isCompressed);
+
+    // The planes of the frame are reused
+    nion::RecordedFrame frame;
+    const uint16_t* depthData = nullptr;
+    for (uint16_t i = 0; i < numFrames; ++i)
+    {
+        NION_CHECK(reader.ReadFrame(frame));
+        NION_CHECK(frame.frameId == i + 10U);
+        NION_CHECK(frame.timestampNs == 1000000ULL * i);
+        NION_CHECK(IsEqual(nion::AsConst(frame.depthMap.View()), View(images[2 * i], info, stride)));
+        NION_CHECK(IsEqual(nion::AsConst(frame.intensity.View()), View(images[2 * i + 1], info, stride)));
+
+        NION_CHECK(depthData == nullptr || frame.depthMap.View().data == depthData);
+        depthData = frame.depthMap.View().data;
+    }
+    NION_CHECK(!reader.ReadFrame(frame));
+}
+
+void TestUncompressedRoundTrip()
+{
+    CheckRoundTrip(false);
+}
+
+void TestCompressedRoundTrip()
+{
+    CheckRoundTrip(true);
+}
+
+void TestReadAllFrames()
+{
+    const nion::test::TemporaryFile file("all_frames.nionrec");
+    const auto info = CreateInfo(true);
+    const auto image = CreateImage(info, 123, info.geometry.width);
+    {
+        nion::RecordingWriter writer(file.Path(), info);
+        for (uint64_t i = 0; i < 4; ++i)
+        {
+            writer.WriteFrame(i, i, View(image, info, info.geometry.width), View(image, info, info.geometry.width));
+        }
+    }
+
+    nion::RecordingReader reader(file.Path());
+    const auto frames = reader.ReadAllFrames();
+    NION_CHECK(frames.size() == 4);
+    for (uint64_t i = 0; i < frames.size(); ++i)
+    {
+        NION_CHECK(frames[i].frameId == i);
+        NION_CHECK(IsEqual(frames[i].intensity.View(), View(image, info, info.geometry.width)));
+    }
+}
+
+void TestWrongImageSize()
+{
+    const nion::test::TemporaryFile file("wrong_size.nionrec");
+    const auto info = CreateInfo(false);
+    const std::vector<uint16_t> image(info.geometry.width * info.geometry.height);
+    const nion::PlaneView<const uint16_t> smaller{ image.data(), info.geometry.width - 1, info.geometry.height,
+        info.geometry.width };
+
+    nion::RecordingWriter writer(file.Path(), info);
+    NION_CHECK_THROWS(
+        writer.WriteFrame(0, 0, smaller, View(image, info, info.geometry.width)), std::invalid_argument);
+    NION_CHECK(writer.NumFrames() == 0);
+}
+
+void TestInvalidFiles()
+{
+    NION_CHECK_THROWS(nion::RecordingReader("missing.nionrec"), std::runtime_error);
+
+    const nion::test::TemporaryFile notARecording("not_a_recording.nionrec");
+    std::ofstream(notARecording.Path()) << "This is not a recording, but long enough to hold a recording header.";
+    NION_CHECK_THROWS(nion::RecordingReader(notARecording.Path()), std::runtime_error);
+
+    // A frame whose images end early
+    const nion::test::TemporaryFile truncated("truncated.nionrec");
+    const auto info = CreateInfo(false);
+    const auto image = CreateImage(info, 1, info.geometry.width);
+    {
+        nion::RecordingWriter writer(truncated.Path(), info);
+        writer.WriteFrame(0, 0, View(image, info, info.geometry.width), View(image, info, info.geometry.width));
+    }
+    std::vector<char> data;
+    {
+        std::ifstream input(truncated.Path(), std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    std::ofstream(truncated.Path(), std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size() - 2));
+
+    nion::RecordingReader reader(truncated.Path());
+    nion::RecordedFrame frame;
+    NION_CHECK_THROWS(reader.ReadFrame(frame), std::runtime_error);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "UncompressedRoundTrip", TestUncompressedRoundTrip },
+        { "CompressedRoundTrip", TestCompressedRoundTrip },
+        { "ReadAllFrames", TestReadAllFrames },
+        { "WrongImageSize", TestWrongImageSize },
+        { "InvalidFiles", TestInvalidFiles },
+    });
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Project headers
+#include "sequence_file.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+constexpr size_t width = 6;
+constexpr size_t height = 4;
+
+// Rows padded to a stride larger than the width, like the planes of the workspace
+constexpr size_t stride = 8;
+
+nion::SequenceSettings Settings(size_t maxNumFrames)
+{
+    nion::SequenceSettings settings;
+    settings.maxNumFrames = maxNumFrames;
+    settings.chunkSize = 1;
+    return settings;
+}
+
+template <typename T>
+std::vector<T> CreatePlane(int seed)
+{
+    std::vector<T> plane(stride * height, T{});
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            plane[y * stride + x] = static_cast<T>(seed + 10 * y + x);
+        }
+    }
+    return plane;
+}
+
+template <typename T>
+nion::PlaneView<const T> View(const std::vector<T>& plane)
+{
+    return { plane.data(), width, height, stride };
+}
+
+template <typename T>
+bool IsEqual(nion::PlaneView<const T> a, nion::PlaneView<const T> b)
+{
+    if (a.width != b.width || a.height != b.height)
+    {
+        return false;
+    }
+
+    for (size_t y = 0; y < a.height; ++y)
+    {
+        for (size_t x = 0; x < a.width; ++x)
+        {
+            if (a.Row(y)[x] != b.Row(y)[x])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void TestRoundTrip()
+{
+    const nion::test::TemporaryFile file("sequence_file_test_round_trip.nionseq");
+    const auto depth = CreatePlane<float>(1000);
+    const auto rawDepth = CreatePlane<uint16_t>(4000);
+    const auto intensity = CreatePlane<uint16_t>(50);
+    nion::PointCloud pointCloud;
+    pointCloud.points = { { 1.0F, 2.0F, 3.0F, 4.0F }, { -1.0F, -2.0F, 300.0F, 0.5F } };
+    pointCloud.width = 2;
+    pointCloud.height = 1;
+
+    {
+        nion::SequenceWriter writer(file.Path(), width, height, Settings(4));
+        NION_CHECK(writer.WriteFrame(7, 700, View(depth), View(intensity), &pointCloud));
+
+        // Parts skipped by the output profile are not stored
+        NION_CHECK(writer.WriteFrame(8, 800, {}, View(intensity), nullptr));
+
+        // Raw depth maps are stored raw with their scale factor
+        NION_CHECK(writer.WriteFrame(9, 900, nion::DepthMapView(View(rawDepth), 0.25F), {}, nullptr));
+        NION_CHECK(writer.NumFrames() == 3);
+        writer.Close();
+    }
+
+    const nion::SequenceReader reader(file.Path());
+    NION_CHECK(reader.NumFrames() == 3);
+    NION_CHECK(reader.Width() == width && reader.Height() == height);
+
+    const auto first = reader.Frame(0);
+    NION_CHECK(first.frameId == 7 && first.timestampNs == 700);
+    NION_CHECK(IsEqual(first.depthMap.metric, View(depth)) && !first.depthMap.raw.data);
+    NION_CHECK(IsEqual(first.intensity, View(intensity)));
+    NION_CHECK(first.numPoints == 2 && first.pointCloudWidth == 2 && first.pointCloudHeight == 1);
+    NION_CHECK(first.points[1].z == 300.0F && first.points[1].intensity == 0.5F);
+
+    const auto second = reader.Frame(1);
+    NION_CHECK(second.frameId == 8);
+    NION_CHECK(!second.depthMap.metric.data && !second.depthMap.raw.data && !second.points);
+    NION_CHECK(IsEqual(second.intensity, View(intensity)));
+
+    const auto third = reader.Frame(2);
+    NION_CHECK(!third.depthMap.metric.data && !third.intensity.data);
+    NION_CHECK(IsEqual(third.depthMap.raw, View(rawDepth)));
+    NION_CHECK(third.depthMap.scaleFactor == 0.25F);
+
+    NION_CHECK_THROWS(reader.Frame(3), std::out_of_range);
+}
+
+// Once the index is full, the file ends and further frames are only counted
+void TestFullIndex()
+{
+    const nion::test::TemporaryFile file("sequence_file_test_full_index.nionseq");
+    const auto intensity = CreatePlane<uint16_t>(0);
+
+    {
+        nion::SequenceWriter writer(file.Path(), width, height, Settings(3));
+        for (uint64_t frameId = 0; frameId < 5; ++frameId)
+        {
+            NION_CHECK(writer.WriteFrame(frameId, 0, {}, View(intensity), nullptr) == (frameId < 3));
+        }
+
+        NION_CHECK(writer.NumFrames() == 3);
+        NION_CHECK(writer.NumSkippedFrames() == 2);
+        writer.Close();
+    }
+
+    const nion::SequenceReader reader(file.Path());
+    NION_CHECK(reader.NumFrames() == 3);
+    NION_CHECK(reader.Frame(2).frameId == 2);
+}
+
+void TestWrongSize()
+{
+    const nion::test::TemporaryFile file("sequence_file_test_wrong_size.nionseq");
+    const std::vector<uint16_t> intensity(width * height);
+    nion::SequenceWriter writer(file.Path(), width, height, Settings(2));
+
+    const nion::PlaneView<const uint16_t> wrongSize{ intensity.data(), height, width, height };
+    NION_CHECK_THROWS(writer.WriteFrame(0, 0, {}, wrongSize, nullptr), std::invalid_argument);
+    NION_CHECK(writer.NumFrames() == 0);
+
+    writer.Close();
+    NION_CHECK_THROWS(writer.WriteFrame(0, 0, {}, {}, nullptr), std::logic_error);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "RoundTrip", TestRoundTrip },
+        { "FullIndex", TestFullIndex },
+        { "WrongSize", TestWrongSize },
+    });
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Project headers
+#include "shared_memory_ring.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+constexpr size_t width = 5;
+constexpr size_t height = 3;
+constexpr size_t numSlots = 3;
+
+// Every test case uses its own ring, so the test can run next to a running example
+std::string RingName(const char* testCase)
+{
+    return std::string("nion_point_cloud_test_") + testCase;
+}
+
+// Images of one frame, with padded rows like the images of the workspace, and values that depend on the frame
+struct Frame
+{
+    explicit Frame(uint16_t value)
+        : rawDepth(stride * height)
+        , metricDepth(stride * height)
+        , intensity(stride * height)
+    {
+        for (size_t i = 0; i < rawDepth.size(); ++i)
+        {
+            rawDepth[i] = static_cast<uint16_t>(value + i);
+            metricDepth[i] = static_cast<float>(rawDepth[i]) * 0.5F;
+            intensity[i] = static_cast<uint16_t>(value * 2 + i);
+        }
+
+        pointCloud.width = 4;
+        pointCloud.height = 1;
+        for (size_t i = 0; i < pointCloud.width; ++i)
+        {
+            const auto coordinate = static_cast<float>(value + i);
+            pointCloud.points.push_back({ coordinate, -coordinate, coordinate * 2.0F, static_cast<float>(value) });
+        }
+    }
+
+    nion::PlaneView<const uint16_t> RawDepth() const
+    {
+        return { rawDepth.data(), width, height, stride };
+    }
+
+    nion::PlaneView<const float> MetricDepth() const
+    {
+        return { metricDepth.data(), width, height, stride };
+    }
+
+    nion::PlaneView<const uint16_t> Intensity() const
+    {
+        return { intensity.data(), width, height, stride };
+    }
+
+    static constexpr size_t stride = width + 3;
+    std::vector<uint16_t> rawDepth;
+    std::vector<float> metricDepth;
+    std::vector<uint16_t> intensity;
+    nion::PointCloud pointCloud;
+};
+
+// The slots hold the images without the padding of the rows
+template <typename T>
+bool IsEqual(nion::PlaneView<const T> slot, nion::PlaneView<const T> image)
+{
+    if (!slot.data || slot.width != image.width || slot.height != image.height)
+    {
+        return false;
+    }
+
+    for (size_t y = 0; y < image.height; ++y)
+    {
+        if (std::memcmp(slot.Row(y), image.Row(y), image.width * sizeof(T)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestRoundTrip()
+{
+    const auto name = RingName("RoundTrip");
+    nion::SharedMemoryRing ring(name, numSlots, width, height);
+    nion::SharedMemoryRingReader reader(name);
+    NION_CHECK(reader.NumPublishedFrames() == 0);
+
+    nion::SharedMemoryRingReader::Frame frame;
+    NION_CHECK(!reader.BeginRead(0, frame));
+
+    const Frame published(100);
+    ring.Publish(42, 4200, published.MetricDepth(), published.Intensity(), &published.pointCloud);
+    NION_CHECK(ring.NumPublishedFrames() == 1 && reader.NumPublishedFrames() == 1);
+
+    NION_CHECK(reader.BeginRead(0, frame));
+    NION_CHECK(frame.header->frameNumber == 0 && frame.header->frameId == 42 && frame.header->timestampNs == 4200);
+    NION_CHECK(IsEqual(frame.depthMap.metric, published.MetricDepth()));
+    NION_CHECK(IsEqual(frame.intensity, published.Intensity()));
+    NION_CHECK(frame.header->pointCloudWidth == 4 && frame.header->pointCloudHeight == 1);
+    NION_CHECK(frame.header->numPoints == 4 && frame.points);
+    NION_CHECK(std::memcmp(frame.points, published.pointCloud.points.data(), 4 * sizeof(nion::PointXYZI)) == 0);
+    NION_CHECK(reader.EndRead(frame));
+
+    // Frames that are not published yet
+    NION_CHECK(!reader.BeginRead(1, frame));
+}
+
+// Metric and raw depth maps are told apart by the flags, and skipped results are not flagged
+void TestFlags()
+{
+    const auto name = RingName("Flags");
+    nion::SharedMemoryRing ring(name, numSlots, width, height);
+    nion::SharedMemoryRingReader reader(name);
+
+    const Frame published(7);
+    ring.Publish(0, 0, published.MetricDepth(), {}, nullptr);
+    ring.Publish(1, 0, nion::DepthMapView(published.RawDepth(), 0.25F), published.Intensity(), nullptr);
+    ring.Publish(2, 0, {}, {}, &published.pointCloud);
+
+    nion::SharedMemoryRingReader::Frame frame;
+    NION_CHECK(reader.BeginRead(0, frame));
+    NION_CHECK(frame.header->flags == nion::SharedFrameHasDepthMap && frame.header->depthScaleFactor == 0.0F);
+    NION_CHECK(IsEqual(frame.depthMap.metric, published.MetricDepth()) && !frame.depthMap.raw.data);
+    NION_CHECK(!frame.intensity.data && !frame.points && frame.header->numPoints == 0);
+    NION_CHECK(reader.EndRead(frame));
+
+    NION_CHECK(reader.BeginRead(1, frame));
+    NION_CHECK(frame.header->flags
+        == (nion::SharedFrameHasDepthMap | nion::SharedFrameHasRawDepthMap | nion::SharedFrameHasIntensity));
+    NION_CHECK(IsEqual(frame.depthMap.raw, published.RawDepth()) && !frame.depthMap.metric.data);
+    NION_CHECK(frame.depthMap.scaleFactor == 0.25F && frame.header->depthScaleFactor == 0.25F);
+    NION_CHECK(IsEqual(frame.intensity, published.Intensity()) && !frame.points);
+    NION_CHECK(reader.EndRead(frame));
+
+    NION_CHECK(reader.BeginRead(2, frame));
+    NION_CHECK(frame.header->flags == nion::SharedFrameHasPointCloud);
+    NION_CHECK(!frame.depthMap.metric.data && !frame.depthMap.raw.data && !frame.intensity.data);
+    NION_CHECK(frame.points && frame.header->numPoints == 4);
+    NION_CHECK(reader.EndRead(frame));
+}
+
+// A slot is overwritten numSlots frames later, which BeginRead() refuses and EndRead() detects
+void TestOverwrittenSlot()
+{
+    const auto name = RingName("OverwrittenSlot");
+    nion::SharedMemoryRing ring(name, numSlots, width, height);
+    nion::SharedMemoryRingReader reader(name);
+
+    const Frame first(1);
+    ring.Publish(0, 0, first.MetricDepth(), first.Intensity(), nullptr);
+
+    nion::SharedMemoryRingReader::Frame frame;
+    NION_CHECK(reader.BeginRead(0, frame));
+
+    // The writer laps the reader while it reads frame 0
+    const Frame next(2);
+    for (size_t i = 1; i <= numSlots; ++i)
+    {
+        ring.Publish(i, 0, next.MetricDepth(), next.Intensity(), nullptr);
+    }
+    NION_CHECK(!reader.EndRead(frame));
+    NION_CHECK(!reader.BeginRead(0, frame));
+
+    // The frames that are still in the ring can be read
+    for (uint64_t frameNumber = 1; frameNumber <= numSlots; ++frameNumber)
+    {
+        NION_CHECK(reader.BeginRead(frameNumber, frame));
+        NION_CHECK(frame.header->frameId == frameNumber);
+        NION_CHECK(reader.EndRead(frame));
+    }
+}
+
+void TestFrameTooLarge()
+{
+    const auto name = RingName("FrameTooLarge");
+    nion::SharedMemoryRing ring(name, numSlots, width, height);
+
+    const std::vector<float> depth((width + 1) * height);
+    const std::vector<uint16_t> image(width * (height + 1));
+    const nion::PlaneView<const float> wideDepth{ depth.data(), width + 1, height, width + 1 };
+    const nion::PlaneView<const uint16_t> highImage{ image.data(), width, height + 1, width };
+
+    NION_CHECK_THROWS(ring.Publish(0, 0, wideDepth, {}, nullptr), std::invalid_argument);
+    NION_CHECK_THROWS(ring.Publish(0, 0, nion::DepthMapView(highImage, 1.0F), {}, nullptr), std::invalid_argument);
+    NION_CHECK_THROWS(ring.Publish(0, 0, {}, highImage, nullptr), std::invalid_argument);
+
+    nion::PointCloud pointCloud;
+    pointCloud.points.resize(width * height + 1);
+    pointCloud.width = pointCloud.points.size();
+    pointCloud.height = 1;
+    NION_CHECK_THROWS(ring.Publish(0, 0, {}, {}, &pointCloud), std::invalid_argument);
+
+    // Rejected frames do not take a slot
+    NION_CHECK(ring.NumPublishedFrames() == 0);
+    pointCloud.points.resize(width * height);
+    ring.Publish(0, 0, {}, {}, &pointCloud);
+    NION_CHECK(ring.NumPublishedFrames() == 1);
+}
+
+void TestUnknownRing()
+{
+    NION_CHECK_THROWS(nion::SharedMemoryRingReader(RingName("UnknownRing")), std::runtime_error);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "RoundTrip", TestRoundTrip },
+        { "Flags", TestFlags },
+        { "OverwrittenSlot", TestOverwrittenSlot },
+        { "FrameTooLarge", TestFrameTooLarge },
+        { "UnknownRing", TestUnknownRing },
+    });
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+// Project headers
+#include "temporal_filter.hpp"
+#include "test.hpp"
+
+namespace
+{
+
+// Single pixel depth map that is filtered frame by frame
+class Pixel
+{
+public:
+    explicit Pixel(const nion::TemporalFilterSettings& settings)
+        : m_filter(1, 1, settings)
+    {}
+
+    // Returns the filtered depth, or -1 if the pixel is invalid
+    float Apply(float depthMm, bool isValid = true)
+    {
+        m_depth.View().data[0] = isValid ? depthMm : 0.0F;
+        m_valid.View().data[0] = isValid ? 1 : 0;
+        m_filter.Apply(m_depth.View(), m_valid.View());
+
+        NION_CHECK(m_valid.View().data[0] != 0 || m_depth.View().data[0] == 0.0F);
+        return m_valid.View().data[0] != 0 ? m_depth.View().data[0] : -1.0F;
+    }
+
+private:
+    nion::TemporalDepthFilter m_filter;
+    nion::Plane<float> m_depth{ 1, 1 };
+    nion::Plane<uint8_t> m_valid{ 1, 1 };
+};
+
+nion::TemporalFilterSettings Settings(size_t frameCount, size_t minValidCount = 1, float maxDeviationMm = 0.0F)
+{
+    nion::TemporalFilterSettings settings;
+    settings.frameCount = frameCount;
+    settings.minValidCount = minValidCount;
+    settings.maxDeviationMm = maxDeviationMm;
+    return settings;
+}
+
+void TestInvalidSettings()
+{
+    NION_CHECK_THROWS(nion::TemporalDepthFilter(4, 4, Settings(0)), std::invalid_argument);
+    NION_CHECK_THROWS(nion::TemporalDepthFilter(4, 4, Settings(1)), std::invalid_argument);
+    NION_CHECK_THROWS(nion::TemporalDepthFilter(4, 4, Settings(256)), std::invalid_argument);
+
+    nion::TemporalDepthFilter filter(4, 4, Settings(2));
+    nion::Plane<float> depth(4, 3);
+    nion::Plane<uint8_t> valid(4, 3);
+    NION_CHECK_THROWS(filter.Apply(depth.View(), valid.View()), std::invalid_argument);
+}
+
+void TestRunningAverage()
+{
+    Pixel pixel(Settings(3));
+    NION_CHECK(pixel.Apply(100.0F) == 100.0F);
+    NION_CHECK(pixel.Apply(200.0F) == 150.0F);
+    NION_CHECK(pixel.Apply(300.0F) == 200.0F);
+
+    // The oldest depth map leaves the average
+    NION_CHECK(pixel.Apply(400.0F) == 300.0F);
+    NION_CHECK(std::abs(pixel.Apply(400.0F) - 1100.0F / 3.0F) < 1e-3F);
+}
+
+void TestMinValidCount()
+{
+    Pixel pixel(Settings(3, 2));
+
+    // Valid in fewer than two depth maps
+    NION_CHECK(pixel.Apply(100.0F) == -1.0F);
+    NION_CHECK(pixel.Apply(200.0F) == 150.0F);
+
+    // Invalid now, but valid often enough in the earlier depth maps
+    NION_CHECK(pixel.Apply(0.0F, false) == 150.0F);
+
+    // The first valid depth map left the ring
+    NION_CHECK(pixel.Apply(0.0F, false) == -1.0F);
+    NION_CHECK(pixel.Apply(0.0F, false) == -1.0F);
+}
+
+void TestMaxDeviation()
+{
+    Pixel pixel(Settings(4, 1, 50.0F));
+    NION_CHECK(pixel.Apply(1000.0F) == 1000.0F);
+    NION_CHECK(pixel.Apply(1040.0F) == 1020.0F);
+
+    // A moving object keeps its new depth, but still enters the history, so the return to the previous depth
+    // deviates from the average as well
+    NION_CHECK(pixel.Apply(2000.0F) == 2000.0F);
+    NION_CHECK(pixel.Apply(1020.0F) == 1020.0F);
+
+    // Within the deviation of the average of 1040, 2000 and 1020
+    NION_CHECK(pixel.Apply(1350.0F) == 1352.5F);
+}
+
+// Invalid pixels are neither averaged nor change the average of their neighbors
+void TestPixelsAreIndependent()
+{
+    nion::TemporalDepthFilter filter(3, 2, Settings(2));
+    nion::Plane<float> depth(3, 2);
+    nion::Plane<uint8_t> valid(3, 2);
+
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        for (size_t i = 0; i < 6; ++i)
+        {
+            depth.View().data[i] = (i % 2 == 0) ? static_cast<float>(100 * (i + 1) + 10 * frame) : 0.0F;
+            valid.View().data[i] = (i % 2 == 0) ? 1 : 0;
+        }
+        filter.Apply(depth.View(), valid.View());
+    }
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            NION_CHECK(valid.View().data[i] == 1);
+            NION_CHECK(depth.View().data[i] == static_cast<float>(100 * (i + 1) + 5));
+        }
+        else
+        {
+            NION_CHECK(valid.View().data[i] == 0);
+            NION_CHECK(depth.View().data[i] == 0.0F);
+        }
+    }
+}
+
+// The sums are kept in fixed point, so a long sequence leaves no rounding error behind
+void TestNoDrift()
+{
+    constexpr size_t frameCount = 8;
+    Pixel pixel(Settings(frameCount));
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> distribution(500.0F, 5000.0F);
+
+    std::deque<double> window;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const auto value = std::round(distribution(random) * 16.0F) / 16.0F;
+        window.push_back(value);
+        if (window.size() > frameCount)
+        {
+            window.pop_front();
+        }
+
+        const auto filtered = pixel.Apply(value);
+        const auto expected = std::accumulate(window.begin(), window.end(), 0.0) / static_cast<double>(window.size());
+        NION_CHECK(std::abs(filtered - expected) < 0.01);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "InvalidSettings", TestInvalidSettings },
+        { "RunningAverage", TestRunningAverage },
+        { "MinValidCount", TestMinValidCount },
+        { "MaxDeviation", TestMaxDeviation },
+        { "PixelsAreIndependent", TestPixelsAreIndependent },
+        { "NoDrift", TestNoDrift },
+    });
+}
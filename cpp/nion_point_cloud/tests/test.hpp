@@ -0,0 +1,126 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal checks for the unit tests, so they only require the standard library. A failed check throws, which ends the
+// current test case, and the test executable fails if any of its cases failed.
+#define NION_CHECK(condition) nion::test::Check((condition), #condition, __FILE__, __LINE__)
+
+// Check that the statement throws an exception of the given type
+#define NION_CHECK_THROWS(statement, exceptionType)                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        auto hasThrown = false;                                                                                        \
+        try                                                                                                            \
+        {                                                                                                              \
+            statement;                                                                                                 \
+        }                                                                                                              \
+        catch (const exceptionType&)                                                                                   \
+        {                                                                                                              \
+            hasThrown = true;                                                                                          \
+        }                                                                                                              \
+        nion::test::Check(hasThrown, #statement " throws " #exceptionType, __FILE__, __LINE__);                        \
+    } while (false)
+
+namespace nion
+{
+namespace test
+{
+
+// Returned by test executables whose cases could not run, e.g. without input data, so CTest reports them as skipped
+constexpr int skipExitCode = 77;
+
+struct TestCase
+{
+    std::string name;
+    std::function<void()> function;
+};
+
+inline void Check(bool condition, const char* expression, const char* file, int line)
+{
+    if (!condition)
+    {
+        std::ostringstream message;
+        message << file << ":" << line << ": check failed: " << expression;
+        throw std::runtime_error(message.str());
+    }
+}
+
+// File in the working directory, which CTest sets to the build directory of the tests. The file is removed when the
+// object is created and destroyed, so a failed test does not leave data for the next run.
+class TemporaryFile
+{
+public:
+    explicit TemporaryFile(std::string name)
+        : m_path(std::move(name))
+    {
+        std::remove(m_path.c_str());
+    }
+
+    ~TemporaryFile()
+    {
+        std::remove(m_path.c_str());
+    }
+
+    TemporaryFile(const TemporaryFile&) = delete;
+    TemporaryFile& operator=(const TemporaryFile&) = delete;
+    TemporaryFile(TemporaryFile&&) = delete;
+    TemporaryFile& operator=(TemporaryFile&&) = delete;
+
+    const std::string& Path() const
+    {
+        return m_path;
+    }
+
+private:
+    std::string m_path;
+};
+
+// Run all test cases, also after a failed one, and return the exit code of the test executable
+inline int Run(const std::vector<TestCase>& testCases)
+{
+    size_t numFailed = 0;
+    for (const auto& testCase : testCases)
+    {
+        try
+        {
+            testCase.function();
+            std::cout << "[  OK  ] " << testCase.name << std::endl;
+        }
+        catch (const std::exception& e)
+        {
+            ++numFailed;
+            std::cout << "[FAILED] " << testCase.name << ": " << e.what() << std::endl;
+        }
+    }
+
+    std::cout << testCases.size() - numFailed << " of " << testCases.size() << " test cases passed." << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
+
+} // namespace test
+} // namespace nion
@@ -0,0 +1,265 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+// Project headers
+#include "test.hpp"
+#include "throughput_controller.hpp"
+
+namespace
+{
+
+constexpr size_t periodFrameCount = 4;
+
+// Frames arrive every 10 ms, so a period of processed frames has 4 / 30 ms, about 133 frames per second
+constexpr std::chrono::milliseconds frameInterval(10);
+
+struct Period
+{
+    bool isDropped{};
+    double occupancy{ 0.5 };
+    uint64_t numLostFrames{};
+    std::chrono::steady_clock::duration latency{};
+};
+
+const Period overloaded{ true, 0.9, 0, {} };
+const Period headroom{ false, 0.1, 0, {} };
+const Period lostFrames{ false, 0.5, 1, {} };
+
+// Received frames, whose periods are fed into a controller one after another
+class Frames
+{
+public:
+    explicit Frames(nion::ThroughputController& controller)
+        : m_controller(controller)
+    {}
+
+    // Returns true if the period changed the knobs
+    bool Run(const Period& period)
+    {
+        auto hasChanged = false;
+        for (size_t i = 0; i < periodFrameCount; ++i)
+        {
+            m_controller.OnFrameFinished(period.latency);
+            hasChanged = m_controller.OnFrameReceived(m_time, true, period.isDropped && i == 0, period.occupancy,
+                i == 0 ? period.numLostFrames : 0);
+            m_time += frameInterval;
+        }
+        return hasChanged;
+    }
+
+    // Run the period and the following one, which is not evaluated as it settles the change
+    bool RunAndSettle(const Period& period)
+    {
+        const auto hasChanged = Run(period);
+        NION_CHECK(!Run(overloaded));
+        return hasChanged;
+    }
+
+private:
+    nion::ThroughputController& m_controller;
+    std::chrono::steady_clock::time_point m_time{};
+};
+
+nion::ThroughputControlSettings Settings()
+{
+    nion::ThroughputControlSettings settings;
+    settings.latencyBudgetMs = 100.0;
+    settings.periodFrameCount = periodFrameCount;
+    settings.relaxPeriodCount = 2;
+    settings.maxNumWorkers = 2;
+    settings.maxDecimation = 3;
+    settings.maxNumBuffers = 8;
+    settings.maxBinning = 4;
+    return settings;
+}
+
+nion::ThroughputKnobs InitialKnobs()
+{
+    nion::ThroughputKnobs knobs;
+    knobs.numBuffers = 4;
+    return knobs;
+}
+
+bool IsEqual(const nion::ThroughputKnobs& knobs, size_t numWorkers, size_t decimation, size_t numBuffers,
+    uint32_t binning)
+{
+    return knobs.numWorkers == numWorkers && knobs.decimation == decimation && knobs.numBuffers == numBuffers
+        && knobs.binning == binning;
+}
+
+// Overload adds workers, then decimates and finally doubles the binning, one knob per period
+void TestTighten()
+{
+    nion::ThroughputController controller(Settings(), InitialKnobs());
+    Frames frames(controller);
+
+    NION_CHECK(frames.RunAndSettle(overloaded));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 1, 4, 1));
+    NION_CHECK(frames.RunAndSettle(overloaded));
+    NION_CHECK(frames.RunAndSettle(overloaded));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 3, 4, 1));
+    NION_CHECK(frames.RunAndSettle(overloaded));
+    NION_CHECK(frames.RunAndSettle(overloaded));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 3, 4, 4));
+
+    // All knobs are at their limits
+    NION_CHECK(!frames.Run(overloaded));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 3, 4, 4));
+}
+
+// Frames lost by the data stream add half of the buffers, up to the maximum
+void TestLostFrames()
+{
+    nion::ThroughputController controller(Settings(), InitialKnobs());
+    Frames frames(controller);
+
+    NION_CHECK(frames.RunAndSettle(lostFrames));
+    NION_CHECK(IsEqual(controller.Knobs(), 1, 1, 6, 1));
+    NION_CHECK(frames.RunAndSettle(lostFrames));
+    NION_CHECK(IsEqual(controller.Knobs(), 1, 1, 8, 1));
+
+    // Without more buffers, lost frames alone do not tighten the processing
+    NION_CHECK(!frames.Run(lostFrames));
+    NION_CHECK(IsEqual(controller.Knobs(), 1, 1, 8, 1));
+}
+
+// The period after a change is not evaluated, even if it is overloaded
+void TestSettle()
+{
+    nion::ThroughputController controller(Settings(), InitialKnobs());
+    Frames frames(controller);
+
+    NION_CHECK(frames.Run(overloaded));
+    NION_CHECK(!frames.Run(overloaded));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 1, 4, 1));
+    NION_CHECK(frames.Run(overloaded));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 2, 4, 1));
+}
+
+// After relaxPeriodCount periods with headroom, the knobs are relaxed in reverse order, down to the initial binning
+void TestRelax()
+{
+    auto initialKnobs = InitialKnobs();
+    initialKnobs.binning = 2;
+    nion::ThroughputController controller(Settings(), initialKnobs);
+    Frames frames(controller);
+
+    NION_CHECK(frames.RunAndSettle(lostFrames));
+    for (int i = 0; i < 4; ++i)
+    {
+        NION_CHECK(frames.RunAndSettle(overloaded));
+    }
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 3, 6, 4));
+
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(frames.Run(headroom));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 3, 6, 2));
+
+    // A period without headroom starts the count over
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(!frames.Run(Period{}));
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(frames.Run(headroom));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 2, 6, 2));
+
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(frames.Run(headroom));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 1, 6, 2));
+
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(frames.Run(headroom));
+    NION_CHECK(IsEqual(controller.Knobs(), 1, 1, 6, 2));
+
+    // Buffers are kept and the binning is not reduced below the initial one
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(!frames.Run(headroom));
+    NION_CHECK(IsEqual(controller.Knobs(), 1, 1, 6, 2));
+}
+
+// A latency above the budget overloads the period, a latency above half of it leaves no headroom
+void TestLatencyBudget()
+{
+    nion::ThroughputController controller(Settings(), InitialKnobs());
+    Frames frames(controller);
+
+    NION_CHECK(frames.RunAndSettle(Period{ false, 0.1, 0, std::chrono::milliseconds(150) }));
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 1, 4, 1));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        NION_CHECK(!frames.Run(Period{ false, 0.1, 0, std::chrono::milliseconds(80) }));
+    }
+    NION_CHECK(IsEqual(controller.Knobs(), 2, 1, 4, 1));
+}
+
+// The decimation only increases as long as the minimum frame rate is kept
+void TestMinFrameRate()
+{
+    auto settings = Settings();
+    settings.maxNumWorkers = 1;
+    settings.minFrameRate = 80.0;
+    nion::ThroughputController controller(settings, InitialKnobs());
+    Frames frames(controller);
+
+    // About 133 frames per second go down to 67, so the binning is doubled instead
+    NION_CHECK(frames.RunAndSettle(overloaded));
+    NION_CHECK(IsEqual(controller.Knobs(), 1, 1, 4, 2));
+}
+
+void TestShouldProcess()
+{
+    auto initialKnobs = InitialKnobs();
+    initialKnobs.decimation = 3;
+    const nion::ThroughputController controller(Settings(), initialKnobs);
+    NION_CHECK(controller.ShouldProcess(0) && controller.ShouldProcess(3));
+    NION_CHECK(!controller.ShouldProcess(1) && !controller.ShouldProcess(5));
+}
+
+void TestInvalidSettings()
+{
+    auto settings = Settings();
+    settings.periodFrameCount = 0;
+    NION_CHECK_THROWS(nion::ThroughputController(settings, InitialKnobs()), std::invalid_argument);
+
+    auto knobs = InitialKnobs();
+    knobs.binning = 0;
+    NION_CHECK_THROWS(nion::ThroughputController(Settings(), knobs), std::invalid_argument);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "Tighten", TestTighten },
+        { "LostFrames", TestLostFrames },
+        { "Settle", TestSettle },
+        { "Relax", TestRelax },
+        { "LatencyBudget", TestLatencyBudget },
+        { "MinFrameRate", TestMinFrameRate },
+        { "ShouldProcess", TestShouldProcess },
+        { "InvalidSettings", TestInvalidSettings },
+    });
+}
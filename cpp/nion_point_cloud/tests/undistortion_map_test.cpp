@@ -0,0 +1,157 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Project headers
+#include "test.hpp"
+#include "undistortion_map.hpp"
+
+namespace
+{
+
+constexpr size_t width = 12;
+constexpr size_t height = 9;
+
+nion::LensModel IdentityModel()
+{
+    nion::LensModel model;
+    model.fx = 10.0;
+    model.fy = 10.0;
+    model.cx = 5.5;
+    model.cy = 4.0;
+    return model;
+}
+
+std::vector<uint16_t> CreateImage()
+{
+    std::vector<uint16_t> image(width * height);
+    for (size_t i = 0; i < image.size(); ++i)
+    {
+        image[i] = static_cast<uint16_t>(100 + 7 * i);
+    }
+    return image;
+}
+
+// Sample the source image like the direct backend does for intensity images, 0 for invalid pixels
+float Interpolate(const std::vector<uint16_t>& image, const nion::UndistortionMap::BilinearSample& sample)
+{
+    if (sample.index == nion::UndistortionMap::invalidIndex)
+    {
+        return 0.0F;
+    }
+
+    const auto* top = image.data() + sample.index;
+    const auto* bottom = top + width;
+    const auto topValue = static_cast<float>(top[0]) * (1.0F - sample.weightX)
+        + static_cast<float>(top[1]) * sample.weightX;
+    const auto bottomValue = static_cast<float>(bottom[0]) * (1.0F - sample.weightX)
+        + static_cast<float>(bottom[1]) * sample.weightX;
+    return topValue * (1.0F - sample.weightY) + bottomValue * sample.weightY;
+}
+
+// Without distortion, every pixel is its own source, including the last row and column
+void TestIdentity()
+{
+    const nion::UndistortionMap map(IdentityModel(), width, height);
+    NION_CHECK(map.Width() == width && map.Height() == height);
+
+    const auto image = CreateImage();
+    const auto& nearest = map.NearestSourceIndices();
+    const auto& samples = map.BilinearSamples();
+    for (size_t i = 0; i < width * height; ++i)
+    {
+        NION_CHECK(nearest[i] == i);
+        NION_CHECK(std::fabs(Interpolate(image, samples[i]) - static_cast<float>(image[i])) < 1e-3F);
+    }
+}
+
+// The lens model cannot describe a pure shift, so a radial distortion that maps the undistorted corners outside the
+// distorted image is used. Those pixels must be invalid instead of clamped to the border.
+void TestBorder()
+{
+    auto model = IdentityModel();
+    model.k1 = 0.5;
+    const nion::UndistortionMap map(model, width, height);
+
+    const auto& nearest = map.NearestSourceIndices();
+    const auto& samples = map.BilinearSamples();
+    size_t numInvalid = 0;
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            double sourceX = 0.0;
+            double sourceY = 0.0;
+            nion::DistortPixel(model, static_cast<double>(x), static_cast<double>(y), sourceX, sourceY);
+
+            const auto index = y * width + x;
+            const auto isOutside = sourceX < 0.0 || sourceX > width - 1.0 || sourceY < 0.0 || sourceY > height - 1.0;
+            if (isOutside)
+            {
+                ++numInvalid;
+                NION_CHECK(nearest[index] == nion::UndistortionMap::invalidIndex);
+                NION_CHECK(samples[index].index == nion::UndistortionMap::invalidIndex);
+                continue;
+            }
+
+            const auto nearestX = static_cast<size_t>(std::lround(sourceX));
+            const auto nearestY = static_cast<size_t>(std::lround(sourceY));
+            NION_CHECK(nearest[index] == nearestY * width + nearestX);
+
+            // The weights point to the source position within its four neighbors
+            const auto& sample = samples[index];
+            const auto sampleX = static_cast<double>(sample.index % width) + sample.weightX;
+            const auto sampleY = static_cast<double>(sample.index / width) + sample.weightY;
+            NION_CHECK(std::fabs(sampleX - sourceX) < 1e-4 && std::fabs(sampleY - sourceY) < 1e-4);
+            NION_CHECK(sample.weightX >= 0.0F && sample.weightX <= 1.0F);
+            NION_CHECK(sample.weightY >= 0.0F && sample.weightY <= 1.0F);
+        }
+    }
+
+    // The corners are outside, the center is not
+    NION_CHECK(nearest[0] == nion::UndistortionMap::invalidIndex);
+    NION_CHECK(nearest[width * height - 1] == nion::UndistortionMap::invalidIndex);
+    NION_CHECK(numInvalid > 0 && numInvalid < width * height / 2);
+}
+
+// Maps are shared as long as they are used
+void TestSharedMaps()
+{
+    const auto first = nion::GetUndistortionMap(IdentityModel(), width, height);
+    NION_CHECK(nion::GetUndistortionMap(IdentityModel(), width, height) == first);
+    NION_CHECK(nion::GetUndistortionMap(IdentityModel(), width, height + 1) != first);
+
+    auto other = IdentityModel();
+    other.k1 = 0.1;
+    NION_CHECK(nion::GetUndistortionMap(other, width, height) != first);
+
+    NION_CHECK_THROWS(nion::UndistortionMap(IdentityModel(), 1, height), std::invalid_argument);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "Identity", TestIdentity },
+        { "Border", TestBorder },
+        { "SharedMaps", TestSharedMaps },
+    });
+}
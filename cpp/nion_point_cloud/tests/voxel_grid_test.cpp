@@ -0,0 +1,195 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Project headers
+#include "test.hpp"
+#include "voxel_grid.hpp"
+
+namespace
+{
+
+nion::PointCloud Cloud(std::vector<nion::PointXYZI> points)
+{
+    nion::PointCloud pointCloud;
+    pointCloud.points = std::move(points);
+    pointCloud.width = pointCloud.points.size();
+    pointCloud.height = 1;
+    return pointCloud;
+}
+
+bool IsNear(const nion::PointXYZI& a, const nion::PointXYZI& b, float tolerance = 1e-3F)
+{
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance
+        && std::abs(a.intensity - b.intensity) <= tolerance;
+}
+
+void TestAveragesPointsOfAVoxel()
+{
+    const auto input = Cloud({
+        { 1.0F, 1.0F, 1.0F, 10.0F },
+        { 3.0F, 5.0F, 7.0F, 30.0F },
+        { 12.0F, 1.0F, 1.0F, 100.0F },
+        { 2.0F, 3.0F, 4.0F, 20.0F },
+    });
+
+    nion::VoxelGridFilter filter;
+    nion::PointCloud output;
+    filter.Downsample(input, 10.0F, output);
+
+    // In the order of the first point of every voxel
+    NION_CHECK(output.points.size() == 2);
+    NION_CHECK(output.width == 2);
+    NION_CHECK(output.height == 1);
+    NION_CHECK(IsNear(output.points[0], { 2.0F, 3.0F, 4.0F, 20.0F }));
+    NION_CHECK(IsNear(output.points[1], { 12.0F, 1.0F, 1.0F, 100.0F }));
+}
+
+// Voxels are cubes from floor(value / leaf size) on, also for negative values
+void TestVoxelBoundaries()
+{
+    const auto input = Cloud({
+        { -0.5F, 0.0F, 0.0F, 0.0F },
+        { 0.5F, 0.0F, 0.0F, 0.0F },
+        { -1.5F, 0.0F, 0.0F, 0.0F },
+        { -0.1F, 0.0F, 0.0F, 0.0F },
+    });
+
+    nion::VoxelGridFilter filter;
+    nion::PointCloud output;
+    filter.Downsample(input, 1.0F, output);
+
+    NION_CHECK(output.points.size() == 3);
+    NION_CHECK(IsNear(output.points[0], { -0.3F, 0.0F, 0.0F, 0.0F }));
+    NION_CHECK(IsNear(output.points[1], { 0.5F, 0.0F, 0.0F, 0.0F }));
+    NION_CHECK(IsNear(output.points[2], { -1.5F, 0.0F, 0.0F, 0.0F }));
+}
+
+void TestSkipsInvalidPoints()
+{
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    const auto infinity = std::numeric_limits<float>::infinity();
+    const auto input = Cloud({
+        { nan, nan, nan, nan },
+        { 1.0F, infinity, 1.0F, 5.0F },
+        { 1.0F, 1.0F, 1.0F, 5.0F },
+    });
+
+    nion::VoxelGridFilter filter;
+    nion::PointCloud output;
+    filter.Downsample(input, 10.0F, output);
+
+    NION_CHECK(output.points.size() == 1);
+    NION_CHECK(IsNear(output.points[0], { 1.0F, 1.0F, 1.0F, 5.0F }));
+
+    filter.Downsample(Cloud({ { nan, 0.0F, 0.0F, 0.0F } }), 10.0F, output);
+    NION_CHECK(output.points.empty());
+    NION_CHECK(output.width == 0);
+}
+
+void TestInvalidArguments()
+{
+    nion::VoxelGridFilter filter;
+    auto pointCloud = Cloud({ { 1.0F, 1.0F, 1.0F, 1.0F } });
+    nion::PointCloud output;
+
+    NION_CHECK_THROWS(filter.Downsample(pointCloud, 0.0F, output), std::invalid_argument);
+    NION_CHECK_THROWS(filter.Downsample(pointCloud, -1.0F, output), std::invalid_argument);
+    NION_CHECK_THROWS(
+        filter.Downsample(pointCloud, std::numeric_limits<float>::quiet_NaN(), output), std::invalid_argument);
+    NION_CHECK_THROWS(filter.Downsample(pointCloud, 1.0F, pointCloud), std::invalid_argument);
+}
+
+// Compare with a straightforward implementation, also when the table of the filter is reused
+void TestMatchesReference()
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> coordinate(-500.0F, 500.0F);
+    std::uniform_real_distribution<float> intensity(0.0F, 4095.0F);
+
+    nion::VoxelGridFilter filter;
+    for (const size_t numPoints : { 20000, 100, 5000 })
+    {
+        std::vector<nion::PointXYZI> points(numPoints);
+        for (auto& point : points)
+        {
+            point = { coordinate(random), coordinate(random), coordinate(random) * 0.1F + 1000.0F, intensity(random) };
+        }
+        const auto input = Cloud(points);
+
+        constexpr float leafSizeMm = 50.0F;
+        std::map<std::array<int64_t, 3>, std::array<double, 5>> voxels;
+        std::map<std::array<int64_t, 3>, size_t> firstPoints;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const auto& point = points[i];
+            const std::array<int64_t, 3> key{ static_cast<int64_t>(std::floor(point.x / leafSizeMm)),
+                static_cast<int64_t>(std::floor(point.y / leafSizeMm)),
+                static_cast<int64_t>(std::floor(point.z / leafSizeMm)) };
+            auto& voxel = voxels[key];
+            voxel[0] += point.x;
+            voxel[1] += point.y;
+            voxel[2] += point.z;
+            voxel[3] += point.intensity;
+            voxel[4] += 1.0;
+            firstPoints.emplace(key, i);
+        }
+
+        nion::PointCloud output;
+        filter.Downsample(input, leafSizeMm, output);
+        NION_CHECK(output.points.size() == voxels.size());
+
+        // The output follows the order of the first points
+        std::map<size_t, std::array<int64_t, 3>> order;
+        for (const auto& firstPoint : firstPoints)
+        {
+            order.emplace(firstPoint.second, firstPoint.first);
+        }
+
+        size_t i = 0;
+        for (const auto& entry : order)
+        {
+            const auto& voxel = voxels.at(entry.second);
+            const nion::PointXYZI expected{ static_cast<float>(voxel[0] / voxel[4]),
+                static_cast<float>(voxel[1] / voxel[4]), static_cast<float>(voxel[2] / voxel[4]),
+                static_cast<float>(voxel[3] / voxel[4]) };
+            NION_CHECK(IsNear(output.points[i], expected, 0.05F));
+            ++i;
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "AveragesPointsOfAVoxel", TestAveragesPointsOfAVoxel },
+        { "VoxelBoundaries", TestVoxelBoundaries },
+        { "SkipsInvalidPoints", TestSkipsInvalidPoints },
+        { "InvalidArguments", TestInvalidArguments },
+        { "MatchesReference", TestMatchesReference },
+    });
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Standard headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "test.hpp"
+#include "worker_pool.hpp"
+
+namespace
+{
+
+// Counts finished tasks and the largest number of tasks that ran at the same time
+class TaskCounter
+{
+public:
+    nion::WorkerPool::Task Task(std::chrono::milliseconds duration = {})
+    {
+        return [this, duration] {
+            const auto numRunning = ++m_numRunning;
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_maxNumRunning = std::max(m_maxNumRunning, numRunning);
+            }
+
+            std::this_thread::sleep_for(duration);
+            --m_numRunning;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_numFinished;
+            m_finished.notify_all();
+        };
+    }
+
+    // Returns false if the tasks did not finish in time, e.g. because no thread was woken for them
+    bool WaitForFinished(int numFinished)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_finished.wait_for(lock, std::chrono::seconds(5), [&] {
+            return m_numFinished >= numFinished;
+        });
+    }
+
+    int MaxNumRunning()
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        return m_maxNumRunning;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_finished;
+    std::atomic<int> m_numRunning{ 0 };
+    int m_maxNumRunning{};
+    int m_numFinished{};
+};
+
+void TestRunsAllTasks()
+{
+    TaskCounter counter;
+    nion::WorkerPool pool(3);
+    const auto first = pool.AddClient();
+    const auto second = pool.AddClient();
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.Submit(i % 2 == 0 ? first : second, counter.Task());
+    }
+
+    NION_CHECK(counter.WaitForFinished(100));
+    NION_CHECK_THROWS(pool.Submit(2, counter.Task()), std::out_of_range);
+}
+
+// Removed clients are skipped in turn and their IDs are not reused
+void TestRemoveClient()
+{
+    TaskCounter counter;
+    nion::WorkerPool pool(2);
+    const auto first = pool.AddClient();
+    const auto second = pool.AddClient();
+    const auto third = pool.AddClient();
+
+    pool.RemoveClient(second);
+    NION_CHECK_THROWS(pool.Submit(second, counter.Task()), std::out_of_range);
+    NION_CHECK_THROWS(pool.RemoveClient(second), std::out_of_range);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.Submit(i % 2 == 0 ? first : third, counter.Task());
+    }
+    NION_CHECK(counter.WaitForFinished(100));
+
+    pool.RemoveClient(first);
+    const auto fourth = pool.AddClient();
+    NION_CHECK(fourth != first && fourth != second && fourth != third);
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.Submit(i % 2 == 0 ? third : fourth, counter.Task());
+    }
+    NION_CHECK(counter.WaitForFinished(200));
+
+    pool.RemoveClient(third);
+    pool.RemoveClient(fourth);
+}
+
+// A task submitted while the only active thread waits must wake that thread, not one of the inactive ones
+void TestInactiveThreads()
+{
+    TaskCounter counter;
+    nion::WorkerPool pool(4);
+    const auto client = pool.AddClient();
+    pool.SetNumActiveThreads(1);
+
+    for (int i = 1; i <= 200; ++i)
+    {
+        pool.Submit(client, counter.Task());
+        NION_CHECK(counter.WaitForFinished(i));
+    }
+    NION_CHECK(counter.MaxNumRunning() == 1);
+}
+
+void TestReactivatedThreads()
+{
+    TaskCounter counter;
+    nion::WorkerPool pool(4);
+    const auto client = pool.AddClient();
+
+    pool.SetNumActiveThreads(2);
+    for (int i = 0; i < 8; ++i)
+    {
+        pool.Submit(client, counter.Task(std::chrono::milliseconds(10)));
+    }
+    NION_CHECK(counter.WaitForFinished(8));
+    NION_CHECK(counter.MaxNumRunning() <= 2);
+
+    // Limited to at least one and at most all threads
+    pool.SetNumActiveThreads(100);
+    for (int i = 0; i < 8; ++i)
+    {
+        pool.Submit(client, counter.Task(std::chrono::milliseconds(50)));
+    }
+    NION_CHECK(counter.WaitForFinished(16));
+    NION_CHECK(counter.MaxNumRunning() > 2 && counter.MaxNumRunning() <= 4);
+
+    pool.SetNumActiveThreads(0);
+    pool.Submit(client, counter.Task());
+    NION_CHECK(counter.WaitForFinished(17));
+}
+
+// The remaining tasks are run when the pool is destroyed, also by the inactive threads
+void TestDestruction()
+{
+    TaskCounter counter;
+    {
+        nion::WorkerPool pool(2);
+        const auto client = pool.AddClient();
+        pool.SetNumActiveThreads(1);
+        for (int i = 0; i < 20; ++i)
+        {
+            pool.Submit(client, counter.Task(std::chrono::milliseconds(1)));
+        }
+    }
+    NION_CHECK(counter.WaitForFinished(20));
+
+    NION_CHECK_THROWS(nion::WorkerPool{ 0 }, std::invalid_argument);
+}
+
+} // namespace
+
+int main()
+{
+    return nion::test::Run({
+        { "RunsAllTasks", TestRunsAllTasks },
+        { "RemoveClient", TestRemoveClient },
+        { "InactiveThreads", TestInactiveThreads },
+        { "ReactivatedThreads", TestReactivatedThreads },
+        { "Destruction", TestDestruction },
+    });
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "thread_placement.hpp"
+
+// Standard headers
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
+namespace nion
+{
+namespace
+{
+
+#ifdef _WIN32
+void PlaceNativeThread(HANDLE thread, const ThreadPlacement& placement)
+{
+    if (!placement.cpus.empty())
+    {
+        DWORD_PTR mask = 0;
+        for (const auto cpu : placement.cpus)
+        {
+            if (cpu >= 64)
+            {
+                throw std::invalid_argument("CPU " + std::to_string(cpu) + " is not supported for thread placement.");
+            }
+            mask |= DWORD_PTR{ 1 } << cpu;
+        }
+
+        if (SetThreadAffinityMask(thread, mask) == 0)
+        {
+            throw std::runtime_error(
+                "Failed to set the CPU affinity of a thread, error " + std::to_string(GetLastError()));
+        }
+    }
+
+    if (placement.realtimePriority > 0 && !SetThreadPriority(thread, THREAD_PRIORITY_TIME_CRITICAL))
+    {
+        throw std::runtime_error(
+            "Failed to set the real-time priority of a thread, error " + std::to_string(GetLastError()));
+    }
+}
+#else
+void PlaceNativeThread(pthread_t thread, const ThreadPlacement& placement)
+{
+    if (!placement.cpus.empty())
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (const auto cpu : placement.cpus)
+        {
+            if (cpu >= CPU_SETSIZE)
+            {
+                throw std::invalid_argument("CPU " + std::to_string(cpu) + " is not supported for thread placement.");
+            }
+            CPU_SET(cpu, &cpus);
+        }
+
+        const auto result = pthread_setaffinity_np(thread, sizeof(cpus), &cpus);
+        if (result != 0)
+        {
+            throw std::runtime_error(
+                "Failed to set the CPU affinity of a thread: " + std::string(std::strerror(result)));
+        }
+    }
+
+    if (placement.realtimePriority > 0)
+    {
+        sched_param parameters{};
+        parameters.sched_priority = placement.realtimePriority;
+
+        const auto result = pthread_setschedparam(thread, SCHED_FIFO, &parameters);
+        if (result != 0)
+        {
+            throw std::runtime_error(
+                "Failed to set the real-time priority of a thread, which requires root or CAP_SYS_NICE: "
+                + std::string(std::strerror(result)));
+        }
+    }
+}
+#endif
+
+} // namespace
+
+void PlaceThread(std::thread& thread, const ThreadPlacement& placement)
+{
+    if (!placement.IsDefault())
+    {
+        PlaceNativeThread(thread.native_handle(), placement);
+    }
+}
+
+void PlaceCurrentThread(const ThreadPlacement& placement)
+{
+    if (placement.IsDefault())
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    PlaceNativeThread(GetCurrentThread(), placement);
+#else
+    PlaceNativeThread(pthread_self(), placement);
+#endif
+}
+
+void RunPlaced(const ThreadPlacement& placement, const std::function<void()>& function)
+{
+    if (placement.IsDefault())
+    {
+        function();
+        return;
+    }
+
+    std::exception_ptr error;
+    std::thread thread([&] {
+        try
+        {
+            PlaceCurrentThread(placement);
+            function();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+    });
+    thread.join();
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace nion
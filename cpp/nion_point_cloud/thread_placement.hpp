@@ -0,0 +1,56 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace nion
+{
+
+// CPUs and scheduling of a thread. Pinning the threads of a processing stage to CPUs of one NUMA node keeps them
+// from migrating between cores and sockets, which shows up as jitter in the latencies. The default placement leaves
+// the thread to the scheduler of the operating system.
+struct ThreadPlacement
+{
+    // Logical CPUs the thread may run on, all if empty. On Windows, only CPUs 0 to 63 are supported.
+    std::vector<size_t> cpus{};
+
+    // Real-time priority, 0 for normal scheduling. On Linux, the thread uses SCHED_FIFO with this priority (1 to 99),
+    // which requires root or CAP_SYS_NICE. On Windows, every positive value selects THREAD_PRIORITY_TIME_CRITICAL.
+    int realtimePriority{};
+
+    bool IsDefault() const
+    {
+        return cpus.empty() && realtimePriority == 0;
+    }
+};
+
+// Apply the placement to a thread. Throws a std::runtime_error if the operating system refuses it, e.g. without
+// permission for real-time priorities.
+void PlaceThread(std::thread& thread, const ThreadPlacement& placement);
+
+void PlaceCurrentThread(const ThreadPlacement& placement);
+
+// Run the function on a temporary thread with the placement and wait for it, rethrowing its exceptions. Linux and
+// Windows place memory on the NUMA node of the thread that touches it first, so memory that the function allocates and
+// initializes is local to the CPUs of the placement.
+void RunPlaced(const ThreadPlacement& placement, const std::function<void()>& function);
+
+} // namespace nion
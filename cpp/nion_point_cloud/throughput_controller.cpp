@@ -0,0 +1,207 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "throughput_controller.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <stdexcept>
+
+namespace nion
+{
+namespace
+{
+
+// Mean share of the frames in flight above which the pipelines are overloaded, and below which they have headroom
+constexpr double highOccupancy = 0.75;
+constexpr double lowOccupancy = 0.25;
+
+// Share of the latency budget below which the latency has headroom
+constexpr double lowLatencyShare = 0.5;
+
+} // namespace
+
+ThroughputController::ThroughputController(
+    const ThroughputControlSettings& settings, const ThroughputKnobs& initialKnobs)
+    : m_settings(settings)
+    , m_knobs(initialKnobs)
+    , m_minBinning(initialKnobs.binning)
+{
+    if (settings.periodFrameCount == 0)
+    {
+        throw std::invalid_argument("The control period requires at least one frame.");
+    }
+    if (initialKnobs.numWorkers == 0 || initialKnobs.decimation == 0 || initialKnobs.binning == 0)
+    {
+        throw std::invalid_argument("The knobs must be at least 1.");
+    }
+}
+
+ThroughputKnobs ThroughputController::Knobs() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_knobs;
+}
+
+bool ThroughputController::ShouldProcess(size_t frameIndex) const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return frameIndex % m_knobs.decimation == 0;
+}
+
+bool ThroughputController::OnFrameReceived(std::chrono::steady_clock::time_point receiveTime, bool isProcessed,
+    bool isDropped, double occupancy, uint64_t numLostFrames)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_numFrames == 0)
+    {
+        m_periodStart = receiveTime;
+    }
+
+    ++m_numFrames;
+    m_numProcessedFrames += (isProcessed && !isDropped) ? 1 : 0;
+    m_numDroppedFrames += isDropped ? 1 : 0;
+    m_numLostFrames += numLostFrames;
+    m_occupancySum += occupancy;
+
+    if (m_numFrames < m_settings.periodFrameCount)
+    {
+        return false;
+    }
+
+    const auto duration = std::chrono::duration<double>(receiveTime - m_periodStart).count();
+    const auto frameRate = duration > 0.0 ? static_cast<double>(m_numProcessedFrames) / duration : 0.0;
+    const auto meanOccupancy = m_occupancySum / static_cast<double>(m_numFrames);
+    const auto maxLatencyMs = static_cast<double>(m_maxLatencyNs.exchange(0)) / 1e6;
+    const auto hasLostFrames = m_numLostFrames > 0;
+    const auto hasDroppedFrames = m_numDroppedFrames > 0;
+
+    m_numFrames = 0;
+    m_numProcessedFrames = 0;
+    m_numDroppedFrames = 0;
+    m_numLostFrames = 0;
+    m_occupancySum = 0.0;
+
+    if (m_isSettling)
+    {
+        m_isSettling = false;
+        return false;
+    }
+
+    const auto hasBudget = m_settings.latencyBudgetMs > 0.0;
+    const auto isOverloaded = hasDroppedFrames || meanOccupancy > highOccupancy
+        || (hasBudget && maxLatencyMs > m_settings.latencyBudgetMs);
+    const auto hasHeadroom = !hasLostFrames && !hasDroppedFrames && meanOccupancy < lowOccupancy
+        && (!hasBudget || maxLatencyMs < lowLatencyShare * m_settings.latencyBudgetMs);
+
+    auto hasChanged = false;
+    if (hasLostFrames || isOverloaded)
+    {
+        m_numRelaxedPeriods = 0;
+        hasChanged = Tighten(hasLostFrames, isOverloaded, frameRate);
+    }
+    else if (hasHeadroom && ++m_numRelaxedPeriods >= m_settings.relaxPeriodCount)
+    {
+        m_numRelaxedPeriods = 0;
+        hasChanged = Relax();
+    }
+    else if (!hasHeadroom)
+    {
+        m_numRelaxedPeriods = 0;
+    }
+
+    m_isSettling = hasChanged;
+    return hasChanged;
+}
+
+void ThroughputController::OnFrameFinished(std::chrono::steady_clock::duration latency)
+{
+    const auto latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+
+    auto maxLatencyNs = m_maxLatencyNs.load();
+    while (latencyNs > maxLatencyNs && !m_maxLatencyNs.compare_exchange_weak(maxLatencyNs, latencyNs))
+    {
+    }
+}
+
+bool ThroughputController::Tighten(bool hasLostFrames, bool isOverloaded, double frameRate)
+{
+    auto& knobs = m_knobs;
+
+    // Lost frames are not caused by the processing, but by too few buffers to bridge its delays
+    if (hasLostFrames && knobs.numBuffers < m_settings.maxNumBuffers)
+    {
+        const auto numAddedBuffers = std::max<size_t>(1, knobs.numBuffers / 2);
+        knobs.numBuffers = std::min(m_settings.maxNumBuffers, knobs.numBuffers + numAddedBuffers);
+        return true;
+    }
+
+    if (!isOverloaded)
+    {
+        return false;
+    }
+
+    if (knobs.numWorkers < m_settings.maxNumWorkers)
+    {
+        ++knobs.numWorkers;
+        return true;
+    }
+
+    // Decimating from n to n + 1 keeps n / (n + 1) of the processed frames
+    const auto decimatedFrameRate = frameRate * static_cast<double>(knobs.decimation)
+        / static_cast<double>(knobs.decimation + 1);
+    if (knobs.decimation < m_settings.maxDecimation
+        && (m_settings.minFrameRate <= 0.0 || decimatedFrameRate >= m_settings.minFrameRate))
+    {
+        ++knobs.decimation;
+        return true;
+    }
+
+    if (knobs.binning * 2 <= m_settings.maxBinning)
+    {
+        knobs.binning *= 2;
+        return true;
+    }
+
+    return false;
+}
+
+bool ThroughputController::Relax()
+{
+    auto& knobs = m_knobs;
+
+    if (knobs.binning > m_minBinning)
+    {
+        knobs.binning /= 2;
+        return true;
+    }
+
+    if (knobs.decimation > 1)
+    {
+        --knobs.decimation;
+        return true;
+    }
+
+    if (knobs.numWorkers > 1)
+    {
+        --knobs.numWorkers;
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace nion
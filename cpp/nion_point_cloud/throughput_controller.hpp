@@ -0,0 +1,127 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace nion
+{
+
+// Goals and limits of the ThroughputController
+struct ThroughputControlSettings
+{
+    // Maximum end-to-end latency of a frame in milliseconds, from receiving the buffer until its files are written.
+    // 0 for no limit.
+    double latencyBudgetMs{};
+
+    // Minimum number of processed frames per second of all cameras together, which limits the decimation.
+    // 0 for no limit.
+    double minFrameRate{};
+
+    // Number of received frames of all cameras per control period. Every period changes at most one knob.
+    size_t periodFrameCount{ 50 };
+
+    // Number of consecutive periods with headroom before a knob is relaxed again
+    size_t relaxPeriodCount{ 5 };
+
+    // Upper limits of the knobs. The lower limits are one worker, no decimation and the initial number of buffers and
+    // binning.
+    size_t maxNumWorkers{ 1 };
+    size_t maxDecimation{ 1 };
+    size_t maxNumBuffers{};
+    uint32_t maxBinning{ 1 };
+};
+
+// Values chosen by the ThroughputController, which the acquisition applies
+struct ThroughputKnobs
+{
+    // Number of worker threads that take tasks
+    size_t numWorkers{ 1 };
+
+    // Process only every n-th frame of a camera
+    size_t decimation{ 1 };
+
+    // Number of buffers announced to the data stream of every camera. Applied by restarting the acquisition.
+    size_t numBuffers{};
+
+    // Horizontal and vertical binning of the cameras, a power of two. Applied by restarting the acquisition.
+    uint32_t binning{ 1 };
+};
+
+// Closed-loop control of the load of the host. The acquisition threads report every received frame, and the pipelines
+// the end-to-end latency of every processed frame. At the end of every control period, the controller compares the
+// observations with the goals of the settings:
+//
+// - Frames lost by the transport layer or buffer underruns add buffers.
+// - Frames dropped by a full pipeline, a mean occupancy of the frames in flight above 75 % or a latency above the
+//   budget first add workers, then increase the decimation as far as the minimum frame rate allows, and finally
+//   double the binning.
+// - After relaxPeriodCount periods in a row without drops, with a mean occupancy below 25 % and a latency below half
+//   the budget, the knobs are relaxed in reverse order: binning, decimation and workers. Buffers are kept.
+//
+// The period after a change is not evaluated, as its frames were partly processed with the previous knobs.
+// All functions are thread-safe.
+class ThroughputController
+{
+public:
+    ThroughputController(const ThroughputControlSettings& settings, const ThroughputKnobs& initialKnobs);
+
+    ThroughputKnobs Knobs() const;
+
+    // Whether a camera processes the frame with this index under the current decimation
+    bool ShouldProcess(size_t frameIndex) const;
+
+    // Report a received frame: whether it is processed or skipped by the decimation, whether the pipeline dropped it,
+    // the share of the frames in flight of its pipeline (0 to 1) and the number of frames the data stream lost since
+    // the last report of the camera. Returns true if the frame ended a control period and the knobs changed.
+    bool OnFrameReceived(std::chrono::steady_clock::time_point receiveTime, bool isProcessed, bool isDropped,
+        double occupancy, uint64_t numLostFrames);
+
+    // Report the end-to-end latency of a processed frame
+    void OnFrameFinished(std::chrono::steady_clock::duration latency);
+
+private:
+    // Change one knob. Must be called with the mutex locked.
+    bool Tighten(bool hasLostFrames, bool isOverloaded, double frameRate);
+    bool Relax();
+
+    ThroughputControlSettings m_settings;
+
+    mutable std::mutex m_mutex;
+    ThroughputKnobs m_knobs;
+
+    // Observations of the current period
+    std::chrono::steady_clock::time_point m_periodStart{};
+    size_t m_numFrames{};
+    size_t m_numProcessedFrames{};
+    size_t m_numDroppedFrames{};
+    uint64_t m_numLostFrames{};
+    double m_occupancySum{};
+    std::atomic<int64_t> m_maxLatencyNs{ 0 };
+
+    // Binning configured on the devices, which is not reduced further
+    uint32_t m_minBinning{};
+
+    size_t m_numRelaxedPeriods{};
+    bool m_isSettling{};
+};
+
+} // namespace nion
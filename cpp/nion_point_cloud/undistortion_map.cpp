@@ -0,0 +1,140 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "undistortion_map.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+namespace nion
+{
+namespace
+{
+
+bool IsSameLensModel(const LensModel& a, const LensModel& b)
+{
+    return a.fx == b.fx && a.fy == b.fy && a.cx == b.cx && a.cy == b.cy && a.k1 == b.k1 && a.k2 == b.k2
+        && a.k3 == b.k3 && a.k4 == b.k4 && a.k5 == b.k5 && a.k6 == b.k6 && a.p1 == b.p1 && a.p2 == b.p2;
+}
+
+struct CacheEntry
+{
+    LensModel model;
+    size_t width;
+    size_t height;
+    std::weak_ptr<const UndistortionMap> map;
+};
+
+} // namespace
+
+constexpr uint32_t UndistortionMap::invalidIndex;
+
+UndistortionMap::UndistortionMap(const LensModel& model, size_t width, size_t height)
+    : m_width(width)
+    , m_height(height)
+    , m_nearestSourceIndices(width * height, invalidIndex)
+    , m_bilinearSamples(width * height, BilinearSample{ invalidIndex, 0.0F, 0.0F })
+{
+    if (width < 2 || height < 2 || width * height >= invalidIndex)
+    {
+        throw std::invalid_argument("Unsupported image size for the undistortion map.");
+    }
+
+    const auto maxX = static_cast<double>(width - 1);
+    const auto maxY = static_cast<double>(height - 1);
+
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            double sourceX = 0.0;
+            double sourceY = 0.0;
+            DistortPixel(model, static_cast<double>(x), static_cast<double>(y), sourceX, sourceY);
+
+            if (sourceX < 0.0 || sourceX > maxX || sourceY < 0.0 || sourceY > maxY)
+            {
+                continue;
+            }
+
+            const auto index = y * width + x;
+
+            const auto nearestX = static_cast<size_t>(std::lround(sourceX));
+            const auto nearestY = static_cast<size_t>(std::lround(sourceY));
+            m_nearestSourceIndices[index] = static_cast<uint32_t>(nearestY * width + nearestX);
+
+            // The right and bottom neighbors always exist, positions on the last
+            // column or row use the previous one with a weight of 1.
+            const auto x0 = std::min(static_cast<size_t>(sourceX), width - 2);
+            const auto y0 = std::min(static_cast<size_t>(sourceY), height - 2);
+            m_bilinearSamples[index] = { static_cast<uint32_t>(y0 * width + x0),
+                static_cast<float>(sourceX - static_cast<double>(x0)),
+                static_cast<float>(sourceY - static_cast<double>(y0)) };
+        }
+    }
+}
+
+size_t UndistortionMap::Width() const
+{
+    return m_width;
+}
+
+size_t UndistortionMap::Height() const
+{
+    return m_height;
+}
+
+const std::vector<uint32_t>& UndistortionMap::NearestSourceIndices() const
+{
+    return m_nearestSourceIndices;
+}
+
+const std::vector<UndistortionMap::BilinearSample>& UndistortionMap::BilinearSamples() const
+{
+    return m_bilinearSamples;
+}
+
+std::shared_ptr<const UndistortionMap> GetUndistortionMap(const LensModel& model, size_t width, size_t height)
+{
+    static std::mutex cacheMutex;
+    static std::vector<CacheEntry> cache;
+
+    const std::lock_guard<std::mutex> lock(cacheMutex);
+
+    cache.erase(std::remove_if(cache.begin(), cache.end(),
+                    [](const CacheEntry& entry) {
+                        return entry.map.expired();
+                    }),
+        cache.end());
+
+    for (const auto& entry : cache)
+    {
+        if (entry.width == width && entry.height == height && IsSameLensModel(entry.model, model))
+        {
+            if (auto map = entry.map.lock())
+            {
+                return map;
+            }
+        }
+    }
+
+    auto map = std::make_shared<const UndistortionMap>(model, width, height);
+    cache.push_back({ model, width, height, map });
+    return map;
+}
+
+} // namespace nion
@@ -0,0 +1,71 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Project headers
+#include "lens_model.hpp"
+
+namespace nion
+{
+
+// Precomputed source position in the distorted image for every pixel of the undistorted image.
+// The lens model only has to be evaluated once, instead of for every pixel of every frame.
+// Source indices refer to contiguous images of the same size (stride equal to the width).
+// Only used by the direct backend, the ICV backend undistorts every image with peak::icv::Undistortion.
+class UndistortionMap
+{
+public:
+    // Marks undistorted pixels whose source position lies outside the distorted image
+    static constexpr uint32_t invalidIndex = UINT32_MAX;
+
+    struct BilinearSample
+    {
+        // Index of the top left of the four neighboring source pixels
+        uint32_t index;
+        float weightX;
+        float weightY;
+    };
+
+    UndistortionMap(const LensModel& model, size_t width, size_t height);
+
+    size_t Width() const;
+    size_t Height() const;
+
+    // Index of the nearest source pixel, used for depth maps
+    const std::vector<uint32_t>& NearestSourceIndices() const;
+
+    // Neighbors and weights for bilinear interpolation, used for intensity images
+    const std::vector<BilinearSample>& BilinearSamples() const;
+
+private:
+    size_t m_width;
+    size_t m_height;
+    std::vector<uint32_t> m_nearestSourceIndices;
+    std::vector<BilinearSample> m_bilinearSamples;
+};
+
+// Get the undistortion map for a lens model and image size. Each map is computed only once and
+// shared by all users with the same calibration, binning and ROI. It is released once the last
+// user is gone, e.g. after the binning or ROI changed.
+std::shared_ptr<const UndistortionMap> GetUndistortionMap(const LensModel& model, size_t width, size_t height);
+
+} // namespace nion
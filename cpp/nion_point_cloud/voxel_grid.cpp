@@ -0,0 +1,147 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "voxel_grid.hpp"
+
+// Standard headers
+#include <cmath>
+#include <stdexcept>
+
+namespace nion
+{
+namespace
+{
+
+// Voxel indices are stored with 21 bits per axis, e.g. +-1 km with a leaf size of 1 mm. Voxels further apart
+// share their key.
+constexpr uint64_t keyBits = 21;
+constexpr int64_t keyOffset = int64_t{ 1 } << (keyBits - 1);
+constexpr uint64_t keyMask = (uint64_t{ 1 } << keyBits) - 1;
+
+uint64_t VoxelKey(const PointXYZI& point, float inverseLeafSize)
+{
+    auto index = [inverseLeafSize](float value) {
+        const auto voxelIndex = static_cast<int64_t>(std::floor(value * inverseLeafSize)) + keyOffset;
+        return static_cast<uint64_t>(voxelIndex) & keyMask;
+    };
+
+    return index(point.x) | (index(point.y) << keyBits) | (index(point.z) << (2 * keyBits));
+}
+
+// The keys of neighboring voxels only differ in a few bits, which are spread over the whole hash
+size_t HashKey(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+}
+
+} // namespace
+
+void VoxelGridFilter::Downsample(const PointCloud& input, float leafSizeMm, PointCloud& output)
+{
+    if (!(leafSizeMm > 0.0F))
+    {
+        throw std::invalid_argument("The voxel leaf size must be positive.");
+    }
+    if (&input == &output)
+    {
+        throw std::invalid_argument("The output point cloud must not be the input.");
+    }
+
+    const auto& points = input.points;
+
+    // At most half of the table is used, which keeps the probe sequences short
+    size_t tableSize = 1024;
+    while (tableSize < 2 * points.size())
+    {
+        tableSize *= 2;
+    }
+    if (m_table.size() < tableSize)
+    {
+        m_table.assign(tableSize, Voxel{});
+        m_generation = 0;
+    }
+    if (++m_generation == 0)
+    {
+        for (auto& voxel : m_table)
+        {
+            voxel.generation = 0;
+        }
+        m_generation = 1;
+    }
+
+    m_voxelOrder.clear();
+
+    const auto inverseLeafSize = 1.0F / leafSizeMm;
+    Voxel* lastVoxel = nullptr;
+    uint64_t lastKey = 0;
+
+    for (const auto& point : points)
+    {
+        if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z))
+        {
+            continue;
+        }
+
+        const auto key = VoxelKey(point, inverseLeafSize);
+        if (!lastVoxel || key != lastKey)
+        {
+            lastVoxel = &FindVoxel(key);
+            lastKey = key;
+        }
+
+        ++lastVoxel->count;
+        lastVoxel->sumX += point.x;
+        lastVoxel->sumY += point.y;
+        lastVoxel->sumZ += point.z;
+        lastVoxel->sumIntensity += point.intensity;
+    }
+
+    output.points.resize(m_voxelOrder.size());
+    for (size_t i = 0; i < m_voxelOrder.size(); ++i)
+    {
+        const auto& voxel = m_table[m_voxelOrder[i]];
+        const auto inverseCount = 1.0F / static_cast<float>(voxel.count);
+        output.points[i] = { voxel.sumX * inverseCount, voxel.sumY * inverseCount, voxel.sumZ * inverseCount,
+            voxel.sumIntensity * inverseCount };
+    }
+
+    output.width = output.points.size();
+    output.height = 1;
+}
+
+VoxelGridFilter::Voxel& VoxelGridFilter::FindVoxel(uint64_t key)
+{
+    const auto mask = m_table.size() - 1;
+
+    for (auto i = HashKey(key) & mask;; i = (i + 1) & mask)
+    {
+        auto& voxel = m_table[i];
+        if (voxel.generation != m_generation)
+        {
+            voxel = { key, m_generation, 0, 0.0F, 0.0F, 0.0F, 0.0F };
+            m_voxelOrder.push_back(static_cast<uint32_t>(i));
+            return voxel;
+        }
+        if (voxel.key == key)
+        {
+            return voxel;
+        }
+    }
+}
+
+} // namespace nion
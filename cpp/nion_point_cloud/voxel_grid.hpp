@@ -0,0 +1,63 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project headers
+#include "point_cloud.hpp"
+
+namespace nion
+{
+
+// Downsamples point clouds on a voxel grid: all points within the same cube of leafSizeMm are replaced by a single
+// point with their average coordinates and intensity. The voxels are collected in a hash table with open addressing
+// that is kept from call to call, so downsampling only allocates while the point clouds grow. Neighboring pixels
+// mostly fall into the same voxel, so consecutive points hit the same table entry. Not thread-safe, use one filter
+// per thread or frame.
+class VoxelGridFilter
+{
+public:
+    // Write the downsampled, unorganized point cloud to output, with the voxels in the order of their first point.
+    // Points with non-finite coordinates are skipped. The output must not be the input.
+    void Downsample(const PointCloud& input, float leafSizeMm, PointCloud& output);
+
+private:
+    struct Voxel
+    {
+        uint64_t key;
+        uint32_t generation;
+        uint32_t count;
+        float sumX;
+        float sumY;
+        float sumZ;
+        float sumIntensity;
+    };
+
+    Voxel& FindVoxel(uint64_t key);
+
+    // Entries of earlier calls have an older generation and count as empty, so the table is never cleared
+    std::vector<Voxel> m_table;
+    uint32_t m_generation{};
+
+    // Table indices of the voxels in the order of their first point
+    std::vector<uint32_t> m_voxelOrder;
+};
+
+} // namespace nion
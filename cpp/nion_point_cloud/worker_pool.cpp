@@ -0,0 +1,192 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "worker_pool.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace nion
+{
+
+WorkerPool::WorkerPool(size_t numThreads, const ThreadPlacement& placement)
+    : m_placement(placement)
+{
+    if (numThreads == 0)
+    {
+        throw std::invalid_argument("The worker pool requires at least one thread.");
+    }
+
+    m_numActiveThreads = numThreads;
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        m_threads.emplace_back(&WorkerPool::Run, this, i);
+    }
+
+    try
+    {
+        for (auto& thread : m_threads)
+        {
+            PlaceThread(thread, placement);
+        }
+    }
+    catch (...)
+    {
+        StopThreads();
+        throw;
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    StopThreads();
+}
+
+size_t WorkerPool::AddClient()
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_clients.push_back({ m_nextClientId, {} });
+    return m_nextClientId++;
+}
+
+void WorkerPool::RemoveClient(size_t client)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const auto position = FindClient(client);
+
+    // The turn stays with the client that follows the removed one
+    const auto index = static_cast<size_t>(position - m_clients.begin());
+    if (m_nextClient > index)
+    {
+        --m_nextClient;
+    }
+    m_clients.erase(position);
+}
+
+void WorkerPool::Submit(size_t client, Task task)
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        FindClient(client)->tasks.push_back(std::move(task));
+    }
+    m_hasTasks.notify_one();
+}
+
+size_t WorkerPool::NumThreads() const
+{
+    return m_threads.size();
+}
+
+void WorkerPool::SetNumActiveThreads(size_t numActiveThreads)
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_numActiveThreads = std::max<size_t>(1, std::min(numActiveThreads, m_threads.size()));
+    }
+    m_hasTasks.notify_all();
+    m_isActivated.notify_all();
+}
+
+const ThreadPlacement& WorkerPool::Placement() const
+{
+    return m_placement;
+}
+
+void WorkerPool::Run(size_t index)
+{
+    Task task;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                // Inactive threads help to run the remaining tasks when stopping
+                if (index >= m_numActiveThreads && !m_isStopping)
+                {
+                    m_isActivated.wait(lock);
+                }
+                else if (PopNextTask(task) || m_isStopping)
+                {
+                    break;
+                }
+                else
+                {
+                    m_hasTasks.wait(lock);
+                }
+            }
+
+            // Remaining tasks are still run when stopping
+            if (!task)
+            {
+                return;
+            }
+        }
+
+        task();
+        task = nullptr;
+    }
+}
+
+bool WorkerPool::PopNextTask(Task& task)
+{
+    for (size_t i = 0; i < m_clients.size(); ++i)
+    {
+        const auto client = (m_nextClient + i) % m_clients.size();
+        auto& queue = m_clients[client].tasks;
+        if (!queue.empty())
+        {
+            task = std::move(queue.front());
+            queue.pop_front();
+            m_nextClient = client + 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<WorkerPool::Client>::iterator WorkerPool::FindClient(size_t client)
+{
+    const auto position = std::find_if(
+        m_clients.begin(), m_clients.end(), [client](const Client& registered) { return registered.id == client; });
+    if (position == m_clients.end())
+    {
+        throw std::out_of_range("The client is not registered at the worker pool.");
+    }
+    return position;
+}
+
+void WorkerPool::StopThreads()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_hasTasks.notify_all();
+    m_isActivated.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+}
+
+} // namespace nion
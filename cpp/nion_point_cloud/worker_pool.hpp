@@ -0,0 +1,103 @@
+/*
+ * Copyright(C) 2025, IDS Imaging Development Systems GmbH.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS” AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE
+ * FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT
+ * OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#pragma once
+
+// Standard headers
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "thread_placement.hpp"
+
+namespace nion
+{
+
+// Threads shared by the pipelines of all cameras. Every pipeline is a client with its own task queue.
+// The workers take the tasks of the clients in turn, so a camera with many queued frames cannot delay
+// the frames of the other cameras.
+class WorkerPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkerPool(size_t numThreads, const ThreadPlacement& placement = {});
+
+    // Waits for all queued tasks
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    // Register a client and return its ID. Can be called while tasks are running.
+    size_t AddClient();
+
+    // Unregister a client, so the workers no longer visit it in turn, e.g. when a pipeline is destroyed. The client
+    // must wait for its tasks first, tasks that are still queued are discarded. IDs are not reused.
+    void RemoveClient(size_t client);
+
+    // Queue a task of the given client. Tasks must not throw, the caller is responsible for
+    // handling their errors.
+    void Submit(size_t client, Task task);
+
+    size_t NumThreads() const;
+
+    // Let only the given number of threads take tasks, e.g. to leave CPU time to other work. The others wait until
+    // they are activated again. Limited to 1 to NumThreads(), and all threads are active by default.
+    void SetNumActiveThreads(size_t numActiveThreads);
+
+    // Placement of the worker threads, e.g. to allocate memory on their NUMA node with RunPlaced()
+    const ThreadPlacement& Placement() const;
+
+private:
+    struct Client
+    {
+        size_t id{};
+        std::deque<Task> tasks{};
+    };
+
+    void Run(size_t index);
+    void StopThreads();
+
+    // Take the next task in turn. Must be called with the mutex locked.
+    bool PopNextTask(Task& task);
+
+    // Throws std::out_of_range if the client is not registered. Must be called with the mutex locked.
+    std::vector<Client>::iterator FindClient(size_t client);
+
+    std::mutex m_mutex;
+
+    // Active threads wait for tasks and inactive ones for being activated, so a task never wakes an inactive thread
+    // instead of an active one
+    std::condition_variable m_hasTasks;
+    std::condition_variable m_isActivated;
+    std::vector<Client> m_clients;
+    size_t m_nextClient{};
+    size_t m_nextClientId{};
+    size_t m_numActiveThreads{};
+    bool m_isStopping{};
+
+    ThreadPlacement m_placement;
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace nion